@@ -4,12 +4,14 @@
 #include "Aircraft.h"
 
 #include "Camera/CameraComponent.h"
+#include "Camera/CameraShakeBase.h"
 #include "Characters/BaseCharacter.h"
 
 #include "Components/AudioComponent.h"
 #include "Components/ArrowComponent.h"
 #include "Components/BoxComponent.h"
 
+#include "GameFramework/GameStateBase.h"
 #include "GameFramework/PlayerState.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "GameModes/BaseGameMode.h"
@@ -20,6 +22,7 @@
 
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Particles/ParticleSystem.h"
 #include "Sound/SoundCue.h"
 #include "PlayerController/PlayerControllerManager.h"
 
@@ -29,27 +32,48 @@
 #include "Weapon/AmmoEject.h"
 
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+
+#include "AircraftAssetPreloadSubsystem.h"
+#include "AircraftExplosionSubsystem.h"
+#include "AircraftHealthMonitor.h"
+#include "AircraftMovementValidator.h"
+#include "AircraftNetStatsSubsystem.h"
+#include "AircraftPoolSubsystem.h"
+#include "AircraftStats.h"
+#include "AircraftTimerWheel.h"
+#include "AircraftTelemetry.h"
+
+DEFINE_STAT(STAT_AircraftDamageHitsQueued);
+DEFINE_STAT(STAT_AircraftDamageBatchesResolved);
+DEFINE_STAT(STAT_AircraftVitalsUpdates);
+
+DECLARE_CYCLE_STAT(TEXT("Receive Damage"), STAT_AircraftReceiveDamage, STATGROUP_Aircraft);
+DECLARE_CYCLE_STAT(TEXT("Resolve Damage"), STAT_AircraftResolveDamage, STATGROUP_Aircraft);
+DECLARE_CYCLE_STAT(TEXT("Integrate Flight"), STAT_AircraftIntegrateFlight, STATGROUP_Aircraft);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Ticking Aircraft"), STAT_AircraftTicking, STATGROUP_Aircraft);
+
+static uint64 GAircraftTickCount = 0;
 
 AAircraft::AAircraft()
 {
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	AreaCollision		= CreateDefaultSubobject<UBoxComponent>			(TEXT("AreaCollision"));
 	AircraftMesh		= CreateDefaultSubobject<UStaticMeshComponent>	(TEXT("HorizonRiderMesh"));
 	FlapLeft			= CreateDefaultSubobject<UStaticMeshComponent>	(TEXT("FlapLeft"));
 	FlapRight			= CreateDefaultSubobject<UStaticMeshComponent>	(TEXT("FlapRight"));
-	RutterRight			= CreateDefaultSubobject<UStaticMeshComponent>	(TEXT("RutterRight"));
-	RutterLeft			= CreateDefaultSubobject<UStaticMeshComponent>	(TEXT("RutterLeft"));
+	RudderRight			= CreateDefaultSubobject<UStaticMeshComponent>	(TEXT("RudderRight"));
+	RudderLeft			= CreateDefaultSubobject<UStaticMeshComponent>	(TEXT("RudderLeft"));
 	AileronLeft			= CreateDefaultSubobject<UStaticMeshComponent>	(TEXT("AileronLeft"));
 	AileronRight		= CreateDefaultSubobject<UStaticMeshComponent>	(TEXT("AileronRight"));
 	ElevatorLeft		= CreateDefaultSubobject<UStaticMeshComponent>	(TEXT("ElevatorLeft"));
 	ElevatorRight		= CreateDefaultSubobject<UStaticMeshComponent>	(TEXT("ElevatorRight"));
 
-	SpringArm			= CreateDefaultSubobject<USpringArmComponent>	(TEXT("SpringArm"));
-	BehindCamera		= CreateDefaultSubobject<UCameraComponent>		(TEXT("BehindCamera"));
-	FrontCamera			= CreateDefaultSubobject<UCameraComponent>		(TEXT("FrontCamera"));
-	InteriorCamera		= CreateDefaultSubobject<UCameraComponent>		(TEXT("InteriorCamera"));
-
 	ExitArrow			= CreateDefaultSubobject<UArrowComponent>		(TEXT("ExitArrow"));
 
 	SetRootComponent(AreaCollision);
@@ -57,45 +81,37 @@ AAircraft::AAircraft()
 	AircraftMesh		->SetupAttachment(AreaCollision);
 	FlapRight			->SetupAttachment(AircraftMesh);
 	FlapLeft			->SetupAttachment(AircraftMesh);
-	RutterRight			->SetupAttachment(AircraftMesh);
-	RutterLeft			->SetupAttachment(AircraftMesh);
+	RudderRight			->SetupAttachment(AircraftMesh);
+	RudderLeft			->SetupAttachment(AircraftMesh);
 	AileronRight		->SetupAttachment(AircraftMesh);
 	AileronLeft			->SetupAttachment(AircraftMesh);
 	ElevatorRight		->SetupAttachment(AircraftMesh);
 	ElevatorLeft		->SetupAttachment(AircraftMesh);
 	ExitArrow			->SetupAttachment(AircraftMesh);
 
-	SpringArm			->SetupAttachment(AircraftMesh);
-	BehindCamera		->SetupAttachment(SpringArm);
-	FrontCamera			->SetupAttachment(SpringArm);
-	InteriorCamera		->SetupAttachment(AircraftMesh);
-
 	AircraftMesh		->SetRelativeRotation(FRotator(0.0f, -90.0f, 0.0f));
 
-	SpringArm			->TargetArmLength			= 3000.0f;
-	SpringArm			->TargetOffset				= FVector(0.0f, 0.0f, 500.0f);
-	SpringArm			->bEnableCameraLag			= true;
-	SpringArm			->bEnableCameraRotationLag	= true;
-	SpringArm			->CameraLagSpeed			= 10.0f;
-	SpringArm			->CameraRotationLagSpeed	= 10.0f;
-
-	FrontCamera			->SetRelativeLocation(FVector(5000.0f, 0.0f, 0.0f));
-	FrontCamera			->SetRelativeRotation(FRotator(0.0f, 180.0f, 0.0f));
-
-	InteriorCamera		->SetRelativeLocation(FVector(40.0F, 50.0F, 20.0F));
-	InteriorCamera		->SetRelativeRotation(FRotator(0.0F, 0.0f, 0.0f));
-
-	BehindCamera		->SetAutoActivate(true);
-	FrontCamera			->SetAutoActivate(false);
-	InteriorCamera		->SetAutoActivate(false);
-
 	ExitArrow			->SetRelativeLocation(FVector(160.0f, 50.0f, 0.0f));
 	ExitArrow			->SetRelativeRotation(FRotator(0.0f, 90.0f, 0.0f));
 
-	EngineVolume		= 0.1f;
-	ThrustSpeed			= MinThrustSpeedThreshold;
-	CurrentSpeed		= ThrustSpeed;
-	Cache_InteriorCamera = false;
+	/*Flags are bitfields, so their defaults live here*/
+	bMiddleEngineType						= false;
+	bRightEngineType						= false;
+	bLeftEngineType							= false;
+	bRightSecondEngineType					= false;
+	bLeftSecondEngineType					= false;
+	bAutomaticNetDormancy					= true;
+	bAircraftShieldBreak					= false;
+	bDamageResolveScheduled					= false;
+	Cache_InteriorCamera					= false;
+	bCameraSwitchedWhileTargetingCameraOn	= false;
+
+	/*Throttle is set and held rather than flicked: linear, and smoothed a little longer*/
+	ThrottleResponse.Expo			= 0.0f;
+	ThrottleResponse.SmoothingTime	= 0.1f;
+
+	Hot.Flight.ThrustSpeed		= FlightTuning.MinThrustSpeedThreshold;
+	Hot.Flight.CurrentSpeed		= Hot.Flight.ThrustSpeed;
 
 	AircraftMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Block);
 
@@ -134,6 +150,7 @@ void AAircraft::BeginPlay()
 {
 	Super::BeginPlay();
 	Cache_InteriorCamera = false;
+	ResolveFlightProfile();
 
 	EnhancedInputLocalPlayerSubsystem();
 	Handle_InitialEngine();
@@ -149,97 +166,191 @@ void AAircraft::BeginPlay()
 	if (HasAuthority())
 	{
 		OnTakeAnyDamage.AddDynamic(this, &AAircraft::ReceiveDamage);
+
+		if (UAircraftMovementValidator* MovementValidator = GetWorld()->GetSubsystem<UAircraftMovementValidator>())
+		{
+			MovementValidator->RegisterAircraft(this);
+		}
 	}
+
+	RegisterScheduledWork();
+
+	/*The level's own aircraft are preloaded when the world begins play; anything spawned later (pool, bots, shard
+	  adoption) requests its class bundle here, which returns at once when it is already resident*/
+	if (UAircraftAssetPreloadSubsystem* PreloadSubsystem = GetWorld()->GetSubsystem<UAircraftAssetPreloadSubsystem>())
+	{
+		PreloadSubsystem->WhenAircraftClassReady(GetClass(), FSimpleDelegate::CreateUObject(this, &AAircraft::OnAircraftAssetsReady));
+	}
+
+	Hot.ActivityState = EvaluateActivityState();
+	ApplyActivityState();
+}
+
+void AAircraft::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UAircraftWorkScheduler* WorkScheduler = UAircraftWorkScheduler::Get(this))
+	{
+		WorkScheduler->UnregisterWork(ThrusterWork);
+		WorkScheduler->UnregisterWork(EngineSoundWork);
+	}
+
+	/*The counter only moves on state edges in ApplyActivityState, so a ticking aircraft leaving play takes itself off*/
+	if (IsActorTickEnabled())
+	{
+		DEC_DWORD_STAT(STAT_AircraftTicking);
+	}
+
+	if (HasAuthority())
+	{
+		if (UAircraftMovementValidator* MovementValidator = GetWorld()->GetSubsystem<UAircraftMovementValidator>())
+		{
+			MovementValidator->UnregisterAircraft(this);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AAircraft::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
-	if (bPlayerEnteredVehicle && IsEngineStarted())
+	++GAircraftTickCount;
+
+	/*Human pilots only; bots, handoffs and remote copies set the stored input directly*/
+	const bool bSamplePilotInput = IsLocallyControlled() && IsPlayerControlled();
+	if (bSamplePilotInput)
+	{
+		SamplePilotInput(DeltaTime);
+	}
+
+	if (Hot.bPlayerEnteredVehicle && IsEngineStarted())
 	{
-		if (bAircraftTakenOff == false)
+		if (Hot.bAircraftTakenOff == false)
 		{
 			AutoTakeOff(DeltaTime);
 		}
 		else
 		{
-			UpdatePosition(DeltaTime);
-			UpdateAxisByInputValues(StoredInputThrottle, StoredInputPitch, StoredInputYaw, StoredInputRoll);
+			IntegrateFlight(DeltaTime, false);
 		}
-		if (bUpdateThrusters == true)
+
+		if (bSamplePilotInput)
 		{
-			UpdateThrusters();
+			InputPipeline->NotifyApplied();
 		}
-		Play_AeroDynamicSounds();
+	}
+	//UE_LOG(LogTemp, Warning, TEXT("AeroEngineSystem: %s"), *UEnum::GetValueAsString(AircraftEngineTypes));
+
+	if (FAircraftTelemetryWriter* TelemetryWriter = FAircraftTelemetryWriter::GetActive())
+	{
+		WriteTelemetryRecord(*TelemetryWriter);
+	}
+}
+
+void AAircraft::WriteTelemetryRecord(FAircraftTelemetryWriter& TelemetryWriter) const
+{
+	uint64 RecordIndex;
+	FAircraftTelemetryRecord& Record = TelemetryWriter.BeginRecord(RecordIndex);
+
+	const FVector Location = GetActorLocation();
+	Record.WorldTime		= GetWorld()->GetTimeSeconds();
+	Record.AircraftId		= GetUniqueID();
+	Record.CurrentSpeed		= Hot.Flight.CurrentSpeed;
+	Record.ThrustSpeed		= Hot.Flight.ThrustSpeed;
+	Record.BoostSpeed		= Hot.Flight.BoostSpeed;
+	Record.AppliedGravity	= Hot.Flight.AppliedGravity;
+	Record.CurrentPitch		= Hot.Flight.CurrentPitch;
+	Record.CurrentYaw		= Hot.Flight.CurrentYaw;
+	Record.CurrentRoll		= Hot.Flight.CurrentRoll;
+	Record.InputThrottle	= Hot.InputThrottle;
+	Record.LocationX		= Location.X;
+	Record.LocationY		= Location.Y;
+	Record.LocationZ		= Location.Z;
+	Record.Flags			= (Hot.bEngineStarted ? EATF_EngineStarted : 0)
+							| (Hot.bAircraftTakenOff ? EATF_TakenOff : 0)
+							| (Hot.bBoostActivated ? EATF_Boosting : 0)
+							| (Hot.bAircraftDestroyed ? EATF_Destroyed : 0)
+							| (HasAuthority() ? EATF_Authority : 0);
+
+	TelemetryWriter.CommitRecord(Record, RecordIndex);
 }
-	//UE_LOG(LogTemp, Warning, TEXT("AeroEngineSystem: %s"), *UEnum::GetValueAsString(AeroEngineTypes));
+
+#pragma region AircraftEngineTypes
+void AAircraft::OnRep_AircraftEngineTypes()
+{
+	Handle_AircraftEngineTypes();
 }
 
-#pragma region AeroEngineTypes
-void AAircraft::OnRep_AeroEngineTypes()
+void AAircraft::SetAircraftEngineTypes(EAircraftEngineTypes Type)
 {
-	Handle_AeroEngineTypes();
+	if (AircraftEngineTypes == Type) return;
+
+	AircraftEngineTypes = Type;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAircraft, AircraftEngineTypes, this);
+	UpdateActivityState();
+	FlushReplicatedChange();
 }
 
-void AAircraft::CheckAeroEngineTypes()
+void AAircraft::CheckAircraftEngineTypes()
 {
-	Handle_AeroEngineTypes();
+	Handle_AircraftEngineTypes();
 }
 
-void AAircraft::Handle_AeroEngineTypes()
+void AAircraft::Handle_AircraftEngineTypes()
 {
-	switch (AeroEngineTypes)
+	switch (AircraftEngineTypes)
 	{
-		case EAeroEngineTypes::EAET_InitialEngine:
+		case EAircraftEngineTypes::EACET_InitialEngine:
 			Handle_InitialEngine();
 			break;
-		case EAeroEngineTypes::EAET_EngineStarted:
+		case EAircraftEngineTypes::EACET_EngineStarted:
 			Handle_EngineStarted();
 			break;
-		case EAeroEngineTypes::EAET_EngineStopped:
+		case EAircraftEngineTypes::EACET_EngineStopped:
 			Handle_EngineStopped();
 			break;
-		case EAeroEngineTypes::EAET_Idle:
+		case EAircraftEngineTypes::EACET_Idle:
 			Handle_Idle();
 			break;
 	}
+	UpdateActivityState();
 }
 
 void AAircraft::Handle_InitialEngine()
 {
-	CurrentSpeed = 0.0f;
+	Hot.Flight.CurrentSpeed = 0.0f;
 }
 
 void AAircraft::Handle_EngineStarted()
 {
 	SpawnTrailSystem(bMiddleEngineType, bRightEngineType, bLeftEngineType, bRightSecondEngineType, bLeftSecondEngineType);
 
-	if (MiddleFrontThrusterFXs->IsActive() == false)
+	if (MiddleFrontThrusterFXs && MiddleFrontThrusterFXs->IsActive() == false)
 		MiddleFrontThrusterFXs->Activate();
-	if (RightFrontThrusterFXs->IsActive() == false)
+	if (RightFrontThrusterFXs && RightFrontThrusterFXs->IsActive() == false)
 		RightFrontThrusterFXs->Activate();
-	if (LeftFrontThrusterFXs->IsActive() == false)
+	if (LeftFrontThrusterFXs && LeftFrontThrusterFXs->IsActive() == false)
 		LeftFrontThrusterFXs->Activate();
 
-	if (bUpdateThrusters == false)
+	if (Hot.bUpdateThrusters == false)
 	{
-		bUpdateThrusters = true;
+		Hot.bUpdateThrusters = true;
 	}
-	Local_OutsiteJetSound(OutsiteJetSound);
+	Local_OutsideJetSound(OutsideJetSound);
 }
 
 void AAircraft::Handle_EngineStopped()
 {
-	if (MiddleFrontThrusterFXs->IsActive())
+	if (MiddleFrontThrusterFXs && MiddleFrontThrusterFXs->IsActive())
 		MiddleFrontThrusterFXs->Deactivate();
-	if (RightFrontThrusterFXs->IsActive())
+	if (RightFrontThrusterFXs && RightFrontThrusterFXs->IsActive())
 		RightFrontThrusterFXs->Deactivate();
-	if (LeftFrontThrusterFXs->IsActive())
+	if (LeftFrontThrusterFXs && LeftFrontThrusterFXs->IsActive())
 		LeftFrontThrusterFXs->Deactivate();
 
-	if (bUpdateThrusters == true)
+	if (Hot.bUpdateThrusters == true)
 	{
-		bUpdateThrusters = false;
+		Hot.bUpdateThrusters = false;
 	}
 }
 
@@ -250,6 +361,199 @@ void AAircraft::Handle_Idle()
 
 #pragma endregion
 
+#pragma region Dormancy
+bool AAircraft::IsParked() const
+{
+	const bool bEngineOff = AircraftEngineTypes == EAircraftEngineTypes::EACET_InitialEngine || AircraftEngineTypes == EAircraftEngineTypes::EACET_EngineStopped;
+	return Hot.bInPool || (Hot.bPlayerEnteredVehicle == false && bEngineOff && Hot.bAircraftDestroyed == false);
+}
+
+void AAircraft::UpdateNetDormancy()
+{
+	if (HasAuthority() == false || bAutomaticNetDormancy == false) return;
+
+	const ENetDormancy TargetDormancy = IsParked() ? DORM_DormantAll : DORM_Awake;
+	if (NetDormancy != TargetDormancy)
+	{
+		SetNetDormancy(TargetDormancy);
+	}
+}
+
+void AAircraft::FlushReplicatedChange()
+{
+	if (HasAuthority() == false) return;
+
+	/*Dirty properties of a dormant actor are never gathered; a parked aircraft that stays dormant sends this change once*/
+	UpdateNetDormancy();
+	if (NetDormancy > DORM_Awake)
+	{
+		FlushNetDormancy();
+	}
+}
+
+void AAircraft::SetPlayerEnteredVehicle(bool bPlayerEnter)
+{
+	Hot.bPlayerEnteredVehicle = bPlayerEnter;
+	UpdateActivityState();
+}
+
+void AAircraft::StartEngines(bool bStart)
+{
+	Hot.bEngineStarted = bStart;
+	UpdateActivityState();
+}
+
+void AAircraft::PostNetReceiveLocationAndRotation()
+{
+	const FVector PreviousLocation = GetActorLocation();
+	Super::PostNetReceiveLocationAndRotation();
+
+	if (UAircraftNetStatsSubsystem* NetStats = GetWorld()->GetSubsystem<UAircraftNetStatsSubsystem>())
+	{
+		NetStats->RecordCorrection(this, PreviousLocation, GetActorLocation());
+	}
+}
+#pragma endregion
+
+#pragma region AssetPreload
+void AAircraft::GatherPreloadAssets(TArray<FSoftObjectPath>& OutAssets, bool bIncludeCosmetics) const
+{
+	if (bIncludeCosmetics == false) return;
+
+	const FSoftObjectPath CosmeticAssets[] =
+	{
+		ThrusterFX.ToSoftObjectPath(),
+		JetEngineSound.ToSoftObjectPath(),
+		JetEngineInteriorSound.ToSoftObjectPath(),
+		AxisEffectSound.ToSoftObjectPath(),
+		RadioPlaylist.ToSoftObjectPath(),
+		ExplosionFX.ToSoftObjectPath(),
+		ExplosionParticle.ToSoftObjectPath(),
+		ExplosionSound.ToSoftObjectPath(),
+		TakeOffCameraShake.ToSoftObjectPath(),
+		ReceiveDamageCameraShake.ToSoftObjectPath()
+	};
+
+	for (const FSoftObjectPath& AssetPath : CosmeticAssets)
+	{
+		if (AssetPath.IsNull() == false)
+		{
+			OutAssets.AddUnique(AssetPath);
+		}
+	}
+}
+
+void AAircraft::OnAircraftAssetsReady()
+{
+	/*Engines started while the thruster system was still streaming spawned no thrusters*/
+	const bool bMissingThrusters = MiddleFrontThrusterFXs == nullptr && RightFrontThrusterFXs == nullptr && LeftFrontThrusterFXs == nullptr;
+	if (AircraftEngineTypes == EAircraftEngineTypes::EACET_EngineStarted && bMissingThrusters && ThrusterFX.Get())
+	{
+		Handle_EngineStarted();
+	}
+}
+#pragma endregion
+
+#pragma region Activity
+EAircraftActivityState AAircraft::EvaluateActivityState() const
+{
+	if (Hot.bInPool)
+	{
+		return EAircraftActivityState::EAAS_Parked;
+	}
+	if (Hot.bAircraftDestroyed)
+	{
+		return EAircraftActivityState::EAAS_Destroyed;
+	}
+
+	const bool bEngineRunning = Hot.bEngineStarted || AircraftEngineTypes == EAircraftEngineTypes::EACET_EngineStarted;
+	if (Hot.bPlayerEnteredVehicle)
+	{
+		return bEngineRunning ? EAircraftActivityState::EAAS_Flying : EAircraftActivityState::EAAS_Occupied;
+	}
+	return bEngineRunning ? EAircraftActivityState::EAAS_EngineIdle : EAircraftActivityState::EAAS_Parked;
+}
+
+void AAircraft::UpdateActivityState()
+{
+	const EAircraftActivityState NewState = EvaluateActivityState();
+	if (NewState == Hot.ActivityState) return;
+
+	const EAircraftActivityState PreviousState = Hot.ActivityState;
+	Hot.ActivityState = NewState;
+	ApplyActivityState();
+	OnActivityStateChanged(PreviousState);
+}
+
+void AAircraft::ApplyActivityState()
+{
+	/*Only a piloted aircraft runs the flight update, and only its camera rig needs spring arm lag*/
+	const bool bPiloted = Hot.ActivityState == EAircraftActivityState::EAAS_Occupied || Hot.ActivityState == EAircraftActivityState::EAAS_Flying;
+	const bool bThrustersVisible = Hot.ActivityState == EAircraftActivityState::EAAS_Flying || Hot.ActivityState == EAircraftActivityState::EAAS_EngineIdle;
+
+	if (IsActorTickEnabled() != bPiloted)
+	{
+		SetActorTickEnabled(bPiloted);
+		if (bPiloted) { INC_DWORD_STAT(STAT_AircraftTicking); } else { DEC_DWORD_STAT(STAT_AircraftTicking); }
+	}
+
+	if (SpringArm)
+	{
+		SpringArm->SetComponentTickEnabled(bPiloted);
+	}
+
+	for (UNiagaraComponent* ThrusterComponent : { MiddleFrontThrusterFXs, RightFrontThrusterFXs, LeftFrontThrusterFXs })
+	{
+		if (ThrusterComponent)
+		{
+			ThrusterComponent->SetComponentTickEnabled(bThrustersVisible);
+		}
+	}
+
+	if (UAircraftWorkScheduler* WorkScheduler = UAircraftWorkScheduler::Get(this))
+	{
+		const bool bFlying = Hot.ActivityState == EAircraftActivityState::EAAS_Flying;
+		WorkScheduler->SetWorkEnabled(ThrusterWork, bFlying);
+		WorkScheduler->SetWorkEnabled(EngineSoundWork, bFlying);
+	}
+
+	UpdateNetDormancy();
+}
+
+void AAircraft::RegisterScheduledWork()
+{
+	UAircraftWorkScheduler* WorkScheduler = UAircraftWorkScheduler::Get(this);
+	if (WorkScheduler == nullptr || GetNetMode() == NM_DedicatedServer) return;
+
+	/*Unregistered in EndPlay; bound weakly as well, so an item can never call into a dead aircraft*/
+	ThrusterWork = WorkScheduler->RegisterWork(EAircraftWorkPriority::EAWP_Normal, 1.0f / 30.0f, 0.1f, FAircraftWorkDelegate::CreateWeakLambda(this, [this](float SinceLastRun)
+	{
+		if (Hot.bPlayerEnteredVehicle && IsEngineStarted() && Hot.bUpdateThrusters)
+		{
+			UpdateThrusters();
+		}
+	}));
+
+	EngineSoundWork = WorkScheduler->RegisterWork(EAircraftWorkPriority::EAWP_Normal, 1.0f / 20.0f, 0.15f, FAircraftWorkDelegate::CreateWeakLambda(this, [this](float SinceLastRun)
+	{
+		if (Hot.bPlayerEnteredVehicle && IsEngineStarted())
+		{
+			Play_AerodynamicSounds();
+		}
+	}));
+}
+
+void AAircraft::OnActivityStateChanged(EAircraftActivityState PreviousState)
+{
+
+}
+
+uint64 AAircraft::GetTotalTickCount()
+{
+	return GAircraftTickCount;
+}
+#pragma endregion
+
 #pragma region Overlap
 
 void AAircraft::OnSphereOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
@@ -278,7 +582,7 @@ void AAircraft::EnhancedInputLocalPlayerSubsystem()
 	{
 		if (UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer()))
 		{
-			Subsystem->AddMappingContext(AerodyneMappingContext, 0);
+			Subsystem->AddMappingContext(AircraftMappingContext, 0);
 		}
 	}
 }
@@ -290,20 +594,21 @@ void AAircraft::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 
 	if (UEnhancedInputComponent* EnhancedInputComponent = CastChecked<UEnhancedInputComponent>(PlayerInputComponent))
 	{ 
-		EnhancedInputComponent->BindAction(ThrottleInputAction,			 ETriggerEvent::Started,   this, &AAircraft::InputAxis_ThrottleControl);
+		/*Triggered fires every frame while an axis is deflected, so stick movement after the initial press is seen too*/
+		EnhancedInputComponent->BindAction(ThrottleInputAction,			 ETriggerEvent::Triggered, this, &AAircraft::InputAxis_ThrottleControl);
 		EnhancedInputComponent->BindAction(ThrottleInputAction,			 ETriggerEvent::Completed, this, &AAircraft::InputAxis_ThrottleControlReleased);
 
 		EnhancedInputComponent->BindAction(PitchMovementInputAction,	 ETriggerEvent::Triggered, this, &AAircraft::InputAxis_PitchControl);
 		EnhancedInputComponent->BindAction(PitchMovementInputAction,	 ETriggerEvent::Completed, this, &AAircraft::InputAxis_PitchControlReleased);
 
-		EnhancedInputComponent->BindAction(YawMovementInputAction,		 ETriggerEvent::Started,   this, &AAircraft::InputAxis_YawControl);
+		EnhancedInputComponent->BindAction(YawMovementInputAction,		 ETriggerEvent::Triggered, this, &AAircraft::InputAxis_YawControl);
 		EnhancedInputComponent->BindAction(YawMovementInputAction,		 ETriggerEvent::Completed, this, &AAircraft::InputAxis_YawControlReleased);
 
-		EnhancedInputComponent->BindAction(RollMovementInputAction,		 ETriggerEvent::Started,   this, &AAircraft::InputAxis_RollControl);
+		EnhancedInputComponent->BindAction(RollMovementInputAction,		 ETriggerEvent::Triggered, this, &AAircraft::InputAxis_RollControl);
 		EnhancedInputComponent->BindAction(RollMovementInputAction,		 ETriggerEvent::Completed, this, &AAircraft::InputAxis_RollControlReleased);
 
 		EnhancedInputComponent->BindAction(BoosterInputAction,			 ETriggerEvent::Started,   this, &AAircraft::InputAction_BoosterActivate);
-		EnhancedInputComponent->BindAction(BoosterInputAction,			 ETriggerEvent::Completed, this, &AAircraft::InputAction_BoosterDeActivate);
+		EnhancedInputComponent->BindAction(BoosterInputAction,			 ETriggerEvent::Completed, this, &AAircraft::InputAction_BoosterDeactivate);
 
 		EnhancedInputComponent->BindAction(ZoomInOutInputAction,		 ETriggerEvent::Triggered, this, &AAircraft::InputAction_ZoomInOut);
 
@@ -317,88 +622,151 @@ void AAircraft::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 void AAircraft::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	DOREPLIFETIME(AAircraft, AeroEngineTypes);
-	DOREPLIFETIME(AAircraft, OutsiteJetSound);
+
+	/*Push model: these are only compared when a mutation site marks them dirty*/
+	FDoRepLifetimeParams PushModelParams;
+	PushModelParams.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(AAircraft, AircraftEngineTypes, PushModelParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AAircraft, OutsideJetSound, PushModelParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AAircraft, Vitals, PushModelParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AAircraft, Shield, PushModelParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AAircraft, BoosterFuel, PushModelParams);
 }
 
 #pragma region InputFunctionalities
+/*Axis bindings only record the raw value; SamplePilotInput shapes all axes once per frame. Get<float> keeps the sign GetMagnitude dropped*/
 void AAircraft::InputAxis_ThrottleControl(const FInputActionValue& Value)
 {
-	StoredInputThrottle = Value.GetMagnitude();
+	GetInputPipeline().SetRawAxis(EAircraftInputAxis::EAIA_Throttle, Value.Get<float>());
 }
 
 void AAircraft::InputAxis_ThrottleControlReleased(const FInputActionValue& Value)
 {
-	StoredInputThrottle = Value.GetMagnitude();
+	GetInputPipeline().SetRawAxis(EAircraftInputAxis::EAIA_Throttle, 0.0f);
 }
 
 void AAircraft::InputAxis_PitchControl(const FInputActionValue& Value)
 {
-	StoredInputPitch = Value.GetMagnitude();
+	GetInputPipeline().SetRawAxis(EAircraftInputAxis::EAIA_Pitch, Value.Get<float>());
 }
 
 void AAircraft::InputAxis_PitchControlReleased(const FInputActionValue& Value)
 {
-	StoredInputPitch = Value.GetMagnitude();;
+	GetInputPipeline().SetRawAxis(EAircraftInputAxis::EAIA_Pitch, 0.0f);
 }
 
 void AAircraft::InputAxis_YawControl(const FInputActionValue& Value)
 {
-	StoredInputYaw = Value.GetMagnitude();
+	GetInputPipeline().SetRawAxis(EAircraftInputAxis::EAIA_Yaw, Value.Get<float>());
 }
 
 void AAircraft::InputAxis_YawControlReleased(const FInputActionValue& Value)
 {
-	StoredInputYaw = Value.GetMagnitude();;
+	GetInputPipeline().SetRawAxis(EAircraftInputAxis::EAIA_Yaw, 0.0f);
 }
 
 void AAircraft::InputAxis_RollControl(const FInputActionValue& Value)
 {
-	StoredInputRoll = Value.GetMagnitude();
+	GetInputPipeline().SetRawAxis(EAircraftInputAxis::EAIA_Roll, Value.Get<float>());
 }
 
 void AAircraft::InputAxis_RollControlReleased(const FInputActionValue& Value)
 {
-	StoredInputRoll = Value.GetMagnitude();;
+	GetInputPipeline().SetRawAxis(EAircraftInputAxis::EAIA_Roll, 0.0f);
+}
+
+FAircraftInputPipeline& AAircraft::GetInputPipeline()
+{
+	if (InputPipeline.IsValid() == false)
+	{
+		InputPipeline = MakeUnique<FAircraftInputPipeline>();
+		InputPipeline->SetResponse(EAircraftInputAxis::EAIA_Throttle, ThrottleResponse);
+		InputPipeline->SetResponse(EAircraftInputAxis::EAIA_Pitch, PitchResponse);
+		InputPipeline->SetResponse(EAircraftInputAxis::EAIA_Yaw, YawResponse);
+		InputPipeline->SetResponse(EAircraftInputAxis::EAIA_Roll, RollResponse);
+	}
+	return *InputPipeline;
+}
+
+void AAircraft::SamplePilotInput(float DeltaTime)
+{
+	const FAircraftInputFrame& Frame = GetInputPipeline().Sample(DeltaTime, GetResourceTime());
+	Hot.InputThrottle	= Frame.GetAxis(EAircraftInputAxis::EAIA_Throttle);
+	Hot.InputPitch	= Frame.GetAxis(EAircraftInputAxis::EAIA_Pitch);
+	Hot.InputYaw		= Frame.GetAxis(EAircraftInputAxis::EAIA_Yaw);
+	Hot.InputRoll		= Frame.GetAxis(EAircraftInputAxis::EAIA_Roll);
+}
+
+void AAircraft::SetPilotInput(float Throttle, float Pitch, float Yaw, float Roll)
+{
+	Hot.InputThrottle	= FMath::Clamp(Throttle, -1.0f, 1.0f);
+	Hot.InputPitch	= FMath::Clamp(Pitch, -1.0f, 1.0f);
+	Hot.InputYaw		= FMath::Clamp(Yaw, -1.0f, 1.0f);
+	Hot.InputRoll		= FMath::Clamp(Roll, -1.0f, 1.0f);
+}
+
+void AAircraft::SetBoosterActive(bool bActive)
+{
+	if (bActive)
+	{
+		InputAction_BoosterActivate();
+	}
+	else
+	{
+		InputAction_BoosterDeactivate();
+	}
+}
+
+void AAircraft::SetEnginesRunning(bool bRunning)
+{
+	if (Hot.bEngineStarted != bRunning)
+	{
+		InputAction_StartOrStopEngines();
+	}
 }
 
 /*Action Functions*/
 void AAircraft::InputAction_StartOrStopEngines()
 {
-	bEngineStarted = !bEngineStarted;
+	Hot.bEngineStarted = !Hot.bEngineStarted;
 
-	if (bEngineStarted)
+	if (Hot.bEngineStarted)
 	{
-		SetAeroEngineTypes(EAeroEngineTypes::EAET_EngineStarted);
+		SetAircraftEngineTypes(EAircraftEngineTypes::EACET_EngineStarted);
 	}
 	else
 	{
-		SetAeroEngineTypes(EAeroEngineTypes::EAET_EngineStopped);
+		SetAircraftEngineTypes(EAircraftEngineTypes::EACET_EngineStopped);
 	}
 
-	CheckAeroEngineTypes();
+	CheckAircraftEngineTypes();
 }
 
 void AAircraft::InputAction_BoosterActivate()
 {
-	if (CurrentSpeed < MaxThrustSpeed || bEngineStarted == false) return;
-	if (bBoostActivated == false)
+	if (Hot.Flight.CurrentSpeed < FlightTuning.MaxThrustSpeed || Hot.bEngineStarted == false || GetBoosterFuel() <= 0.0f) return;
+	if (Hot.bBoostActivated == false)
 	{
-		bBoostActivated = true;
+		Hot.bBoostActivated = true;
+		SetBoosterFuelRate(-BoosterFuelBurnRate);
 	}
 }
 
-void AAircraft::InputAction_BoosterDeActivate()
+void AAircraft::InputAction_BoosterDeactivate()
 {
-	if (bEngineStarted == false) return;
-	if (bBoostActivated == true)
+	if (Hot.bEngineStarted == false) return;
+	if (Hot.bBoostActivated == true)
 	{
-		bBoostActivated = false;
+		Hot.bBoostActivated = false;
+		SetBoosterFuelRate(0.0f);
 	}
 }
 
 void AAircraft::InputAction_SwitchCamera(const FInputActionValue& Value)
 {
+	if (HasLocalViewRig() == false) return;
+
 	if (BehindCamera->IsActive())
 	{
 		BehindCamera->SetActive(false);
@@ -417,26 +785,26 @@ void AAircraft::InputAction_SwitchCamera(const FInputActionValue& Value)
 		SpringArm->bEnableCameraRotationLag = true;
 		Cache_InteriorCamera = false;
 	}
-	else if (TargettingAerialStrikeCamera->IsActive() && Cache_InteriorCamera)
+	else if (TargetingAerialStrikeCamera && TargetingAerialStrikeCamera->IsActive() && Cache_InteriorCamera)
 	{
-		TargettingAerialStrikeCamera->Deactivate();
+		TargetingAerialStrikeCamera->Deactivate();
 		BehindCamera->Deactivate();
 		FrontCamera->Deactivate();
 		InteriorCamera->SetActive(true);
-		bCameraSwitchedWhileTargettingCameraOn = true;
+		bCameraSwitchedWhileTargetingCameraOn = true;
 	}
-	else if (TargettingAerialStrikeCamera->IsActive() && Cache_InteriorCamera == false)
+	else if (TargetingAerialStrikeCamera && TargetingAerialStrikeCamera->IsActive() && Cache_InteriorCamera == false)
 	{
-		TargettingAerialStrikeCamera->Deactivate();
+		TargetingAerialStrikeCamera->Deactivate();
 		InteriorCamera->Deactivate();
 		FrontCamera->Deactivate();
 		BehindCamera->SetActive(true);
-		bCameraSwitchedWhileTargettingCameraOn = true;
+		bCameraSwitchedWhileTargetingCameraOn = true;
 	}
 }
 void AAircraft::InputAction_ZoomInOut(const FInputActionValue& Value)
 {
-	if (BehindCamera->IsActive() == false) return;
+	if (HasLocalViewRig() == false || BehindCamera->IsActive() == false) return;
 
 	const FVector2D ZoomInputValue = Value.Get<FVector2D>();
 	float ScrollInputValue = ZoomInputValue.X;
@@ -452,13 +820,14 @@ void AAircraft::InputAction_ZoomInOut(const FInputActionValue& Value)
 /*Actions*/
 void AAircraft::InputAction_Radio(const FInputActionValue& Value)
 {
-	bRadioStarted = !bRadioStarted;
+	FAircraftAudioState& Audio = GetAudioState();
+	Audio.bRadioStarted = !Audio.bRadioStarted;
 
-	if (bRadioStarted)
+	if (Audio.bRadioStarted)
 	{
 		Play_Radio();
 	}
-	else
+	else if (RadioAudioComponent)
 	{
 		RadioAudioComponent->Stop();
 	}
@@ -466,7 +835,7 @@ void AAircraft::InputAction_Radio(const FInputActionValue& Value)
 
 void AAircraft::InputAction_ExitVehicle(const FInputActionValue& Value)
 {
-	if ( bPlayerEnteredVehicle == false || BaseCharacter == nullptr || ExitArrow == nullptr) return;
+	if ( Hot.bPlayerEnteredVehicle == false || BaseCharacter == nullptr || ExitArrow == nullptr) return;
 
 	if (BaseCharacter)
 	{
@@ -474,6 +843,7 @@ void AAircraft::InputAction_ExitVehicle(const FInputActionValue& Value)
 		BaseCharacter->SetActorTransform(ExitArrow->GetComponentTransform(), false, nullptr, ETeleportType::ResetPhysics);
 		BaseCharacter->SetPlayerInVehicle(false);
 		SetPlayerEnteredVehicle(false);
+		DestroyLocalViewRig();
 
 		APlayerControllerManager* PlayerControllerManager = Cast<APlayerControllerManager>(Controller);
 		if (PlayerControllerManager)
@@ -486,7 +856,7 @@ void AAircraft::InputAction_ExitVehicle(const FInputActionValue& Value)
 		{
 			FModifyContextOptions ModifyContextOption;
 			ModifyContextOption.bForceImmediately;
-			Subsystem->RemoveMappingContext(AerodyneMappingContext, ModifyContextOption);
+			Subsystem->RemoveMappingContext(AircraftMappingContext, ModifyContextOption);
 
 			Subsystem->AddMappingContext(BaseCharacter->GetBaseCharacterMappingContext(), 0);
 		}
@@ -496,315 +866,106 @@ void AAircraft::InputAction_ExitVehicle(const FInputActionValue& Value)
 			PlayerController->Possess(BaseCharacter);
 		}
 
-		bPlayerEnteredVehicle = false;
+		Hot.bPlayerEnteredVehicle = false;
 	}
 }
 
 #pragma endregion
 void AAircraft::AutoTakeOff(float DeltaTime)
 {
-	if (bPlayerEnteredVehicle == false || bEngineStarted == false || bAircraftTakenOff == true) return;
-
-	AircraftTakeOffTimer += GetWorld()->GetDeltaSeconds();
-	if (AircraftTakeOffTimer <= AircraftTakeOffDelay) return;
-	PlayTakeOffCameraShake(TakeOffCameraShake);
-
-
-	float DragMultiplier					= 1.213f;
-	float AirResistenceForce				= 0.588f;
-	float TakeOffThressHoldMaxSpeed			= 1500.f;
-	float TargetSpeed = 
-	FMath::FInterpTo
-	(
-		CurrentSpeed,
-		TakeOffThressHoldMaxSpeed,
-		DeltaTime * AirResistenceForce,
-		AirDragFactor * DragMultiplier
-	);
-
-	CurrentSpeed							= TargetSpeed;
-
-	FVector NewPosition;
-	FVector ActorForwardVector				= GetActorForwardVector();
-	float MultiplierSpeed					= 0.15f;
-	float MultipliedCurrentSpeedbyDeltaTime = CurrentSpeed * DeltaTime;
-	FVector MultipliedForwardVec			= ActorForwardVector * MultipliedCurrentSpeedbyDeltaTime;
-	NewPosition								= MultipliedForwardVec;
-
-	CalculateGravity(DeltaTime, OutGravity);
-
-	/*Update Position*/
-	float NewPosX						= NewPosition.X;
-	float NewPosY						= NewPosition.Y;
-	float NewPosZ						= NewPosition.Z;
-	AppliedGravity						= OutGravity;
+	if (Hot.bPlayerEnteredVehicle == false || Hot.bEngineStarted == false || Hot.bAircraftTakenOff == true) return;
 
-	float AffectGravity					= NewPosZ - AppliedGravity;
-	FVector LastUpdatedVector			= FVector(NewPosX, NewPosY, AffectGravity);
-	AddActorWorldOffset(LastUpdatedVector, true);
-
-	float SpeedThresholdForPitchController				= 900.0f;
-	float CorrectionSpeedThresholdForPitchController	= 1300.0f;
-	float LastPhaseBeforeCompleteTakeOff				= 1350.0f;
-
-	float TakeOffPitch;
-	if (CurrentSpeed >= SpeedThresholdForPitchController && CurrentSpeed <= CorrectionSpeedThresholdForPitchController)
-	{
-		TakeOffPitch = -0.50f;
-		PitchUpdate(TakeOffPitch);
-	}
-	else if (CurrentSpeed > CorrectionSpeedThresholdForPitchController && CurrentSpeed <= LastPhaseBeforeCompleteTakeOff)
+	if (Hot.bAircraftTakeOffDelayElapsed == false)
 	{
-		TakeOffPitch = 1.20f;
-		PitchUpdate(TakeOffPitch);
-	}
-	else
-	{
-		TakeOffPitch = 0.0f;
-		PitchUpdate(TakeOffPitch);
+		UAircraftTimerWheelSubsystem* TimerWheel = UAircraftTimerWheelSubsystem::Get(this);
+		if (TimerWheel && TimerWheel->IsTimerActive(AircraftTakeOffTimer) == false)
+		{
+			AircraftTakeOffTimer = TimerWheel->SetTimer(AircraftTakeOffDelay, FSimpleDelegate::CreateWeakLambda(this, [this]()
+			{
+				Hot.bAircraftTakeOffDelayElapsed = true;
+			}));
+		}
+		return;
 	}
+	PlayTakeOffCameraShake(TakeOffCameraShake.Get());
 
-	if (CurrentSpeed > LastPhaseBeforeCompleteTakeOff + 50.0f)
-	{
-		bAircraftTakenOff = true;
-	}
+	IntegrateFlight(DeltaTime, true);
 }
 
-void AAircraft::UpdatePosition(float DeltaTime)
+void AAircraft::IntegrateFlight(float DeltaTime, bool bTakingOff)
 {
-	if (bPlayerEnteredVehicle == false || bEngineStarted == false) return;
+	SCOPE_CYCLE_COUNTER(STAT_AircraftIntegrateFlight);
+	FAircraftHealthScope HealthScope(EAircraftHealthPhase::EAHP_Flight);
 
-	/*Calculate Current Speed*/
-	if (ThrustSpeed < CurrentSpeed)
-	{
-		// If the current speed is less than the desired thrust speed,
-		// interpolate towards the target speed based on air drag factor.
-		float TargetSpeed = FMath::FInterpTo(CurrentSpeed, ThrustSpeed, DeltaTime, AirDragFactor);
-		CurrentSpeed = TargetSpeed;
-	}
-	else
+	if (Hot.bBoostActivated && GetBoosterFuel() <= 0.0f)
 	{
-		// If the current speed is greater than or equal to the desired thrust speed,
-		// set the current speed to the thrust speed directly.
-		CurrentSpeed = ThrustSpeed;
+		Hot.bBoostActivated = false;
+		SetBoosterFuelRate(0.0f);
 	}
 
-	/*Calculate new position based on current speed*/
-	FVector NewPosition;
-	FVector ActorForwardVector				= GetActorForwardVector();
-	float MultipliedCurrentSpeedbyDeltaTime = CurrentSpeed * DeltaTime;
-	FVector MultipliedForwardVec			= ActorForwardVector * MultipliedCurrentSpeedbyDeltaTime;
-	NewPosition								= MultipliedForwardVec;
-
-	/*Calculate Applied Gravity*/
-	float Zero								= 0.0f;
-
-	// Adjust gravitational force based on current speed
-	if (CurrentSpeed <= MinThrustSpeedThreshold / 2 + 200.0f)
-	{
-		GravitationalForce += 10.0f;
-	}
-	else if (CurrentSpeed > MinThrustSpeedThreshold)
+	FAircraftFlightInput Input;
+	Input.Throttle			= Hot.InputThrottle;
+	Input.Pitch				= Hot.InputPitch;
+	Input.Yaw				= Hot.InputYaw;
+	Input.Roll				= Hot.InputRoll;
+	Input.Forward			= GetActorForwardVector();
+	Input.bBoostActivated	= Hot.bBoostActivated;
+	Input.bTakingOff		= bTakingOff;
+
+	FAircraftFlightStep Step;
+	if (Hot.StepFunction)
 	{
-		GravitationalForce = 2000.f;
+		Hot.StepFunction(Hot.Flight, Input, DeltaTime, Step);
 	}
-
-	float TargetAppliedGravity =
-	UKismetMathLibrary::MapRangeClamped
-	(
-		CurrentSpeed, 
-		Zero,
-		MinThrustSpeedThreshold, 
-		GravitationalForce,
-		Zero
-	);
-
-	AppliedGravity							= TargetAppliedGravity;
-	/*Update Position*/
-	float NewPosX							= NewPosition.X;
-	float NewPosY							= NewPosition.Y;
-	float NewPosZ							= NewPosition.Z;
-	float TargetAppliedGravityFactor		= AppliedGravity * DeltaTime;
-	float SubtractedZAxis					= NewPosZ - TargetAppliedGravityFactor;
-	FVector LastUpdatedVector				= FVector(NewPosX, NewPosY, SubtractedZAxis);
-
-	// Update the actor's position by adding the calculated vector to the current position.
-	AddActorWorldOffset(LastUpdatedVector, true);
-
-	// Adjust the actor's rotation if the current speed is below a certain threshold.
-	if (CurrentSpeed < MinThrustSpeedThreshold)
+	else
 	{
-		// Define the target rotation for adjustment.
-		FRotator TargetRotation = FRotator(-0.09f, -0.2f, -0.09f);
-
-		// Interpolate towards the target rotation to smoothen the adjustment.
-		FRotator NewRotation = FMath::RInterpTo(TargetRotation * 0.25f, TargetRotation, DeltaTime, 2.0f);
-
-		// Apply the new rotation to the actor.
-		AddActorWorldRotation(NewRotation);
+		FAircraftFlightIntegrator::Step(FlightTuning, Hot.Flight, Input, DeltaTime, Step);
 	}
 
-/*ReportSystem*/
-	/*SpeedHack*/
-	float MaxAeroDyneSpeed = 5500.0f;
-	if (CurrentSpeed > MaxAeroDyneSpeed)
+	AddActorWorldOffset(Step.WorldOffset, true);
+	if (Step.WorldRotation.IsZero() == false)
 	{
-		FString ReportedPlayerName = BaseCharacter->GetName();
-		FString ReportReason = FString(TEXT("Aerodyne exceeding the speed limit"));
-		ReportPlayerToServer(ReportedPlayerName, ReportReason);
+		AddActorWorldRotation(Step.WorldRotation);
 	}
-}
-
-void AAircraft::UpdateAxisByInputValues(float ThrottleValue, float PitchValue, float YawValue, float RollValue)
-{
-	if (bPlayerEnteredVehicle == false) return;
-	ThrottleUpdate(ThrottleValue);
-	PitchUpdate(PitchValue);
-	YawUpdate(YawValue);
-	RollUpdate(RollValue);
-}
-
-void AAircraft::ThrottleUpdate(float InputThrottleValue)
-{
-	if (bBoostActivated)
+	if (Step.LocalRotation.IsIdentity(0.0) == false)
 	{
-		float BoostIncreaseRate = 500.0f;
-		BoostSpeed += BoostIncreaseRate * GetWorld()->GetDeltaSeconds();
-		BoostSpeed = FMath::Clamp(BoostSpeed, 0.0f, MaxBoostSpeed);
+		AddActorLocalRotation(Step.LocalRotation, false, nullptr, ETeleportType::None);
 	}
 
-	if (bBoostActivated == false)
+	if (bTakingOff && Step.bTakeOffComplete)
 	{
-		float BoostDecreaseRate = 750.0f; // Adjust this value as per your requirement
-		BoostSpeed -= BoostDecreaseRate * GetWorld()->GetDeltaSeconds();
-		BoostSpeed = FMath::Clamp(BoostSpeed, 0.0f, MaxBoostSpeed);
+		Hot.bAircraftTakenOff = true;
 	}
-
-	// Get the time passed since the last frame
-	float DeltaSeconds = GetWorld()->GetDeltaSeconds();
-	float Zero = 0.0f;
-
-	// Calculate the change in thrust speed based on the input throttle value
-	float MultipliedAxisValuebyDeltaSeconds = InputThrottleValue * DeltaSeconds * ThrustMultiplier;
-	float AddedValueToThrustSpeed = MultipliedAxisValuebyDeltaSeconds + ThrustSpeed;
-
-	// Ensure the thrust speed does not exceed the maximum threshold
-	float ClampedThrustSpeed = FMath::Clamp(AddedValueToThrustSpeed, Zero, MaxThrustSpeed);
-
-	// Update the thrust speed
-	ThrustSpeed = ClampedThrustSpeed + BoostSpeed;
-}
-
-void AAircraft::PitchUpdate(float InputPitchValue)
-{
-	// Get the time passed since the last frame
-	float DeltaSeconds = GetWorld()->GetDeltaSeconds();
-
-	// Set the target pitch based on input value
-	TargetPitch = InputPitchValue * 0.794f;
-
-	// Interpolate towards the target pitch
-	CurrentPitch = FMath::FInterpTo(CurrentPitch, TargetPitch, DeltaSeconds, AxisInterpolationSpeed);
-
-	// Calculate the rotation for pitch
-	float MultipliedPitchValueByDeltaSecond = CurrentPitch * DeltaSeconds * AeroPitchControlSpeed;
-	float Zero = 0.0f;
-
-	// Apply the pitch rotation to the actor
-	FQuat PitchRotation(FVector(Zero, 1.0f, Zero), MultipliedPitchValueByDeltaSecond);
-	AddActorLocalRotation(PitchRotation, false, nullptr, ETeleportType::None);
 }
 
-void AAircraft::YawUpdate(float InputYawValue)
+void AAircraft::ResolveFlightProfile()
 {
-	// Get the time passed since the last frame
-	float DeltaSeconds = GetWorld()->GetDeltaSeconds();
-
-	// Check if the input yaw value is significant
-	if (FMath::Abs(InputYawValue) > 0.01f)
+	if (FlightProfileAsset)
 	{
-		// Set the target yaw based on input value
-		TargetYaw = InputYawValue;
-
-		// Interpolate towards the target yaw
-		CurrentYaw = FMath::FInterpTo(CurrentYaw, TargetYaw, DeltaSeconds, AxisInterpolationSpeed);
-
-		// Calculate the rotation for yaw
-		float MultipliedYawValueByDeltaSecond = CurrentYaw * DeltaSeconds * AeroYawControlSpeed;
-		float Zero = 0.0f;
-
-		// Apply the yaw rotation to the actor
-		FQuat YawRotation(FVector(Zero, Zero, 1.0f), MultipliedYawValueByDeltaSecond);
-		AddActorLocalRotation(YawRotation, false, nullptr, ETeleportType::None);
+		FlightTuning = FlightProfileAsset->Tuning;
+		Hot.StepFunction = nullptr;
 	}
 	else
 	{
-		// If the input yaw value is small, interpolate towards zero yaw
-		CurrentYaw = FMath::FInterpTo(CurrentYaw, 0.0f, DeltaSeconds, AxisInterpolationSpeed);
-
-		// If the yaw is still significant, apply the rotation
-		if (FMath::Abs(CurrentYaw) > SMALL_NUMBER)
-		{
-			float MultipliedYawValueByDeltaSecond = CurrentYaw * DeltaSeconds * AeroYawControlSpeed;
-			float Zero = 0.0f;
-
-			// Apply the yaw rotation to the actor
-			FQuat YawRotation(FVector(Zero, Zero, 1.0f), MultipliedYawValueByDeltaSecond);
-			AddActorLocalRotation(YawRotation, false, nullptr, ETeleportType::None);
-		}
+		FlightTuning = FAircraftFlightTuning::FromProfile(FlightProfile);
+		Hot.StepFunction = FAircraftFlightIntegrator::GetStepFunction(FlightProfile);
 	}
-}
-
-void AAircraft::RollUpdate(float InputRollValue)
-{
-	// Get the time passed since the last frame
-	float DeltaSeconds = GetWorld()->GetDeltaSeconds();
-
-	// Set the target roll based on input value
-	TargetRoll = InputRollValue;
-	AxisInterpolationSpeed = 2.0f;
-
-	// Interpolate towards the target roll
-	CurrentRoll = FMath::FInterpTo(CurrentRoll, TargetRoll, DeltaSeconds, AxisInterpolationSpeed);
-
-	// Calculate the rotation for roll
-	float MultipliedRollValuebyDeltaSecond = CurrentRoll * DeltaSeconds * AeroRollControlSpeed;
-	float Zero = 0.0f;
-
-	// Apply the roll rotation to the actor
-	FQuat RollRotation(FVector(1, Zero, Zero), MultipliedRollValuebyDeltaSecond);
-	AddActorLocalRotation(RollRotation, false, nullptr, ETeleportType::None);
-}
-
-void AAircraft::CalculateGravity(float DeltaSeconds, float AppliedGravityInput)
-{
-	float Zero = 0.0f;
-	float GravitationalForceFactor;
-
-	GravitationalForceFactor = FMath::GetMappedRangeValueClamped(FVector2D(Zero, MaxThrustSpeed), FVector2D(40.0f, 0.0f), CurrentSpeed);
-	GravitationalForceFactor = FMath::Clamp(GravitationalForceFactor, 0.0f, 40.0f);
-	AppliedGravityInput =
-	UKismetMathLibrary::MapRangeClamped
-	(
-		CurrentSpeed,
-		Zero,
-		MaxThrustSpeed,
-		GravitationalForceFactor,
-		Zero
-	);
+	Hot.Flight.ThrustSpeed = FlightTuning.MinThrustSpeedThreshold;
+	Hot.Flight.GravitationalForce = FlightTuning.GravitationalForce;
 }
 
 #pragma region FXs
 void AAircraft::SpawnTrailSystem(bool bMiddleEngine, bool bRightEngine, bool bLeftEngine, bool bRightSecondEngine, bool bLeftSecondEngine)
 {
 	/*This function spawns visual effects for various thrusters attached to an aerodyne vehicle mesh, setting their properties such as scale and color to create dynamic effects.*/
-	if (ThrusterFX)
+	UNiagaraSystem* ThrusterSystem = ThrusterFX.Get();
+	if (ThrusterSystem)
 	{
 		if (bMiddleEngine)
 		{
 			MiddleFrontThrusterFXs = UNiagaraFunctionLibrary::SpawnSystemAttached
 			(
-				ThrusterFX,
+				ThrusterSystem,
 				AircraftMesh,
 				FName(TEXT("ThrusterMiddle")),
 				FVector::ZeroVector,
@@ -822,7 +983,7 @@ void AAircraft::SpawnTrailSystem(bool bMiddleEngine, bool bRightEngine, bool bLe
 		{
 			RightFrontThrusterFXs = UNiagaraFunctionLibrary::SpawnSystemAttached
 			(
-				ThrusterFX,
+				ThrusterSystem,
 				AircraftMesh,
 				FName(TEXT("ThrusterRight")),
 				FVector::ZeroVector,
@@ -841,7 +1002,7 @@ void AAircraft::SpawnTrailSystem(bool bMiddleEngine, bool bRightEngine, bool bLe
 		{
 			LeftFrontThrusterFXs = UNiagaraFunctionLibrary::SpawnSystemAttached
 			(
-				ThrusterFX,
+				ThrusterSystem,
 				AircraftMesh,
 				FName(TEXT("ThrusterLeft")),
 				FVector::ZeroVector,
@@ -951,7 +1112,7 @@ void AAircraft::UpdateThrusters()
 	float InRangeA		= 0.0f;
 	float OutRangeA		= -10.0f;
 	float OutRangeB		= -500.0f;
-	float ReturnValueX	= UKismetMathLibrary::MapRangeClamped(ThrustSpeed, InRangeA, MaxThrustSpeed, OutRangeA, OutRangeB);
+	float ReturnValueX	= UKismetMathLibrary::MapRangeClamped(Hot.Flight.ThrustSpeed, InRangeA, FlightTuning.MaxThrustSpeed, OutRangeA, OutRangeB);
 
 	FVector InValue		= FVector(ReturnValueX, 0.0f, 0.0f);
 
@@ -977,31 +1138,37 @@ void AAircraft::UpdateThrusters()
 #pragma endregion
 
 #pragma region Sounds
-void AAircraft::Play_AeroDynamicSounds()
+void AAircraft::Play_AerodynamicSounds()
 {
 	/*This function manages the playback of aerodynamic sounds for an aerodyne vehicle based on the vehicle's state and speed.
 	It adjusts the volume and pitch of engine sounds both inside and outside the vehicle, 
 	as well as handling axis sounds like pitch, roll, and yaw. 
 	Additionally, it spawns sound components and manages their properties to reflect the vehicle's dynamics accurately.*/
 
+	USoundCue* LoadedJetEngineSound			= JetEngineSound.Get();
+	USoundCue* LoadedJetEngineInteriorSound	= JetEngineInteriorSound.Get();
+	USoundCue* LoadedAxisEffectSound		= AxisEffectSound.Get();
+
+	FAircraftAudioState& Audio = GetAudioState();
+
 	float Zero = 0.0f;
 	if (Cache_InteriorCamera) /*Inside*/
 	{
-		if (JetEngineSound)
+		if (LoadedJetEngineSound)
 		{
-			if (JetEngineSound->VolumeMultiplier != 0.0f)
+			if (LoadedJetEngineSound->VolumeMultiplier != 0.0f)
 			{
-				JetEngineSound->VolumeMultiplier = 0.0f;
+				LoadedJetEngineSound->VolumeMultiplier = 0.0f;
 			}
 		}
 
-		if (JetEngineInteriorSound)
+		if (LoadedJetEngineInteriorSound)
 		{
-			if (bInteriorEngineSound == false)
+			if (Audio.bInteriorEngineSound == false)
 			{
-				JetEngineInteriorAudioComponent = UGameplayStatics::SpawnSoundAttached
+				Audio.JetEngineInteriorAudioComponent = UGameplayStatics::SpawnSoundAttached
 				(
-					JetEngineInteriorSound,
+					LoadedJetEngineInteriorSound,
 					GetRootComponent(),
 					FName(),
 					GetActorLocation(),
@@ -1011,63 +1178,63 @@ void AAircraft::Play_AeroDynamicSounds()
 					1.0f,
 					0.0f
 				);
-				bInteriorEngineSound = true;
+				Audio.bInteriorEngineSound = true;
 			}
 
-			JetEngineInteriorSound->VolumeMultiplier = 0.5f;
-			if (CurrentSpeed > Zero && CurrentSpeed <= MaxThrustSpeed)
+			LoadedJetEngineInteriorSound->VolumeMultiplier = 0.5f;
+			if (Hot.Flight.CurrentSpeed > Zero && Hot.Flight.CurrentSpeed <= FlightTuning.MaxThrustSpeed)
 			{
-				EngineInteriorVolumePitch = FMath::GetMappedRangeValueClamped(FVector2D(Zero, MaxThrustSpeed), FVector2D(0.5f, 1.0f), CurrentSpeed);
-				EngineInteriorVolumePitch = FMath::Clamp(EngineInteriorVolumePitch, 0.5f, 1.0f);
+				Audio.EngineInteriorVolumePitch = FMath::GetMappedRangeValueClamped(FVector2D(Zero, FlightTuning.MaxThrustSpeed), FVector2D(0.5f, 1.0f), Hot.Flight.CurrentSpeed);
+				Audio.EngineInteriorVolumePitch = FMath::Clamp(Audio.EngineInteriorVolumePitch, 0.5f, 1.0f);
 			}
-			else if (CurrentSpeed > MaxThrustSpeed)
+			else if (Hot.Flight.CurrentSpeed > FlightTuning.MaxThrustSpeed)
 			{
-				EngineInteriorVolumePitch = FMath::GetMappedRangeValueClamped(FVector2D(MaxThrustSpeed, MaxThrustSpeed + MaxBoostSpeed), FVector2D(1.0f, 1.3f), CurrentSpeed);
-				EngineInteriorVolumePitch = FMath::Clamp(EngineInteriorVolumePitch, 1.0f, 1.3f);
+				Audio.EngineInteriorVolumePitch = FMath::GetMappedRangeValueClamped(FVector2D(FlightTuning.MaxThrustSpeed, FlightTuning.MaxThrustSpeed + FlightTuning.MaxBoostSpeed), FVector2D(1.0f, 1.3f), Hot.Flight.CurrentSpeed);
+				Audio.EngineInteriorVolumePitch = FMath::Clamp(Audio.EngineInteriorVolumePitch, 1.0f, 1.3f);
 			}
-			JetEngineInteriorSound->PitchMultiplier = EngineInteriorVolumePitch;
+			LoadedJetEngineInteriorSound->PitchMultiplier = Audio.EngineInteriorVolumePitch;
 		}
 	}
 	else  // Outside
 	{
-		if ( JetEngineInteriorSound && JetEngineInteriorSound->VolumeMultiplier != Zero)
+		if ( LoadedJetEngineInteriorSound && LoadedJetEngineInteriorSound->VolumeMultiplier != Zero)
 		{
-			 JetEngineInteriorSound->VolumeMultiplier = Zero;
-			 bInteriorEngineSound = false;
+			 LoadedJetEngineInteriorSound->VolumeMultiplier = Zero;
+			 Audio.bInteriorEngineSound = false;
 		}
 
-		if (JetEngineSound)
+		if (LoadedJetEngineSound)
 		{
-			if (CurrentSpeed > Zero && CurrentSpeed <= MaxThrustSpeed)
+			if (Hot.Flight.CurrentSpeed > Zero && Hot.Flight.CurrentSpeed <= FlightTuning.MaxThrustSpeed)
 			{
-				EngineVolume		= FMath::GetMappedRangeValueClamped(FVector2D(Zero, MaxThrustSpeed), FVector2D(0.1f, 0.3f), CurrentSpeed);
-				EngineVolume		= FMath::Clamp(EngineVolume, 0.1f, 0.3f);
+				Audio.EngineVolume		= FMath::GetMappedRangeValueClamped(FVector2D(Zero, FlightTuning.MaxThrustSpeed), FVector2D(0.1f, 0.3f), Hot.Flight.CurrentSpeed);
+				Audio.EngineVolume		= FMath::Clamp(Audio.EngineVolume, 0.1f, 0.3f);
 
-				EngineVolumePitch	= FMath::GetMappedRangeValueClamped(FVector2D(Zero, MaxThrustSpeed), FVector2D(0.5f, 1.5f), CurrentSpeed);
-				EngineVolumePitch	= FMath::Clamp(EngineVolumePitch, 0.5f, 1.5f);
+				Audio.EngineVolumePitch	= FMath::GetMappedRangeValueClamped(FVector2D(Zero, FlightTuning.MaxThrustSpeed), FVector2D(0.5f, 1.5f), Hot.Flight.CurrentSpeed);
+				Audio.EngineVolumePitch	= FMath::Clamp(Audio.EngineVolumePitch, 0.5f, 1.5f);
 			}
-			else if (CurrentSpeed > MaxThrustSpeed) // MaxThrustSpeed + BoostSpeed 
+			else if (Hot.Flight.CurrentSpeed > FlightTuning.MaxThrustSpeed) // MaxThrustSpeed + BoostSpeed 
 			{
-				EngineVolume		= FMath::GetMappedRangeValueClamped(FVector2D(MaxThrustSpeed, MaxThrustSpeed + MaxBoostSpeed), FVector2D(0.3f, 0.4f), CurrentSpeed);
-				EngineVolume		= FMath::Clamp(EngineVolume, 0.3f, 0.4f);
+				Audio.EngineVolume		= FMath::GetMappedRangeValueClamped(FVector2D(FlightTuning.MaxThrustSpeed, FlightTuning.MaxThrustSpeed + FlightTuning.MaxBoostSpeed), FVector2D(0.3f, 0.4f), Hot.Flight.CurrentSpeed);
+				Audio.EngineVolume		= FMath::Clamp(Audio.EngineVolume, 0.3f, 0.4f);
 
-				EngineVolumePitch	= FMath::GetMappedRangeValueClamped(FVector2D(MaxThrustSpeed, MaxThrustSpeed + MaxBoostSpeed), FVector2D(1.5f, 1.8f), CurrentSpeed);
-				EngineVolumePitch	= FMath::Clamp(EngineVolumePitch, 1.5f, 1.8f);
+				Audio.EngineVolumePitch	= FMath::GetMappedRangeValueClamped(FVector2D(FlightTuning.MaxThrustSpeed, FlightTuning.MaxThrustSpeed + FlightTuning.MaxBoostSpeed), FVector2D(1.5f, 1.8f), Hot.Flight.CurrentSpeed);
+				Audio.EngineVolumePitch	= FMath::Clamp(Audio.EngineVolumePitch, 1.5f, 1.8f);
 			}
-			JetEngineSound->VolumeMultiplier	= EngineVolume;
-			JetEngineSound->PitchMultiplier		= EngineVolumePitch;
-			JetEngineAudioComponent				= UGameplayStatics::SpawnSound2D(this, JetEngineSound);
+			LoadedJetEngineSound->VolumeMultiplier	= Audio.EngineVolume;
+			LoadedJetEngineSound->PitchMultiplier		= Audio.EngineVolumePitch;
+			Audio.JetEngineAudioComponent				= UGameplayStatics::SpawnSound2D(this, LoadedJetEngineSound);
 		}
-		if (AxisEffectSound)
+		if (LoadedAxisEffectSound)
 		{
-			if (FMath::Abs(CurrentPitch) > 1.0f)
+			if (FMath::Abs(Hot.Flight.CurrentPitch) > 1.0f)
 			{
-				if (bAxisSound == false)
+				if (Audio.bAxisSound == false)
 				{
 
-					AxisSoundEffectAudioComponent = UGameplayStatics::SpawnSoundAttached
+					Audio.AxisSoundEffectAudioComponent = UGameplayStatics::SpawnSoundAttached
 					(
-						AxisEffectSound,
+						LoadedAxisEffectSound,
 						GetRootComponent(),
 						FName(),
 						GetActorLocation(),
@@ -1077,9 +1244,9 @@ void AAircraft::Play_AeroDynamicSounds()
 						1.0f,
 						0.0f
 					);
-					bAxisSound = true;
+					Audio.bAxisSound = true;
 				}
-				float NormalizedPitch = FMath::Clamp(CurrentPitch, -5.0f, 5.0f) / 5.0f;
+				float NormalizedPitch = FMath::Clamp(Hot.Flight.CurrentPitch, -5.0f, 5.0f) / 5.0f;
 
 				float DefaultVolume = 0.2f;
 				float MaxVolumeLevel = 0.5f;
@@ -1092,24 +1259,36 @@ void AAircraft::Play_AeroDynamicSounds()
 				float AxisVolume = FMath::Lerp(DefaultVolume, MaxVolumeLevel, FMath::Abs(NormalizedPitch));
 				float AxisPitch = FMath::Lerp(DefaultPitch, MaxPitchLevel, FMath::Abs(NormalizedPitch));
 
-				AxisEffectSound->VolumeMultiplier = AxisVolume;
-				AxisEffectSound->PitchMultiplier = AxisPitch;
+				LoadedAxisEffectSound->VolumeMultiplier = AxisVolume;
+				LoadedAxisEffectSound->PitchMultiplier = AxisPitch;
 			}
 			else
 			{
-				AxisEffectSound->VolumeMultiplier = 0.0f;
-				bAxisSound = false;
+				LoadedAxisEffectSound->VolumeMultiplier = 0.0f;
+				Audio.bAxisSound = false;
 			}
 		}
 	}
 }
 
 
+AAircraft::FAircraftAudioState& AAircraft::GetAudioState()
+{
+	if (AudioState.IsValid() == false)
+	{
+		AudioState = MakeUnique<FAircraftAudioState>();
+	}
+	return *AudioState;
+}
+
 void AAircraft::Play_Radio()
 {
+	USoundCue* LoadedRadioPlaylist = RadioPlaylist.Get();
+	if (LoadedRadioPlaylist == nullptr) return;
+
 	RadioAudioComponent = UGameplayStatics::SpawnSoundAttached
 	(
-		RadioPlaylist,
+		LoadedRadioPlaylist,
 		GetRootComponent(),
 		FName(),
 		GetActorLocation(),
@@ -1122,12 +1301,12 @@ void AAircraft::Play_Radio()
 }
 
 
-void AAircraft::Local_OutsiteJetSound(USoundCue* OutsiteSound)
+void AAircraft::Local_OutsideJetSound(USoundCue* OutsideSound)
 {
-	if (OutsiteJetSound && OutsiteJetSoundLoopingSoundAttenuation)
+	if (OutsideJetSound && OutsideJetSoundLoopingSoundAttenuation)
 	{
-		OutsiteJetSoundLoopComponent = UGameplayStatics::SpawnSoundAttached(
-			OutsiteJetSound,
+		OutsideJetSoundLoopComponent = UGameplayStatics::SpawnSoundAttached(
+			OutsideJetSound,
 			GetRootComponent(),
 			FName(),
 			GetActorLocation(),
@@ -1136,24 +1315,100 @@ void AAircraft::Local_OutsiteJetSound(USoundCue* OutsiteSound)
 			1.0f,
 			1.0f,
 			0.0f,
-			OutsiteJetSoundLoopingSoundAttenuation,
+			OutsideJetSoundLoopingSoundAttenuation,
 			(USoundConcurrency*)nullptr,
 			false
 		);
-		OutsiteJetSoundLoopComponent->VolumeMultiplier = 1.0f;
+		OutsideJetSoundLoopComponent->VolumeMultiplier = 1.0f;
+
+		OutsideJetSoundLoopComponent->bIsUISound = false;
+		OutsideJetSoundLoopComponent->bAutoDestroy = false;
+	}
+}
+#pragma region Camera
+void AAircraft::PawnClientRestart()
+{
+	Super::PawnClientRestart();
 
-		OutsiteJetSoundLoopComponent->bIsUISound = false;
-		OutsiteJetSoundLoopComponent->bAutoDestroy = false;
+	if (IsLocallyControlled() && HasLocalViewRig() == false)
+	{
+		CreateLocalViewRig();
 	}
 }
-#pragma region 
 
+void AAircraft::UnPossessed()
+{
+	DestroyLocalViewRig();
+	if (InputPipeline.IsValid())
+	{
+		InputPipeline->Reset();
+	}
+	Super::UnPossessed();
+}
+
+void AAircraft::CreateLocalViewRig()
+{
+	if (HasLocalViewRig()) return;
+
+	SpringArm = NewObject<USpringArmComponent>(this, MakeUniqueObjectName(this, USpringArmComponent::StaticClass(), TEXT("SpringArm")), RF_Transient);
+	SpringArm->SetupAttachment(AircraftMesh);
+
+	SpringArm->TargetArmLength			= 3000.0f;
+	SpringArm->TargetOffset				= FVector(0.0f, 0.0f, 500.0f);
+	SpringArm->bEnableCameraLag			= true;
+	SpringArm->bEnableCameraRotationLag	= true;
+	SpringArm->CameraLagSpeed			= 10.0f;
+	SpringArm->CameraRotationLagSpeed	= 10.0f;
+	SpringArm->PrimaryComponentTick.bStartWithTickEnabled = IsActorTickEnabled();
+	SpringArm->RegisterComponent();
+
+	BehindCamera	= CreateViewCamera(TEXT("BehindCamera"),	SpringArm,		true);
+	FrontCamera		= CreateViewCamera(TEXT("FrontCamera"),		SpringArm,		false);
+	InteriorCamera	= CreateViewCamera(TEXT("InteriorCamera"),	AircraftMesh,	false);
+
+	FrontCamera		->SetRelativeLocationAndRotation(FVector(5000.0f, 0.0f, 0.0f), FRotator(0.0f, 180.0f, 0.0f));
+	InteriorCamera	->SetRelativeLocationAndRotation(FVector(40.0F, 50.0F, 20.0F), FRotator(0.0F, 0.0f, 0.0f));
+
+	Cache_InteriorCamera = false;
+}
+
+void AAircraft::DestroyLocalViewRig()
+{
+	for (UCameraComponent* ViewCamera : { BehindCamera, FrontCamera, InteriorCamera, TargetingAerialStrikeCamera })
+	{
+		if (ViewCamera)
+		{
+			ViewCamera->DestroyComponent();
+		}
+	}
+
+	if (SpringArm)
+	{
+		SpringArm->DestroyComponent();
+	}
+
+	SpringArm						= nullptr;
+	BehindCamera					= nullptr;
+	FrontCamera						= nullptr;
+	InteriorCamera					= nullptr;
+	TargetingAerialStrikeCamera		= nullptr;
+	Cache_InteriorCamera			= false;
+}
+
+UCameraComponent* AAircraft::CreateViewCamera(const TCHAR* CameraName, USceneComponent* AttachParent, bool bAutoActivate)
+{
+	UCameraComponent* ViewCamera = NewObject<UCameraComponent>(this, MakeUniqueObjectName(this, UCameraComponent::StaticClass(), CameraName), RF_Transient);
+	ViewCamera->SetupAttachment(AttachParent);
+	ViewCamera->SetAutoActivate(bAutoActivate);
+	ViewCamera->RegisterComponent();
+	return ViewCamera;
+}
 
 void AAircraft::PlayCameraShake(TSubclassOf<UCameraShakeBase> CameraShakeClass)
 {
 	APlayerCameraManager* PlayerCameraManager = Cast<APlayerCameraManager>(UGameplayStatics::GetPlayerCameraManager(GetWorld(), 0));
 
-	if (PlayerCameraManager)
+	if (PlayerCameraManager && CameraShakeClass)
 	{
 		PlayerCameraManager->StartCameraShake(CameraShakeClass, 1);
 	}
@@ -1171,60 +1426,324 @@ void AAircraft::PlayTakeOffCameraShake(TSubclassOf<UCameraShakeBase> CameraShake
 	}
 }
 
-void AAircraft::ReportPlayerToServer(FString PlayerName, FString ReportReason)
+#pragma region MovementValidation
+void AAircraft::FillMovementSample(FAircraftMovementSample& OutSample) const
 {
-	FString ReportedPlayerName	= PlayerName;
-	FString ReportedReason		= ReportReason;
+	OutSample.Location			= GetActorLocation();
+	OutSample.Rotation			= GetActorQuat();
+	OutSample.Throttle			= Hot.InputThrottle;
+	OutSample.Pitch				= Hot.InputPitch;
+	OutSample.Yaw				= Hot.InputYaw;
+	OutSample.Roll				= Hot.InputRoll;
+	OutSample.bBoostActivated	= Hot.bBoostActivated;
 }
 
+void AAircraft::GetFlightEnvelope(FAircraftFlightEnvelope& OutEnvelope) const
+{
+	/*Mirrors the flight integrator: thrust plus boost forward, gravity sinking on top of it*/
+	const float MaxForwardSpeed = FlightTuning.MaxThrustSpeed + FlightTuning.MaxBoostSpeed;
+	OutEnvelope.MaxSpeed = MaxForwardSpeed + FlightTuning.GravitationalForce;
+
+	/*Throttle and boost ramp up at ThrustMultiplier and BoostIncreaseRate, drag bleeds speed off at AirDragFactor*/
+	const float MaxSpeedGain = FlightTuning.ThrustMultiplier + FlightTuning.BoostIncreaseRate;
+	const float MaxSpeedLoss = MaxForwardSpeed * FlightTuning.AirDragFactor;
+	OutEnvelope.MaxAcceleration = FMath::Max(MaxSpeedGain, MaxSpeedLoss) + FlightTuning.GravitationalForce;
+
+	/*Full deflection on every axis at once, plus the slow-flight attitude correction*/
+	OutEnvelope.MaxTurnRateRadians = FlightTuning.PitchInputScale * FlightTuning.PitchControlSpeed + FlightTuning.YawControlSpeed + FlightTuning.RollControlSpeed + FlightTuning.TurnRateMargin;
+}
+
+void AAircraft::CorrectMovement(const FAircraftMovementSample& ValidSample)
+{
+	if (HasAuthority() == false) return;
+
+	SetActorLocationAndRotation(ValidSample.Location, ValidSample.Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+	Hot.Flight.CurrentSpeed = FMath::Min(Hot.Flight.CurrentSpeed, FlightTuning.MaxThrustSpeed + FlightTuning.MaxBoostSpeed);
+	ForceNetUpdate();
+}
+#pragma endregion
+
+#pragma region Sharding
+void AAircraft::SerializeHandoffState(FArchive& Ar)
+{
+	enum EHandoffFlags : uint8
+	{
+		EHF_EngineStarted		= 1 << 0,
+		EHF_PilotEntered		= 1 << 1,
+		EHF_BoostActivated		= 1 << 2,
+		EHF_UpdateThrusters		= 1 << 3,
+		EHF_TakenOff			= 1 << 4,
+		EHF_TakeOffDelayElapsed	= 1 << 5,
+		EHF_ShieldBroken		= 1 << 6
+	};
+
+	uint8 Flags = (Hot.bEngineStarted ? EHF_EngineStarted : 0)
+				| (Hot.bPlayerEnteredVehicle ? EHF_PilotEntered : 0)
+				| (Hot.bBoostActivated ? EHF_BoostActivated : 0)
+				| (Hot.bUpdateThrusters ? EHF_UpdateThrusters : 0)
+				| (Hot.bAircraftTakenOff ? EHF_TakenOff : 0)
+				| (Hot.bAircraftTakeOffDelayElapsed ? EHF_TakeOffDelayElapsed : 0)
+				| (bAircraftShieldBreak ? EHF_ShieldBroken : 0);
+	Ar << Flags;
+	Ar << Hot.Flight;
+
+	/*Pilot input at 8 bits per axis*/
+	int8 QuantizedInput[4] =
+	{
+		(int8)FMath::RoundToInt(Hot.InputThrottle * 127.0f),
+		(int8)FMath::RoundToInt(Hot.InputPitch * 127.0f),
+		(int8)FMath::RoundToInt(Hot.InputYaw * 127.0f),
+		(int8)FMath::RoundToInt(Hot.InputRoll * 127.0f)
+	};
+	for (int8& Input : QuantizedInput)
+	{
+		Ar << Input;
+	}
+
+	uint16 QuantizedHealth = FAircraftVitals::Quantize(Health, MaxHealth);
+	Ar << QuantizedHealth;
+
+	/*Resources travel as their current value and rate; the receiving shard rebases them on its own clock*/
+	UAircraftTimerWheelSubsystem* TimerWheel = UAircraftTimerWheelSubsystem::Get(this);
+	const double ResourceTime = GetResourceTime();
+	float ShieldValue = Shield.GetValue(ResourceTime);
+	float ShieldRate = Shield.GetRate();
+	float FuelValue = BoosterFuel.GetValue(ResourceTime);
+	float FuelRate = BoosterFuel.GetRate();
+	float ShieldRegenRemaining = TimerWheel && TimerWheel->IsTimerActive(ShieldRegenTimer) ? TimerWheel->GetTimeRemaining(ShieldRegenTimer) : -1.0f;
+	Ar << ShieldValue << ShieldRate << FuelValue << FuelRate << ShieldRegenRemaining;
+
+	if (Ar.IsLoading() == false || Ar.IsError()) return;
+
+	SetEnginesRunning((Flags & EHF_EngineStarted) != 0);
+	Hot.bPlayerEnteredVehicle			= (Flags & EHF_PilotEntered) != 0;
+	Hot.bBoostActivated					= (Flags & EHF_BoostActivated) != 0;
+	Hot.bUpdateThrusters				= (Flags & EHF_UpdateThrusters) != 0;
+	Hot.bAircraftTakenOff				= (Flags & EHF_TakenOff) != 0;
+	Hot.bAircraftTakeOffDelayElapsed	= (Flags & EHF_TakeOffDelayElapsed) != 0;
+	bAircraftShieldBreak				= (Flags & EHF_ShieldBroken) != 0;
+
+	SetPilotInput(QuantizedInput[0] / 127.0f, QuantizedInput[1] / 127.0f, QuantizedInput[2] / 127.0f, QuantizedInput[3] / 127.0f);
+
+	Health = FAircraftVitals::Dequantize(QuantizedHealth, MaxHealth);
+	UpdateReplicatedVitals();
+
+	Shield.SetValue(ResourceTime, ShieldValue, ShieldRate);
+	BoosterFuel.SetValue(ResourceTime, FuelValue, FuelRate);
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAircraft, Shield, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAircraft, BoosterFuel, this);
+	FlushReplicatedChange();
+
+	if (TimerWheel && ShieldRegenRemaining >= 0.0f)
+	{
+		ShieldRegenTimer = TimerWheel->SetTimer(ShieldRegenRemaining, FSimpleDelegate::CreateUObject(this, &AAircraft::StartShieldRegen));
+	}
+
+	UpdateActivityState();
+}
+
+UStaticMesh* AAircraft::GetAirframeMesh() const
+{
+	return AircraftMesh ? AircraftMesh->GetStaticMesh() : nullptr;
+}
+
+FVector AAircraft::GetFlightVelocity() const
+{
+	/*Same terms as the integrator's world offset*/
+	return GetActorForwardVector() * Hot.Flight.CurrentSpeed - FVector::UpVector * Hot.Flight.AppliedGravity;
+}
+#pragma endregion
+
 #pragma region DamageSystem
 void AAircraft::ReceiveDamage(AActor* DamagedActor, float Damage, const UDamageType* DamageType, AController* InstigatorController, AActor* DamageCauser)
 {
-	if (bAerodyneDestroyed || Health <= 0) return;
-	BaseGameMode = BaseGameMode == nullptr ? GetWorld()->GetAuthGameMode<ABaseGameMode>() : BaseGameMode;
+	SCOPE_CYCLE_COUNTER(STAT_AircraftReceiveDamage);
+	FAircraftHealthScope HealthScope(EAircraftHealthPhase::EAHP_Damage);
+	if (Hot.bAircraftDestroyed || Health <= 0.0f || Damage <= 0.0f) return;
+
+	PendingDamage.Add({ InstigatorController, Damage });
+	INC_DWORD_STAT(STAT_AircraftDamageHitsQueued);
 
-	if (BaseGameMode)
+	if (bDamageResolveScheduled == false)
 	{
-		Damage = BaseGameMode->CalculateDamage(InstigatorController, Controller, Damage);
+		bDamageResolveScheduled = true;
+		GetWorldTimerManager().SetTimerForNextTick(this, &AAircraft::ResolvePendingDamage);
 	}
-	else
+}
+
+void AAircraft::ResolvePendingDamage()
+{
+	/*Sums every hit queued since the last resolve, applies the game mode multiplier once per instigator and runs the shield-then-health logic a single time.*/
+	SCOPE_CYCLE_COUNTER(STAT_AircraftResolveDamage);
+	FAircraftHealthScope HealthScope(EAircraftHealthPhase::EAHP_Damage);
+	bDamageResolveScheduled = false;
+
+	if (Hot.bAircraftDestroyed || PendingDamage.Num() == 0)
+	{
+		PendingDamage.Reset();
+		return;
+	}
+
+	TArray<FPendingAircraftDamage, TInlineAllocator<4>> DamageByInstigator;
+	for (const FPendingAircraftDamage& Pending : PendingDamage)
+	{
+		FPendingAircraftDamage* Existing = DamageByInstigator.FindByPredicate([&Pending](const FPendingAircraftDamage& Entry)
+		{
+			return Entry.InstigatorController == Pending.InstigatorController;
+		});
+
+		if (Existing)
+		{
+			Existing->Damage += Pending.Damage;
+		}
+		else
+		{
+			DamageByInstigator.Add(Pending);
+		}
+	}
+	PendingDamage.Reset();
+
+	BaseGameMode = BaseGameMode == nullptr ? GetWorld()->GetAuthGameMode<ABaseGameMode>() : BaseGameMode;
+	if (BaseGameMode == nullptr)
 	{
-		LOG_WARNING("BaseGameMode is nullptr, in function name ReceiveDamage at Aerodyne.cpp")
+		LOG_WARNING("BaseGameMode is nullptr, in function name ResolvePendingDamage at Aircraft.cpp")
 	}
 
+	float TotalDamage = 0.0f;
+	for (const FPendingAircraftDamage& Entry : DamageByInstigator)
+	{
+		TotalDamage += BaseGameMode ? BaseGameMode->CalculateDamage(Entry.InstigatorController.Get(), Controller, Entry.Damage) : Entry.Damage;
+	}
+
+	INC_DWORD_STAT(STAT_AircraftDamageBatchesResolved);
+	ApplyResolvedDamage(TotalDamage);
+}
+
+void AAircraft::ApplyResolvedDamage(float Damage)
+{
 	float Zero = 0.0f;
 	float DamageToHealth = Damage;
-	if (Shield > Zero)
+	const double ResourceTime = GetResourceTime();
+	float CurrentShield = Shield.GetValue(ResourceTime);
+	if (CurrentShield > Zero)
 	{
-		if (Shield >= Damage)
+		if (CurrentShield >= Damage)
 		{
-			Shield = FMath::Clamp(Shield - Damage, Zero, MaxShield);
+			CurrentShield = FMath::Clamp(CurrentShield - Damage, Zero, Shield.GetMaxValue());
 			DamageToHealth = Zero;
 		}
 		else
 		{
-			DamageToHealth = FMath::Clamp(DamageToHealth - Shield, Zero, Damage);
-			Shield = Zero;
+			DamageToHealth = FMath::Clamp(DamageToHealth - CurrentShield, Zero, Damage);
+			CurrentShield = Zero;
 		}
-		bAeroShieldBreak = true;
+		bAircraftShieldBreak = true;
+	}
+
+	if (CurrentShield <= Zero && bAircraftShieldBreak)
+	{
+		bAircraftShieldBreak = false;
 	}
 
-	if (Shield <= Zero && bAeroShieldBreak)
+	/*Damage holds the shield where it is until ShieldRegenDelay passes without another hit*/
+	if (Shield.SetValue(ResourceTime, CurrentShield, Zero))
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(AAircraft, Shield, this);
+		FlushReplicatedChange();
+	}
+	if (UAircraftTimerWheelSubsystem* TimerWheel = UAircraftTimerWheelSubsystem::Get(this))
 	{
-		bAeroShieldBreak = false;
+		TimerWheel->ClearTimer(ShieldRegenTimer);
+		if (CurrentShield < Shield.GetMaxValue())
+		{
+			ShieldRegenTimer = TimerWheel->SetTimer(ShieldRegenDelay, FSimpleDelegate::CreateUObject(this, &AAircraft::StartShieldRegen));
+		}
 	}
 
 	Health = FMath::Clamp(Health - DamageToHealth, Zero, MaxHealth);
+	UpdateReplicatedVitals();
 
-	if (Health > Zero && Shield <= Zero)
+	if (Health > Zero && CurrentShield <= Zero && IsLocallyControlled())
 	{
-		PlayCameraShake(ReceiveDamageCameraShake);
+		PlayCameraShake(ReceiveDamageCameraShake.Get());
 	}
 	if (Health <= Zero)
 	{
 		VehicleDestruction();
 	}
 }
+
+void AAircraft::UpdateReplicatedVitals()
+{
+	FAircraftVitals NewVitals;
+	NewVitals.QuantizedHealth = FAircraftVitals::Quantize(Health, MaxHealth);
+	NewVitals.bShieldBroken = bAircraftShieldBreak;
+
+	if (NewVitals != Vitals)
+	{
+		Vitals = NewVitals;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AAircraft, Vitals, this);
+		FlushReplicatedChange();
+		INC_DWORD_STAT(STAT_AircraftVitalsUpdates);
+	}
+}
+
+void AAircraft::OnRep_Vitals()
+{
+	const float PreviousHealth = Health;
+
+	Health = FAircraftVitals::Dequantize(Vitals.QuantizedHealth, MaxHealth);
+	bAircraftShieldBreak = Vitals.bShieldBroken;
+	const float CurrentShield = GetShield();
+
+	if (Health < PreviousHealth && Health > 0.0f && CurrentShield <= 0.0f && IsLocallyControlled())
+	{
+		PlayCameraShake(ReceiveDamageCameraShake.Get());
+	}
+}
+
+double AAircraft::GetResourceTime() const
+{
+	const UWorld* World = GetWorld();
+	if (World == nullptr) return 0.0;
+
+	const AGameStateBase* GameState = World->GetGameState();
+	return GameState ? GameState->GetServerWorldTimeSeconds() : (double)World->GetTimeSeconds();
+}
+
+void AAircraft::StartShieldRegen()
+{
+	if (Hot.bAircraftDestroyed) return;
+
+	if (Shield.SetRate(GetResourceTime(), ShieldRegenRate))
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(AAircraft, Shield, this);
+		FlushReplicatedChange();
+	}
+}
+
+void AAircraft::SetBoosterFuelRate(float Rate)
+{
+	/*The owning client predicts the burn locally; the server's copy is the one that replicates*/
+	if (BoosterFuel.SetRate(GetResourceTime(), Rate) && HasAuthority())
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(AAircraft, BoosterFuel, this);
+		FlushReplicatedChange();
+	}
+
+	if (HasAuthority() == false && IsLocallyControlled())
+	{
+		Server_SetBoostActivated(Hot.bBoostActivated);
+	}
+}
+
+void AAircraft::Server_SetBoostActivated_Implementation(bool bActivated)
+{
+	/*Flight is simulated by the owner, so only the fuel check is repeated here*/
+	Hot.bBoostActivated = bActivated && GetBoosterFuel() > 0.0f;
+	SetBoosterFuelRate(Hot.bBoostActivated ? -BoosterFuelBurnRate : 0.0f);
+}
+
 void AAircraft::VehicleExplosionDamage()
 {
 	APawn* ActorItSelf = GetInstigator();
@@ -1236,75 +1755,287 @@ void AAircraft::VehicleExplosionDamage()
 		{
 			if (HasAuthority())
 			{
-				UGameplayStatics::ApplyRadialDamageWithFalloff
-				(
-					this,
-					ExplosionItselfDamage,
-					MinimumExplosiveDamage,
-					GetActorLocation(),
-					DamageInnerRadius,
-					DamageOuterRadius,
-					DamageFalloff,
-					UDamageType::StaticClass(),
-					TArray<AActor*>(),
-					this,
-					SelfController
-				);
+				FAircraftRadialDamageRequest Request;
+				Request.BaseDamage				= ExplosionItselfDamage;
+				Request.MinimumDamage			= MinimumExplosiveDamage;
+				Request.Origin					= GetActorLocation();
+				Request.InnerRadius				= DamageInnerRadius;
+				Request.OuterRadius				= DamageOuterRadius;
+				Request.Falloff					= DamageFalloff;
+				Request.DamageTypeClass			= UDamageType::StaticClass();
+				Request.DamageCauser			= this;
+				Request.InstigatorController	= SelfController;
+
+				UAircraftExplosionSubsystem::ApplyRadialDamage(this, Request);
 			}
 		}
 	}
 }
 
-void AAircraft::Multicast_EnableAndSimulateAerodynPhysics_Implementation()
+void AAircraft::Multicast_SetWreckedPresentation_Implementation(bool bWrecked)
 {
+	/*The wreck proxy takes over the visuals, so the aircraft itself only needs hiding and its collision switching off*/
+	SetActorHiddenInGame(bWrecked);
+
 	if (AreaCollision)
 	{
-		AreaCollision->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		AreaCollision->SetCollisionEnabled(bWrecked ? ECollisionEnabled::NoCollision : ECollisionEnabled::QueryOnly);
 	}
 
 	if (AircraftMesh)
 	{
-		AircraftMesh->SetCollisionEnabled(ECollisionEnabled::PhysicsOnly);
-		AircraftMesh->SetSimulatePhysics(true);
-		AircraftMesh->SetEnableGravity(true);
-		AircraftMesh->SetSimulatePhysics(false);
-		AircraftMesh->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Block);
+		AircraftMesh->SetCollisionEnabled(bWrecked ? ECollisionEnabled::NoCollision : ECollisionEnabled::QueryAndPhysics);
+	}
+
+	if (bWrecked)
+	{
+		PlayDestructionFX();
 	}
 }
 
-void AAircraft::VehicleDestruction()
+void AAircraft::PlayDestructionFX()
 {
-	VehicleExplosionDamage();
-	
-	if (ExplosionParticle)
+	if (IsNetMode(NM_DedicatedServer)) return;
+
+	if (UNiagaraSystem* LoadedExplosionFX = ExplosionFX.Get())
 	{
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ExplosionParticle, GetActorTransform());
+		UNiagaraFunctionLibrary::SpawnSystemAtLocation
+		(
+			this,
+			LoadedExplosionFX,
+			GetActorLocation(),
+			GetActorRotation(),
+			FVector(1.0f),
+			true,
+			true,
+			ENCPoolMethod::AutoRelease,
+			true
+		);
+	}
+	else if (UParticleSystem* LoadedExplosionParticle = ExplosionParticle.Get())
+	{
+		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), LoadedExplosionParticle, GetActorTransform());
 	}
 
-	if (ExplosionSound)
+	if (USoundCue* LoadedExplosionSound = ExplosionSound.Get())
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, ExplosionSound, GetActorLocation());
+		UGameplayStatics::PlaySoundAtLocation(this, LoadedExplosionSound, GetActorLocation());
+	}
+}
+
+void AAircraft::VehicleDestruction()
+{
+	Hot.bAircraftDestroyed = true;
+	UpdateActivityState();
+
+	VehicleExplosionDamage();
+
+	Multicast_SetWreckedPresentation(true);
+
+	if (UAircraftPoolSubsystem* PoolSubsystem = GetWorld()->GetSubsystem<UAircraftPoolSubsystem>())
+	{
+		const FTransform WreckTransform = AircraftMesh ? AircraftMesh->GetComponentTransform() : GetActorTransform();
+		UStaticMesh* WreckStaticMesh = AircraftMesh ? AircraftMesh->GetStaticMesh() : nullptr;
+
+		PoolSubsystem->AcquireWreck(WreckStaticMesh, WreckTransform, GetActorForwardVector() * Hot.Flight.CurrentSpeed, DestroyTime);
 	}
 
-	Multicast_EnableAndSimulateAerodynPhysics();
-	
 	StartDestroyTimer();
 }
 
 
 void AAircraft::StartDestroyTimer()
 {
-	GetWorldTimerManager().SetTimer
-	(
-		DestroyTimer,
-		this,
-		&AAircraft::DestroyTimerFinished,
-		DestroyTime
-	);
+	if (UAircraftTimerWheelSubsystem* TimerWheel = UAircraftTimerWheelSubsystem::Get(this))
+	{
+		TimerWheel->ClearTimer(DestroyTimer);
+		DestroyTimer = TimerWheel->SetTimer(DestroyTime, FSimpleDelegate::CreateUObject(this, &AAircraft::DestroyTimerFinished));
+	}
 }
 void AAircraft::DestroyTimerFinished()
 {
-	Destroy();
+	if (UAircraftPoolSubsystem* PoolSubsystem = GetWorld()->GetSubsystem<UAircraftPoolSubsystem>())
+	{
+		PoolSubsystem->ReleaseAircraft(this);
+	}
+	else
+	{
+		Destroy();
+	}
+}
+
+#pragma region Pooling
+void AAircraft::DeactivateForPool()
+{
+	if (Controller)
+	{
+		Controller->UnPossess();
+	}
+
+	if (UAircraftTimerWheelSubsystem* TimerWheel = UAircraftTimerWheelSubsystem::Get(this))
+	{
+		TimerWheel->ClearTimer(DestroyTimer);
+		TimerWheel->ClearTimer(AircraftTakeOffTimer);
+		TimerWheel->ClearTimer(ShieldRegenTimer);
+	}
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+
+	/*Dropped so the reuse teleport is not judged against this life's samples; ResetForReuse registers again*/
+	if (UAircraftMovementValidator* MovementValidator = GetWorld()->GetSubsystem<UAircraftMovementValidator>())
+	{
+		MovementValidator->UnregisterAircraft(this);
+	}
+
+	Hot.bPlayerEnteredVehicle = false;
+	Hot.bInPool = true;
+	UpdateActivityState();
+}
+
+void AAircraft::ResetForReuse(const FTransform& SpawnTransform)
+{
+	/*Restores everything a freshly spawned aircraft would have, without reconstructing its components*/
+
+	Hot.bInPool = false;
+	Hot.bAircraftDestroyed = false;
+	bAircraftShieldBreak = false;
+
+	Health = MaxHealth;
+	const double ResourceTime = GetResourceTime();
+	Shield.SetValue(ResourceTime, Shield.GetMaxValue());
+	BoosterFuel.SetValue(ResourceTime, BoosterFuel.GetMaxValue());
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAircraft, Shield, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAircraft, BoosterFuel, this);
+	PendingDamage.Reset();
+	UpdateReplicatedVitals();
+
+	Hot.bEngineStarted = false;
+	Hot.bPlayerEnteredVehicle = false;
+	Hot.bBoostActivated = false;
+	Hot.bAircraftTakenOff = false;
+	if (UAircraftTimerWheelSubsystem* TimerWheel = UAircraftTimerWheelSubsystem::Get(this))
+	{
+		TimerWheel->ClearTimer(AircraftTakeOffTimer);
+	}
+	Hot.bAircraftTakeOffDelayElapsed = false;
+
+	Hot.InputThrottle = Hot.InputPitch = Hot.InputYaw = Hot.InputRoll = 0.0f;
+	if (InputPipeline.IsValid())
+	{
+		InputPipeline->Reset();
+	}
+
+	Hot.Flight = FAircraftFlightState();
+	Hot.Flight.ThrustSpeed = FlightTuning.MinThrustSpeedThreshold;
+	Hot.Flight.GravitationalForce = FlightTuning.GravitationalForce;
+
+	for (UNiagaraComponent* ThrusterComponent : { MiddleFrontThrusterFXs, RightFrontThrusterFXs, LeftFrontThrusterFXs })
+	{
+		if (ThrusterComponent)
+		{
+			ThrusterComponent->Deactivate();
+		}
+	}
+	Hot.bUpdateThrusters = false;
+
+	if (AudioState.IsValid())
+	{
+		AudioState->bRadioStarted = false;
+	}
+	if (RadioAudioComponent)
+	{
+		RadioAudioComponent->Stop();
+	}
+	Cache_InteriorCamera = false;
+
+	/*A pooled aircraft is DORM_DormantAll; wake it so clients receive the teleport and the multicast below,
+	  UpdateActivityState puts it back to dormancy if it is still parked*/
+	if (HasAuthority() && NetDormancy > DORM_Awake)
+	{
+		SetNetDormancy(DORM_Awake);
+	}
+
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorEnableCollision(true);
+
+	if (UAircraftMovementValidator* MovementValidator = GetWorld()->GetSubsystem<UAircraftMovementValidator>())
+	{
+		MovementValidator->RegisterAircraft(this);
+	}
+
+	Multicast_SetWreckedPresentation(false);
+
+	SetAircraftEngineTypes(EAircraftEngineTypes::EACET_InitialEngine);
+	UpdateActivityState();
+}
+#pragma endregion
+
+#pragma endregion
+
+#pragma region Memory
+void AAircraft::GetMemoryFootprint(FMemoryFootprint& OutFootprint) const
+{
+	const UPTRINT HotStart = (UPTRINT)&Hot;
+	const UPTRINT HotEnd = HotStart + sizeof(FAircraftHotState) - 1;
+
+	OutFootprint.ObjectBytes			= GetClass()->GetStructureSize();
+	OutFootprint.HotBytes				= sizeof(FAircraftHotState);
+	OutFootprint.HotCacheLines			= (int32)(HotEnd / PLATFORM_CACHE_LINE_SIZE - HotStart / PLATFORM_CACHE_LINE_SIZE + 1);
+	OutFootprint.AudioStateBytes		= AudioState.IsValid() ? sizeof(FAircraftAudioState) : 0;
+	OutFootprint.InputPipelineBytes		= InputPipeline.IsValid() ? sizeof(FAircraftInputPipeline) : 0;
+	OutFootprint.PendingDamageBytes		= (int32)PendingDamage.GetAllocatedSize();
 }
+#pragma endregion
+
+#pragma region ConsoleCommands
+static FAutoConsoleCommandWithWorldAndArgs GAircraftMemoryReportCommand
+(
+	TEXT("Aircraft.Memory.Report"),
+	TEXT("Logs the bytes each live aircraft class costs per instance: the actor object, its hot per-frame block and how many cache lines that spans, and the out-of-line cold storage. Aircraft.Benchmark.HotState measures the effect on flight step time. Usage: Aircraft.Memory.Report"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (World == nullptr) return;
+
+		struct FClassFootprint
+		{
+			int32 Count = 0;
+			int32 NumWithAudio = 0;
+			int32 NumWithPipeline = 0;
+			int32 MaxHotCacheLines = 0;
+			int64 ColdBytes = 0;
+			int64 TotalBytes = 0;
+			AAircraft::FMemoryFootprint Last;
+		};
+
+		TMap<UClass*, FClassFootprint> Footprints;
+		for (TActorIterator<AAircraft> It(World); It; ++It)
+		{
+			FClassFootprint& ClassFootprint = Footprints.FindOrAdd(It->GetClass());
+			It->GetMemoryFootprint(ClassFootprint.Last);
+
+			const AAircraft::FMemoryFootprint& Footprint = ClassFootprint.Last;
+			++ClassFootprint.Count;
+			ClassFootprint.NumWithAudio += Footprint.AudioStateBytes > 0 ? 1 : 0;
+			ClassFootprint.NumWithPipeline += Footprint.InputPipelineBytes > 0 ? 1 : 0;
+			ClassFootprint.MaxHotCacheLines = FMath::Max(ClassFootprint.MaxHotCacheLines, Footprint.HotCacheLines);
+			ClassFootprint.ColdBytes += Footprint.GetTotalBytes() - Footprint.ObjectBytes;
+			ClassFootprint.TotalBytes += Footprint.GetTotalBytes();
+		}
+
+		int64 TotalBytes = 0;
+		int32 TotalCount = 0;
+		for (const TPair<UClass*, FClassFootprint>& Pair : Footprints)
+		{
+			const FClassFootprint& ClassFootprint = Pair.Value;
+			UE_LOG(LogTemp, Log, TEXT("Aircraft.Memory %s: %d aircraft, object %d bytes, hot block %d bytes in %d cache line(s), cold storage %lld bytes (audio on %d, input pipeline on %d), %.0f bytes per aircraft"),
+				*Pair.Key->GetName(), ClassFootprint.Count, ClassFootprint.Last.ObjectBytes, ClassFootprint.Last.HotBytes, ClassFootprint.MaxHotCacheLines,
+				ClassFootprint.ColdBytes, ClassFootprint.NumWithAudio, ClassFootprint.NumWithPipeline, (double)ClassFootprint.TotalBytes / ClassFootprint.Count);
+
+			TotalBytes += ClassFootprint.TotalBytes;
+			TotalCount += ClassFootprint.Count;
+		}
 
+		UE_LOG(LogTemp, Log, TEXT("Aircraft.Memory: %d aircraft, %.1f KB in total"), TotalCount, TotalBytes / 1024.0);
+	})
+);
 #pragma endregion
@@ -13,6 +13,11 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
 #include "InputActionValue.h"
+#include "AircraftFlightProfile.h"
+#include "AircraftInputPipeline.h"
+#include "AircraftLinearResource.h"
+#include "AircraftTimerWheel.h"
+#include "AircraftWorkScheduler.h"
 
 #include "Aircraft.generated.h"
 
@@ -27,6 +32,7 @@ class AController;
 class UAudioComponent;
 class UArrowComponent;
 class UCameraComponent;
+class UStaticMesh;
 class UStaticMeshComponent;
 class USpringArmComponent;
 class UBoxComponent;
@@ -36,6 +42,10 @@ class UNiagaraSystem;
 
 class UInputMappingContext;
 class UInputAction;
+
+struct FAircraftMovementSample;
+struct FAircraftFlightEnvelope;
+class FAircraftTelemetryWriter;
 #pragma endregion
 
 UENUM(BlueprintType)
@@ -49,6 +59,96 @@ enum class EAircraftEngineTypes : uint8
 	EACET_MAX UMETA(DisplayName = "DefaultMAX")
 };
 
+/**
+ * Drives which parts of the aircraft tick. Parked aircraft cost no game-thread ticks at all.
+ */
+UENUM(BlueprintType)
+enum class EAircraftActivityState : uint8
+{
+	EAAS_Parked UMETA(DisplayName = "Parked"),
+	EAAS_EngineIdle UMETA(DisplayName = "EngineIdle"),
+	EAAS_Occupied UMETA(DisplayName = "Occupied"),
+	EAAS_Flying UMETA(DisplayName = "Flying"),
+	EAAS_Destroyed UMETA(DisplayName = "Destroyed"),
+
+	EAAS_MAX UMETA(DisplayName = "DefaultMAX")
+};
+
+/**
+ * Health replicated as a 16-bit fraction of its maximum plus the shield-break flag, so a vitals update costs 3 bytes.
+ * The shield regenerates continuously and is replicated separately as an FAircraftLinearResource; the flag travels
+ * here so clients take the server's value instead of guessing it from the shield.
+ */
+USTRUCT()
+struct FAircraftVitals
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	uint16 QuantizedHealth = MAX_uint16;
+
+	UPROPERTY()
+	bool bShieldBroken = false;
+
+	bool operator==(const FAircraftVitals& Other) const { return QuantizedHealth == Other.QuantizedHealth && bShieldBroken == Other.bShieldBroken; }
+	bool operator!=(const FAircraftVitals& Other) const { return !(*this == Other); }
+
+	static uint16 Quantize(float Value, float MaxValue)
+	{
+		return MaxValue > 0.0f ? (uint16)FMath::RoundToInt(FMath::Clamp(Value / MaxValue, 0.0f, 1.0f) * MAX_uint16) : 0;
+	}
+
+	static float Dequantize(uint16 Value, float MaxValue)
+	{
+		return (float)Value / MAX_uint16 * MaxValue;
+	}
+};
+
+/**
+ * Everything a flying aircraft reads and writes every frame, kept together and aligned to a cache line so a tick
+ * touches exactly one line of it instead of fields spread across the actor. Gameplay flags are single bits.
+ */
+struct alignas(PLATFORM_CACHE_LINE_SIZE) FAircraftHotState
+{
+	FAircraftFlightState Flight;
+
+	/*What the flight step reads: the input pipeline's output for a local pilot, set directly by bots and handoffs*/
+	float InputThrottle = 0.0f;
+	float InputPitch = 0.0f;
+	float InputYaw = 0.0f;
+	float InputRoll = 0.0f;
+
+	/*Specialised step of the built-in profile; null for designer-tuned profiles, which use the generic step*/
+	FAircraftFlightIntegrator::FStepFunction StepFunction = nullptr;
+
+	EAircraftActivityState ActivityState = EAircraftActivityState::EAAS_Parked;
+
+	uint8 bEngineStarted : 1;
+	uint8 bPlayerEnteredVehicle : 1;
+	uint8 bBoostActivated : 1;
+	uint8 bUpdateThrusters : 1;
+	uint8 bAircraftTakenOff : 1;
+	uint8 bAircraftTakeOffDelayElapsed : 1;
+	uint8 bAircraftDestroyed : 1;
+
+	/*Set while the aircraft sits in UAircraftPoolSubsystem waiting to be reused*/
+	uint8 bInPool : 1;
+
+	FAircraftHotState()
+		: bEngineStarted(false)
+		, bPlayerEnteredVehicle(false)
+		, bBoostActivated(false)
+		, bUpdateThrusters(false)
+		, bAircraftTakenOff(false)
+		, bAircraftTakeOffDelayElapsed(false)
+		, bAircraftDestroyed(false)
+		, bInPool(false)
+	{
+	}
+};
+
+static_assert(sizeof(FAircraftHotState) == PLATFORM_CACHE_LINE_SIZE, "FAircraftHotState should fill exactly one cache line");
+
 UCLASS()
 class AIRCRAFT_API AAircraft : public APawn
 {
@@ -60,11 +160,14 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
 	virtual void GetLifetimeReplicatedProps(TArray< FLifetimeProperty >& OutLifetimeProps) const override;
 
+private:
+	void WriteTelemetryRecord(FAircraftTelemetryWriter& TelemetryWriter) const;
 #pragma endregion
 
 #pragma region OtherClasses
@@ -84,7 +187,7 @@ private:
 
 public:
 	EAircraftEngineTypes GetAircraftEngineTypes() const { return AircraftEngineTypes; }
-	void SetAircraftEngineTypes(EAircraftEngineTypes Type) { AircraftEngineTypes = Type; }
+	void SetAircraftEngineTypes(EAircraftEngineTypes Type);
 
 	void CheckAircraftEngineTypes();
 #pragma endregion
@@ -138,11 +241,12 @@ protected:
 	UPROPERTY(EditAnywhere) UStaticMeshComponent* ElevatorLeft;
 	UPROPERTY(EditAnywhere) UStaticMeshComponent* ElevatorRight;
 	
-	UPROPERTY(VisibleAnywhere) USpringArmComponent*  SpringArm;
-	UPROPERTY(VisibleAnywhere) UCameraComponent* BehindCamera;
-	UPROPERTY(VisibleAnywhere) UCameraComponent* FrontCamera;
-	UPROPERTY(VisibleAnywhere) UCameraComponent* InteriorCamera;
-	UPROPERTY(VisibleAnywhere) UCameraComponent* TargetingAerialStrikeCamera;
+	/*Local view rig, created only while a local player pilots the aircraft; null on the server and on remote copies*/
+	UPROPERTY(Transient, VisibleInstanceOnly) USpringArmComponent*  SpringArm = nullptr;
+	UPROPERTY(Transient, VisibleInstanceOnly) UCameraComponent* BehindCamera = nullptr;
+	UPROPERTY(Transient, VisibleInstanceOnly) UCameraComponent* FrontCamera = nullptr;
+	UPROPERTY(Transient, VisibleInstanceOnly) UCameraComponent* InteriorCamera = nullptr;
+	UPROPERTY(Transient, VisibleInstanceOnly) UCameraComponent* TargetingAerialStrikeCamera = nullptr;
 
 
 private:
@@ -186,83 +290,104 @@ private:
 	void InputAction_Radio (const FInputActionValue& Value);
 	void InputAction_ExitVehicle (const FInputActionValue& Value);
 
-// StoredVariables
-	float StoredInputThrottle;
-	float StoredInputPitch;
-	float StoredInputYaw;
-	float StoredInputRoll;
+/*Analog pipeline*/
+	/*Kept out of line with its frame history; only created once a local pilot touches the controls*/
+	TUniquePtr<FAircraftInputPipeline> InputPipeline;
 
-/*Functions*/
-	void AutoTakeOff (float DeltaTime);
-	void UpdatePosition (float DeltaTime);
-
-	void UpdateAxisByInputValues (float ThrottleValue, float PitchValue, float YawValue, float RollValue);
-	void ThrottleUpdate (float InputThrottleValue);
-	void PitchUpdate (float InputPitchValue);
-	void YawUpdate (float InputYawValue);
-	void RollUpdate (float InputRollValue);
+	UPROPERTY(EditAnywhere, Category = InputSettings)
+	FAircraftAxisResponse ThrottleResponse;
+	UPROPERTY(EditAnywhere, Category = InputSettings)
+	FAircraftAxisResponse PitchResponse;
+	UPROPERTY(EditAnywhere, Category = InputSettings)
+	FAircraftAxisResponse YawResponse;
+	UPROPERTY(EditAnywhere, Category = InputSettings)
+	FAircraftAxisResponse RollResponse;
 
-	void CalculateGravity (float DeltaSeconds, float AppliedGravityInput);
-	float OutGravity;
+	/*Runs the pipeline for this frame and hands its output to the flight step*/
+	void SamplePilotInput(float DeltaTime);
 
-/*Booleans*/
-private:
-	bool bEngineStarted = false;
-	bool bPlayerEnteredVehicle = false;
-	bool bBoostActivated = false;
-	bool bUpdateThrusters = false;
-	bool bAircraftTakenOff = false;
+/*Functions*/
+	void AutoTakeOff (float DeltaTime);
 
+	/*Runs one flight integrator step and applies its offset and rotations to the actor*/
+	void IntegrateFlight (float DeltaTime, bool bTakingOff);
 
 /*AircraftTakeOff*/
-	float AircraftTakeOffTimer;
+private:
+	FAircraftTimerHandle AircraftTakeOffTimer;
 	UPROPERTY(EditAnywhere)
 	float AircraftTakeOffDelay = 2.0f;
 /*Getter and Setters*/
 public:
-	bool GetPlayerEnteredVehicle() const { return bPlayerEnteredVehicle; }
-	bool IsEngineStarted() const { return bEngineStarted; }
-	bool IsAircraftBoostActivated() const { return bBoostActivated; }
+	bool GetPlayerEnteredVehicle() const { return Hot.bPlayerEnteredVehicle; }
+	bool IsEngineStarted() const { return Hot.bEngineStarted; }
+	bool IsAircraftBoostActivated() const { return Hot.bBoostActivated; }
+
+	void SetPlayerEnteredVehicle(bool bPlayerEnter);
+	void StartEngines(bool bStart);
+
+/*Pilot entry points shared by the input bindings and AAircraftBotController*/
+	void SetPilotInput(float Throttle, float Pitch, float Yaw, float Roll);
+	FAircraftInputPipeline& GetInputPipeline();
+	void SetBoosterActive(bool bActive);
+	void SetEnginesRunning(bool bRunning);
+#pragma endregion
+
+#pragma region AssetPreload
+public:
+	/**
+	 * Collects the soft-referenced assets this aircraft class needs before it is spawned.
+	 * Cosmetic assets (FX, sounds, camera shakes) are skipped on dedicated servers.
+	 */
+	virtual void GatherPreloadAssets(TArray<FSoftObjectPath>& OutAssets, bool bIncludeCosmetics) const;
 
-	void SetPlayerEnteredVehicle(bool bPlayerEnter) { bPlayerEnteredVehicle = bPlayerEnter; }
-	void StartEngines(bool bStart) { bEngineStarted = bStart; }
+protected:
+	/*Runs once this class's preload bundle has streamed in; restores the effects an engine started without*/
+	virtual void OnAircraftAssetsReady();
+#pragma endregion
+
+#pragma region Activity
+private:
+	EAircraftActivityState EvaluateActivityState() const;
+	void ApplyActivityState();
+
+	/*Thruster FX and engine sound parameters only need refreshing a few dozen times a second; UAircraftWorkScheduler runs them while flying*/
+	FAircraftWorkHandle ThrusterWork;
+	FAircraftWorkHandle EngineSoundWork;
+	void RegisterScheduledWork();
+
+protected:
+	/*Called on every transition so derived aircraft can toggle their own components*/
+	virtual void OnActivityStateChanged(EAircraftActivityState PreviousState);
+
+public:
+	void UpdateActivityState();
+	EAircraftActivityState GetActivityState() const { return Hot.ActivityState; }
+
+	/*Total aircraft ticks since startup, used by the parked-aircraft benchmark*/
+	static uint64 GetTotalTickCount();
 #pragma endregion
 
 #pragma region Movement-Probs
 protected:
 /*Dynamics*/
-	float ThrustSpeed;
-	float CurrentSpeed;
-	float AppliedGravity;
-	float BoostSpeed;
-
-/*Rotation*/
-	float TargetYaw;
-	float CurrentYaw;
-	float TargetPitch;
-	float CurrentPitch;
-	float TargetRoll;
-	float CurrentRoll;
+	/*Flight state, pilot input, activity and gameplay flags: the per-frame working set*/
+	FAircraftHotState Hot;
 
 protected:
 /*Editables*/
-	UPROPERTY(EditAnywhere)
-	float MaxThrustSpeed = 4000.0f;
+	/*Built-in profiles are integrated by a step specialised for their constants*/
+	UPROPERTY(EditAnywhere, Category = "Flight")
+	EAircraftFlightProfile FlightProfile = EAircraftFlightProfile::EAFP_Fighter;
 
-	UPROPERTY(EditAnywhere)
-	float MinThrustSpeedThreshold = 1000.0f;
+	/*Designer-tuned variant; when set it replaces FlightProfile and is integrated by the generic step*/
+	UPROPERTY(EditAnywhere, Category = "Flight")
+	UAircraftFlightProfileAsset* FlightProfileAsset = nullptr;
 
-	UPROPERTY(EditAnywhere)
-	float ThrustMultiplier = 1000.0f;
+	/*Resolved from the profile or asset, for everything that only reads the limits*/
+	FAircraftFlightTuning FlightTuning;
 
-	UPROPERTY(EditAnywhere)
-	float MaxBoostSpeed = 1500.0f;
-
-	UPROPERTY(EditAnywhere)
-	float GravitationalForce = 2000.0f;
-
-	UPROPERTY(EditAnywhere)
-	float AirDragFactor = 0.5f;
+	void ResolveFlightProfile();
 
 /*ControlSurfaces*/
 	UPROPERTY(EditAnywhere)
@@ -276,58 +401,55 @@ protected:
 
 	UPROPERTY(EditAnywhere)
 	float MaxAileronPitch = 45.0f;
-
-/*AxisControllerValues*/
-	UPROPERTY(EditAnywhere)
-	float AircraftPitchControlSpeed = 0.25f;
-	UPROPERTY(EditAnywhere)
-	float AircraftYawControlSpeed = 0.50f;
-	UPROPERTY(EditAnywhere)
-	float AircraftRollControlSpeed = 1.50f;
-#pragma endregion
-
-#pragma region Adjustable Properties
-private:
-UPROPERTY(EditAnywhere)
-float AxisInterpolationSpeed = 1.0f;
-
 #pragma endregion
 
 #pragma region Camera
 private:
 UPROPERTY(EditAnywhere, Category = "DeveloperProperties")
-TSubclassOf<UCameraShakeBase> TakeOffCameraShake;
+TSoftClassPtr<UCameraShakeBase> TakeOffCameraShake;
 
 UPROPERTY(EditAnywhere, Category = "DeveloperProperties")
-TSubclassOf<UCameraShakeBase> ReceiveDamageCameraShake;
+TSoftClassPtr<UCameraShakeBase> ReceiveDamageCameraShake;
 
 void PlayCameraShake(TSubclassOf<UCameraShakeBase> CameraShakeClass);
 void PlayTakeOffCameraShake(TSubclassOf<UCameraShakeBase> CameraShake);
 
 protected:
-	bool Cache_InteriorCamera = false;
-	bool bCameraSwitchedWhileTargetingCameraOn = false;
+	uint8 Cache_InteriorCamera : 1;
+	uint8 bCameraSwitchedWhileTargetingCameraOn : 1;
+
+	virtual void PawnClientRestart() override;
+	virtual void UnPossessed() override;
+
+	/*Builds the spring arm and cameras for the local pilot; subclasses add their own view cameras*/
+	virtual void CreateLocalViewRig();
+	virtual void DestroyLocalViewRig();
+
+	UCameraComponent* CreateViewCamera(const TCHAR* CameraName, USceneComponent* AttachParent, bool bAutoActivate);
+
+public:
+	FORCEINLINE bool HasLocalViewRig() const { return SpringArm != nullptr; }
 #pragma endregion
 
 #pragma region FXs
 protected:
 	UPROPERTY(EditAnywhere)
-	bool bMiddleEngineType = false;
+	uint8 bMiddleEngineType : 1;
 
 	UPROPERTY(EditAnywhere)
-	bool bRightEngineType = false;
+	uint8 bRightEngineType : 1;
 
 	UPROPERTY(EditAnywhere)
-	bool bLeftEngineType = false;
+	uint8 bLeftEngineType : 1;
 
 	UPROPERTY(EditAnywhere)
-	bool bRightSecondEngineType = false;
+	uint8 bRightSecondEngineType : 1;
 
 	UPROPERTY(EditAnywhere)
-	bool bLeftSecondEngineType = false;
+	uint8 bLeftSecondEngineType : 1;
 
 	UPROPERTY(EditAnywhere)
-	UNiagaraSystem* ThrusterFX;
+	TSoftObjectPtr<UNiagaraSystem> ThrusterFX;
 
 	UPROPERTY()
 	UNiagaraComponent* MiddleThrusterFXs;
@@ -353,39 +475,48 @@ protected:
 
 #pragma region Sounds
 /*JetEngine*/
-	UAudioComponent* JetEngineAudioComponent		 = nullptr;
-	UAudioComponent* JetEngineInteriorAudioComponent = nullptr;
-	UAudioComponent* AxisSoundEffectAudioComponent	 = nullptr;
+	/*Run-time sound state, allocated the first time this aircraft plays engine or radio sound; dedicated servers never do*/
+	struct FAircraftAudioState
+	{
+		UAudioComponent* JetEngineAudioComponent		 = nullptr;
+		UAudioComponent* JetEngineInteriorAudioComponent = nullptr;
+		UAudioComponent* AxisSoundEffectAudioComponent	 = nullptr;
+
+		float EngineVolume				= 0.1f;
+		float EngineVolumePitch			= 0.5f;
+		float EngineInteriorVolumePitch	= 0.0f;
+
+		uint8 bInteriorEngineSound : 1;
+		uint8 bAxisSound : 1;
+		uint8 bRadioStarted : 1;
+
+		FAircraftAudioState()
+			: bInteriorEngineSound(false)
+			, bAxisSound(false)
+			, bRadioStarted(false)
+		{
+		}
+	};
+
+	TUniquePtr<FAircraftAudioState> AudioState;
+	FAircraftAudioState& GetAudioState();
 
 	/*FlightSystems Probs*/
 	UPROPERTY(EditAnywhere)
-	USoundCue* JetEngineSound;
+	TSoftObjectPtr<USoundCue> JetEngineSound;
 
 	UPROPERTY(EditAnywhere)
-	USoundCue* JetEngineInteriorSound;
+	TSoftObjectPtr<USoundCue> JetEngineInteriorSound;
 
 	UPROPERTY(EditAnywhere)
-	USoundCue* AxisEffectSound;
-
-	float EngineVolume		= 0.1f;
-	float EngineVolumePitch = 0.5f;
-	float EngineInteriorVolumePitch;
-	float InteriorEngineVolume;
-	float InteriorVolumePitch;
-
-	bool bInteriorEngineSound;
-	bool bEngineSound;
-	bool bAxisSound = false;
-
+	TSoftObjectPtr<USoundCue> AxisEffectSound;
 
 	void Play_AerodynamicSounds();
 	void Local_OutsideJetSound(USoundCue* OutsideSound);
 
 /*Radio*/
-	bool bRadioStarted = false;
-
 	UPROPERTY(EditAnywhere)
-	USoundCue* RadioPlaylist;
+	TSoftObjectPtr<USoundCue> RadioPlaylist;
 
 	UPROPERTY()
 	UAudioComponent* RadioAudioComponent;
@@ -404,33 +535,139 @@ private:
 	UPROPERTY(EditAnywhere, Category = "ReplicationSound")
 	USoundAttenuation* OutsideJetSoundLoopingSoundAttenuation;
 
+/*Dormancy*/
+	/*Parked aircraft (no pilot, engine off) go dormant and are woken on boarding, engine start, damage or destruction*/
+	UPROPERTY(EditAnywhere, Category = "Replication")
+	uint8 bAutomaticNetDormancy : 1;
+
+	bool IsParked() const;
+	void UpdateNetDormancy();
+
+	/*Call after every push-model mark on the server*/
+	void FlushReplicatedChange();
+
+protected:
+	virtual void PostNetReceiveLocationAndRotation() override;
+#pragma endregion
+
+#pragma region MovementValidation
+public:
+	/*Used by UAircraftMovementValidator on the server to sample and bound this aircraft's movement*/
+	void FillMovementSample(FAircraftMovementSample& OutSample) const;
+	void GetFlightEnvelope(FAircraftFlightEnvelope& OutEnvelope) const;
+
+	/*Puts the aircraft back at a sample the validator accepted and caps its speed to the flight model*/
+	void CorrectMovement(const FAircraftMovementSample& ValidSample);
 #pragma endregion
 
-#pragma region ReportSystems
-private:
-	void ReportPlayerToServer(FString PlayerName, FString ReportReason);
+#pragma region Sharding
+public:
+	/**
+	 * Writes or reads what another airspace shard needs to carry on simulating this aircraft: engine and flight
+	 * state, pilot input, health, shield and booster fuel. Class, transform and controller travel separately in
+	 * UAircraftShardSubsystem's handoff message. Loading expects an aircraft freshly reset from the pool.
+	 */
+	virtual void SerializeHandoffState(FArchive& Ar);
+
+	/*The airframe mesh and the velocity the ghost proxies of this aircraft on neighbouring shards are drawn and extrapolated with*/
+	UStaticMesh* GetAirframeMesh() const;
+	FVector GetFlightVelocity() const;
+#pragma endregion
+
+#pragma region Memory
+public:
+	/*Where one aircraft's bytes go, for Aircraft.Memory.Report*/
+	struct FMemoryFootprint
+	{
+		/*The actor object itself, including every inline member*/
+		int32 ObjectBytes = 0;
+
+		int32 HotBytes = 0;
+		int32 HotCacheLines = 0;
+
+		/*Out-of-line cold storage; zero until allocated*/
+		int32 AudioStateBytes = 0;
+		int32 InputPipelineBytes = 0;
+		int32 PendingDamageBytes = 0;
+
+		int32 GetTotalBytes() const { return ObjectBytes + AudioStateBytes + InputPipelineBytes + PendingDamageBytes; }
+	};
+
+	void GetMemoryFootprint(FMemoryFootprint& OutFootprint) const;
 #pragma endregion
 
 #pragma region Attributes - Stats
 private:
-	bool bAircraftDestroyed = false;
-	bool bAircraftShieldBreak = false;
+	uint8 bAircraftShieldBreak : 1;
 
 	float Health = 500.0f;
-	float Shield = 500.0f;
 	float MaxHealth = 500.0f;
-	float MaxShield = 500.0f;
 
-	float BoosterFuel = 1500.0f;
+	/*Continuous resources, evaluated on read and replicated only when their rate changes*/
+	UPROPERTY(Replicated)
+	FAircraftLinearResource Shield = FAircraftLinearResource(500.0f, 500.0f);
+
+	UPROPERTY(Replicated)
+	FAircraftLinearResource BoosterFuel = FAircraftLinearResource(1500.0f, 1500.0f);
+
+	/*Fuel per second while boosting*/
+	UPROPERTY(EditAnywhere, Category = "DeveloperProperties")
+	float BoosterFuelBurnRate = 100.0f;
+
+	/*Shield per second once ShieldRegenDelay has passed without damage*/
+	UPROPERTY(EditAnywhere, Category = "DeveloperProperties")
+	float ShieldRegenRate = 50.0f;
+
+	UPROPERTY(EditAnywhere, Category = "DeveloperProperties")
+	float ShieldRegenDelay = 4.0f;
+
+	FAircraftTimerHandle ShieldRegenTimer;
+
+	/*The replicated server clock the resources are timestamped with*/
+	double GetResourceTime() const;
+	void StartShieldRegen();
+	void SetBoosterFuelRate(float Rate);
+
+	UFUNCTION(Server, Reliable)
+	void Server_SetBoostActivated(bool bActivated);
+
+public:
+	float GetShield() const { return Shield.GetValue(GetResourceTime()); }
+	float GetMaxShield() const { return Shield.GetMaxValue(); }
+	float GetBoosterFuel() const { return BoosterFuel.GetValue(GetResourceTime()); }
 #pragma endregion
 
 #pragma region Damage&Destruction-System
 private:
+	/*Damage received during a frame is queued and resolved in a single pass on the next timer tick*/
+	struct FPendingAircraftDamage
+	{
+		TWeakObjectPtr<AController> InstigatorController;
+		float Damage;
+	};
+
+	TArray<FPendingAircraftDamage> PendingDamage;
+	uint8 bDamageResolveScheduled : 1;
+
+	void ResolvePendingDamage();
+	void ApplyResolvedDamage(float Damage);
+
+	UPROPERTY(ReplicatedUsing = OnRep_Vitals)
+	FAircraftVitals Vitals;
+
+	UFUNCTION()
+	void OnRep_Vitals();
+	void UpdateReplicatedVitals();
+
+	/*Spawned through the Niagara component pool; the Cascade particle is only used when this is unset*/
+	UPROPERTY(EditAnywhere, Category = "DeveloperProperties")
+	TSoftObjectPtr<UNiagaraSystem> ExplosionFX;
+
 	UPROPERTY(EditAnywhere, Category = "DeveloperProperties")
-	class UParticleSystem* ExplosionParticle;
+	TSoftObjectPtr<class UParticleSystem> ExplosionParticle;
 
 	UPROPERTY(EditAnywhere, Category = "DeveloperProperties")
-	class USoundCue* ExplosionSound;
+	TSoftObjectPtr<class USoundCue> ExplosionSound;
 
 	UFUNCTION()
 	void ReceiveDamage
@@ -459,7 +696,7 @@ private:
 
 /*Destroy Timer*/
 private:
-	FTimerHandle DestroyTimer;
+	FAircraftTimerHandle DestroyTimer;
 	UPROPERTY(EditAnywhere, Category = "DeveloperProperties")
 	float DestroyTime = 5.0f;
 	void StartDestroyTimer();
@@ -468,7 +705,15 @@ private:
 	/*Server & Multicast*/
 	/*Replications*/
 	UFUNCTION(NetMulticast, Reliable)
-	void Multicast_EnableAndSimulateAircraftPhysics();
+	void Multicast_SetWreckedPresentation(bool bWrecked);
+
+	void PlayDestructionFX();
+
+/*Pooling*/
+public:
+	void ResetForReuse(const FTransform& SpawnTransform);
+	void DeactivateForPool();
+	bool IsInPool() const { return Hot.bInPool; }
 
 #pragma endregion
 };
@@ -0,0 +1,127 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+
+#include "AircraftAssetPreloadSubsystem.h"
+
+#include "Aircraft.h"
+
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+bool UAircraftAssetPreloadSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UAircraftAssetPreloadSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	TArray<TSubclassOf<AAircraft>> LevelAircraftClasses;
+	for (TActorIterator<AAircraft> It(&InWorld); It; ++It)
+	{
+		LevelAircraftClasses.AddUnique(It->GetClass());
+	}
+
+	if (LevelAircraftClasses.Num() > 0)
+	{
+		RequestPreload(LevelAircraftClasses);
+	}
+}
+
+void UAircraftAssetPreloadSubsystem::Deinitialize()
+{
+	for (const TSharedPtr<FStreamableHandle>& Handle : PreloadHandles)
+	{
+		if (Handle.IsValid())
+		{
+			Handle->CancelHandle();
+		}
+	}
+	PreloadHandles.Reset();
+	PendingReadyCallbacks.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UAircraftAssetPreloadSubsystem::IsAircraftClassReady(TSubclassOf<AAircraft> AircraftClass) const
+{
+	return ReadyClasses.Contains(AircraftClass);
+}
+
+void UAircraftAssetPreloadSubsystem::WhenAircraftClassReady(TSubclassOf<AAircraft> AircraftClass, FSimpleDelegate OnReady)
+{
+	if (AircraftClass == nullptr) return;
+
+	if (ReadyClasses.Contains(AircraftClass))
+	{
+		OnReady.ExecuteIfBound();
+		return;
+	}
+
+	PendingReadyCallbacks.Add(AircraftClass, MoveTemp(OnReady));
+	if (LoadingClasses.Contains(AircraftClass) == false)
+	{
+		RequestPreload({ AircraftClass });
+	}
+}
+
+void UAircraftAssetPreloadSubsystem::RequestPreload(const TArray<TSubclassOf<AAircraft>>& AircraftClasses)
+{
+	/*Dedicated servers never render or play audio, so they only stream the gameplay assets*/
+	const UWorld* World = GetWorld();
+	const bool bIncludeCosmetics = World && World->GetNetMode() != NM_DedicatedServer;
+
+	TArray<FSoftObjectPath> AssetsToLoad;
+	for (const TSubclassOf<AAircraft>& AircraftClass : AircraftClasses)
+	{
+		AircraftClass->GetDefaultObject<AAircraft>()->GatherPreloadAssets(AssetsToLoad, bIncludeCosmetics);
+		LoadingClasses.Add(AircraftClass);
+	}
+
+	const double RequestTime = FPlatformTime::Seconds();
+	const int32 NumAssets = AssetsToLoad.Num();
+
+	if (NumAssets == 0)
+	{
+		OnPreloadCompleted(AircraftClasses, RequestTime, NumAssets);
+		return;
+	}
+
+	FStreamableManager& StreamableManager = UAssetManager::GetStreamableManager();
+	TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad
+	(
+		AssetsToLoad,
+		FStreamableDelegate::CreateUObject(this, &UAircraftAssetPreloadSubsystem::OnPreloadCompleted, AircraftClasses, RequestTime, NumAssets),
+		FStreamableManager::AsyncLoadHighPriority
+	);
+
+	if (Handle.IsValid())
+	{
+		PreloadHandles.Add(Handle);
+	}
+}
+
+void UAircraftAssetPreloadSubsystem::OnPreloadCompleted(TArray<TSubclassOf<AAircraft>> AircraftClasses, double RequestTime, int32 NumAssets)
+{
+	const double ElapsedMs = (FPlatformTime::Seconds() - RequestTime) * 1000.0;
+	UE_LOG(LogTemp, Log, TEXT("AircraftAssetPreload: %d assets for %d aircraft classes streamed in %.2f ms"), NumAssets, AircraftClasses.Num(), ElapsedMs);
+
+	for (const TSubclassOf<AAircraft>& AircraftClass : AircraftClasses)
+	{
+		LoadingClasses.Remove(AircraftClass);
+		ReadyClasses.Add(AircraftClass);
+
+		TArray<FSimpleDelegate> Callbacks;
+		PendingReadyCallbacks.MultiFind(AircraftClass, Callbacks);
+		PendingReadyCallbacks.Remove(AircraftClass);
+
+		for (FSimpleDelegate& Callback : Callbacks)
+		{
+			Callback.ExecuteIfBound();
+		}
+	}
+}
@@ -0,0 +1,45 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * UAircraftAssetPreloadSubsystem streams in the soft-referenced assets of every aircraft class placed in the level.
+ * When the world begins play it gathers each class's preload bundle through AAircraft::GatherPreloadAssets and
+ * loads them in one asynchronous request, so aircraft Blueprints no longer pull their FX, sounds and projectile
+ * classes in synchronously during map load. Aircraft spawned later request their own class from BeginPlay, and
+ * UAircraftPoolSubsystem::AcquireAircraftAsync waits on the per-class ready gate before spawning.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AircraftAssetPreloadSubsystem.generated.h"
+
+class AAircraft;
+struct FStreamableHandle;
+
+UCLASS()
+class AIRCRAFT_API UAircraftAssetPreloadSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	bool IsAircraftClassReady(TSubclassOf<AAircraft> AircraftClass) const;
+
+	/*Runs OnReady immediately if the class is ready, otherwise once its preload bundle has finished streaming*/
+	void WhenAircraftClassReady(TSubclassOf<AAircraft> AircraftClass, FSimpleDelegate OnReady);
+
+private:
+	void RequestPreload(const TArray<TSubclassOf<AAircraft>>& AircraftClasses);
+	void OnPreloadCompleted(TArray<TSubclassOf<AAircraft>> AircraftClasses, double RequestTime, int32 NumAssets);
+
+	TSet<TSubclassOf<AAircraft>> ReadyClasses;
+	TSet<TSubclassOf<AAircraft>> LoadingClasses;
+	TMultiMap<TSubclassOf<AAircraft>, FSimpleDelegate> PendingReadyCallbacks;
+
+	/*Handles keep the streamed assets referenced for the lifetime of the world*/
+	TArray<TSharedPtr<FStreamableHandle>> PreloadHandles;
+};
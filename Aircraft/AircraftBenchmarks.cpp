@@ -0,0 +1,526 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/*
+ * Developer console benchmarks for the aircraft systems.
+ * Each command runs inside the current PIE or dedicated server world and writes its result to the log.
+ */
+
+#include "Aircraft.h"
+#include "AircraftExplosionSubsystem.h"
+#include "AircraftFlightProfile.h"
+#include "AircraftImpactEffectSubsystem.h"
+#include "AircraftTimerWheel.h"
+
+#include "Containers/Ticker.h"
+#include "Engine/World.h"
+#include "GameFramework/DamageType.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "NiagaraFunctionLibrary.h"
+#include "NiagaraSystem.h"
+#include "TimerManager.h"
+
+#pragma region ParkedAircraftTicks
+/*Aircraft.Benchmark.ParkedTicks [Count] [Frames] - spawns parked aircraft and reports how many aircraft ticks they cost per frame*/
+static FAutoConsoleCommandWithWorldAndArgs GAircraftParkedTicksBenchmark
+(
+	TEXT("Aircraft.Benchmark.ParkedTicks"),
+	TEXT("Spawns N parked aircraft, samples aircraft ticks for a number of frames and logs the average per frame. Usage: Aircraft.Benchmark.ParkedTicks [Count=200] [Frames=120]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (World == nullptr) return;
+
+		const int32 Count	= Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 200;
+		const int32 Frames	= Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 120;
+
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		TArray<TWeakObjectPtr<AAircraft>> SpawnedAircraft;
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			const FVector Location(Index % 20 * 3000.0f, Index / 20 * 3000.0f, 100000.0f);
+			SpawnedAircraft.Add(World->SpawnActor<AAircraft>(AAircraft::StaticClass(), Location, FRotator::ZeroRotator, SpawnParameters));
+		}
+
+		const uint64 StartTickCount = AAircraft::GetTotalTickCount();
+		int32 FramesSampled = 0;
+
+		FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([SpawnedAircraft, StartTickCount, FramesSampled, Frames, Count](float DeltaTime) mutable
+		{
+			if (++FramesSampled < Frames) return true;
+
+			const uint64 Ticks = AAircraft::GetTotalTickCount() - StartTickCount;
+			UE_LOG(LogTemp, Log, TEXT("Aircraft.Benchmark.ParkedTicks: %d parked aircraft, %llu aircraft ticks over %d frames (%.2f per frame)"),
+				Count, Ticks, FramesSampled, (double)Ticks / FramesSampled);
+
+			for (const TWeakObjectPtr<AAircraft>& Aircraft : SpawnedAircraft)
+			{
+				if (Aircraft.IsValid())
+				{
+					Aircraft->Destroy();
+				}
+			}
+			return false;
+		}));
+	})
+);
+#pragma endregion
+
+#pragma region SimultaneousExplosions
+/*Aircraft.Benchmark.Explosions [Count] - compares per-explosion radial damage with the coalescing resolver*/
+static FAutoConsoleCommandWithWorldAndArgs GAircraftExplosionsBenchmark
+(
+	TEXT("Aircraft.Benchmark.Explosions"),
+	TEXT("Applies N simultaneous explosions around the first player twice, once through ApplyRadialDamageWithFalloff and once through the explosion resolver, and logs both timings. Applies real damage, so use a test map. Usage: Aircraft.Benchmark.Explosions [Count=50]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (World == nullptr) return;
+
+		UAircraftExplosionSubsystem* ExplosionSubsystem = World->GetSubsystem<UAircraftExplosionSubsystem>();
+		if (ExplosionSubsystem == nullptr)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Aircraft.Benchmark.Explosions: the explosion resolver only exists on the server"));
+			return;
+		}
+
+		const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 50;
+
+		APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(World, 0);
+		const FVector Center = PlayerPawn ? PlayerPawn->GetActorLocation() : FVector::ZeroVector;
+
+		FRandomStream RandomStream(Count);
+		TArray<FAircraftRadialDamageRequest> Requests;
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			FAircraftRadialDamageRequest& Request = Requests.AddDefaulted_GetRef();
+			Request.BaseDamage		= 20.0f;
+			Request.MinimumDamage	= 10.0f;
+			Request.Origin			= Center + RandomStream.VRand() * RandomStream.FRandRange(0.0f, 3000.0f);
+			Request.InnerRadius		= 200.0f;
+			Request.OuterRadius		= 1000.0f;
+			Request.Falloff			= 1.0f;
+			Request.DamageTypeClass = UDamageType::StaticClass();
+		}
+
+		const double LegacyStart = FPlatformTime::Seconds();
+		for (const FAircraftRadialDamageRequest& Request : Requests)
+		{
+			UGameplayStatics::ApplyRadialDamageWithFalloff(World, Request.BaseDamage, Request.MinimumDamage, Request.Origin, Request.InnerRadius,
+				Request.OuterRadius, Request.Falloff, Request.DamageTypeClass, TArray<AActor*>(), nullptr, nullptr);
+		}
+		const double LegacySeconds = FPlatformTime::Seconds() - LegacyStart;
+
+		const double ResolverStart = FPlatformTime::Seconds();
+		for (const FAircraftRadialDamageRequest& Request : Requests)
+		{
+			ExplosionSubsystem->QueueRadialDamage(Request);
+		}
+		ExplosionSubsystem->ResolveQueuedExplosions();
+		const double ResolverSeconds = FPlatformTime::Seconds() - ResolverStart;
+
+		UE_LOG(LogTemp, Log, TEXT("Aircraft.Benchmark.Explosions: %d explosions, ApplyRadialDamageWithFalloff %.3f ms, resolver %.3f ms"),
+			Count, LegacySeconds * 1000.0, ResolverSeconds * 1000.0);
+	})
+);
+#pragma endregion
+
+#pragma region ImpactEffects
+/*Aircraft.Benchmark.ImpactFX <NiagaraSystemPath> [ImpactsPerSecond] [Seconds] - sustained-fire impacts spawned directly, then through the impact effect manager*/
+static FAutoConsoleCommandWithWorldAndArgs GAircraftImpactEffectsBenchmark
+(
+	TEXT("Aircraft.Benchmark.ImpactFX"),
+	TEXT("Generates turret-like impacts in front of the camera, first spawning one Niagara system per impact, then through UAircraftImpactEffectSubsystem, and logs effect spawns per second and frame time for both. Usage: Aircraft.Benchmark.ImpactFX <NiagaraSystemPath> [ImpactsPerSecond=600] [Seconds=5]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UAircraftImpactEffectSubsystem* ImpactEffectSubsystem = World ? World->GetSubsystem<UAircraftImpactEffectSubsystem>() : nullptr;
+		UNiagaraSystem* System = Args.Num() > 0 ? LoadObject<UNiagaraSystem>(nullptr, *Args[0]) : nullptr;
+		if (ImpactEffectSubsystem == nullptr || System == nullptr)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Aircraft.Benchmark.ImpactFX: needs a client world and a valid Niagara system path"));
+			return;
+		}
+
+		const float ImpactsPerSecond	= Args.Num() > 1 ? FCString::Atof(*Args[1]) : 600.0f;
+		const float Seconds				= Args.Num() > 2 ? FCString::Atof(*Args[2]) : 5.0f;
+
+		APlayerController* PlayerController = World->GetFirstPlayerController();
+		FVector ViewLocation = FVector::ZeroVector;
+		FRotator ViewRotation = FRotator::ZeroRotator;
+		if (PlayerController)
+		{
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		}
+
+		/*A handful of aim points with spread around each, like two turrets walking fire across terrain*/
+		TArray<FVector> AimPoints;
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			AimPoints.Add(ViewLocation + ViewRotation.Vector() * (4000.0f + Index * 1500.0f) + FVector(0.0f, (Index - 1.5f) * 800.0f, 0.0f));
+		}
+
+		struct FPhase
+		{
+			int32 Frames = 0;
+			double FrameSeconds = 0.0;
+			double MaxFrameSeconds = 0.0;
+			uint64 Impacts = 0;
+			uint64 Spawns = 0;
+		};
+
+		TWeakObjectPtr<UWorld> WeakWorld(World);
+		TWeakObjectPtr<UNiagaraSystem> WeakSystem(System);
+		FRandomStream RandomStream(1);
+		FPhase Phases[2];
+		int32 PhaseIndex = 0;
+		float PhaseTime = 0.0f;
+		float ImpactDebt = 0.0f;
+		uint64 SpawnsAtPhaseStart = ImpactEffectSubsystem->GetTotalEffectsSpawned();
+
+		FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([=](float DeltaTime) mutable
+		{
+			UWorld* TickWorld = WeakWorld.Get();
+			UAircraftImpactEffectSubsystem* Subsystem = TickWorld ? TickWorld->GetSubsystem<UAircraftImpactEffectSubsystem>() : nullptr;
+			if (Subsystem == nullptr || WeakSystem.IsValid() == false) return false;
+
+			FPhase& Phase = Phases[PhaseIndex];
+			++Phase.Frames;
+			Phase.FrameSeconds += DeltaTime;
+			Phase.MaxFrameSeconds = FMath::Max(Phase.MaxFrameSeconds, (double)DeltaTime);
+
+			ImpactDebt += ImpactsPerSecond * DeltaTime;
+			for (; ImpactDebt >= 1.0f; ImpactDebt -= 1.0f)
+			{
+				const FVector Location = AimPoints[RandomStream.RandHelper(AimPoints.Num())] + RandomStream.VRand() * RandomStream.FRandRange(0.0f, 300.0f);
+				++Phase.Impacts;
+
+				if (PhaseIndex == 0)
+				{
+					UNiagaraFunctionLibrary::SpawnSystemAtLocation(TickWorld, WeakSystem.Get(), Location);
+					++Phase.Spawns;
+				}
+				else
+				{
+					FAircraftImpactEffectRequest Request;
+					Request.System = WeakSystem.Get();
+					Request.Location = Location;
+					Subsystem->QueueImpact(Request);
+				}
+			}
+
+			PhaseTime += DeltaTime;
+			if (PhaseTime < Seconds) return true;
+
+			if (PhaseIndex == 1)
+			{
+				Phase.Spawns = Subsystem->GetTotalEffectsSpawned() - SpawnsAtPhaseStart;
+			}
+
+			UE_LOG(LogTemp, Log, TEXT("Aircraft.Benchmark.ImpactFX: %s, %llu impacts, %.1f effect spawns/s, frame avg %.2f ms max %.2f ms"),
+				PhaseIndex == 0 ? TEXT("direct") : TEXT("impact effect manager"),
+				Phase.Impacts, Phase.Spawns / FMath::Max(Phase.FrameSeconds, UE_SMALL_NUMBER),
+				Phase.FrameSeconds * 1000.0 / FMath::Max(Phase.Frames, 1), Phase.MaxFrameSeconds * 1000.0);
+
+			PhaseTime = 0.0f;
+			SpawnsAtPhaseStart = Subsystem->GetTotalEffectsSpawned();
+			return ++PhaseIndex < 2;
+		}));
+	})
+);
+#pragma endregion
+
+#pragma region TimerWheel
+/*Aircraft.Benchmark.TimerWheel [Count] [Frames] [ChurnPerFrame] - the same live timer population on FAircraftTimerWheel and on a standalone FTimerManager*/
+static FAutoConsoleCommandWithWorldAndArgs GAircraftTimerWheelBenchmark
+(
+	TEXT("Aircraft.Benchmark.TimerWheel"),
+	TEXT("Keeps Count one-shot timers of 0.1 to 10 seconds alive on an FAircraftTimerWheel and on a standalone FTimerManager, re-arming each as it fires and clearing and re-setting ChurnPerFrame of them every frame like projectiles hitting early, and logs the insert and per-frame cost of both. Usage: Aircraft.Benchmark.TimerWheel [Count=10000] [Frames=300] [ChurnPerFrame=500]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 Count			= Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 10000;
+		const int32 Frames			= Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 300;
+		const int32 ChurnPerFrame	= Args.Num() > 2 ? FMath::Clamp(FCString::Atoi(*Args[2]), 0, Count) : 500;
+
+		/*Both sides draw delays from identically seeded streams, so they run the same schedule*/
+		struct FTimerBenchmarkState
+		{
+			FAircraftTimerWheel Wheel;
+			FTimerManager TimerManager;
+			TArray<FAircraftTimerHandle> WheelHandles;
+			TArray<FTimerHandle> ManagerHandles;
+			FRandomStream WheelDelays = FRandomStream(7);
+			FRandomStream ManagerDelays = FRandomStream(7);
+			FRandomStream Churn = FRandomStream(11);
+			uint64 WheelFired = 0;
+			uint64 ManagerFired = 0;
+			double WheelSeconds = 0.0;
+			double ManagerSeconds = 0.0;
+			int32 FramesRun = 0;
+
+			void ArmWheel(int32 Index)
+			{
+				WheelHandles[Index] = Wheel.SetTimer(WheelDelays.FRandRange(0.1f, 10.0f), FSimpleDelegate::CreateLambda([this, Index]()
+				{
+					++WheelFired;
+					ArmWheel(Index);
+				}));
+			}
+
+			void ArmManager(int32 Index)
+			{
+				TimerManager.SetTimer(ManagerHandles[Index], FTimerDelegate::CreateLambda([this, Index]()
+				{
+					++ManagerFired;
+					ArmManager(Index);
+				}), ManagerDelays.FRandRange(0.1f, 10.0f), false);
+			}
+		};
+
+		TSharedPtr<FTimerBenchmarkState> State = MakeShared<FTimerBenchmarkState>();
+		State->WheelHandles.SetNum(Count);
+		State->ManagerHandles.SetNum(Count);
+
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			State->ArmWheel(Index);
+		}
+		const double WheelInsertSeconds = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			State->ArmManager(Index);
+		}
+		const double ManagerInsertSeconds = FPlatformTime::Seconds() - StartTime;
+
+		/*FTimerManager only ticks once per engine frame, so each simulated frame waits for a real one*/
+		const float StepSeconds = 1.0f / 60.0f;
+		TArray<int32> ChurnIndices;
+		FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([=](float DeltaTime) mutable
+		{
+			ChurnIndices.Reset();
+			for (int32 Churned = 0; Churned < ChurnPerFrame; ++Churned)
+			{
+				ChurnIndices.Add(State->Churn.RandHelper(Count));
+			}
+
+			double PhaseStart = FPlatformTime::Seconds();
+			for (const int32 Index : ChurnIndices)
+			{
+				State->Wheel.ClearTimer(State->WheelHandles[Index]);
+				State->ArmWheel(Index);
+			}
+			State->Wheel.Advance(StepSeconds);
+			State->WheelSeconds += FPlatformTime::Seconds() - PhaseStart;
+
+			PhaseStart = FPlatformTime::Seconds();
+			for (const int32 Index : ChurnIndices)
+			{
+				State->TimerManager.ClearTimer(State->ManagerHandles[Index]);
+				State->ArmManager(Index);
+			}
+			State->TimerManager.Tick(StepSeconds);
+			State->ManagerSeconds += FPlatformTime::Seconds() - PhaseStart;
+
+			if (++State->FramesRun < Frames) return true;
+
+			UE_LOG(LogTemp, Log, TEXT("Aircraft.Benchmark.TimerWheel: %d timers, %d frames, %d churned per frame"), Count, State->FramesRun, ChurnPerFrame);
+			UE_LOG(LogTemp, Log, TEXT("Aircraft.Benchmark.TimerWheel: timer wheel    insert %.3f ms, frame avg %.4f ms, %llu fired"),
+				WheelInsertSeconds * 1000.0, State->WheelSeconds * 1000.0 / State->FramesRun, State->WheelFired);
+			UE_LOG(LogTemp, Log, TEXT("Aircraft.Benchmark.TimerWheel: FTimerManager  insert %.3f ms, frame avg %.4f ms, %llu fired"),
+				ManagerInsertSeconds * 1000.0, State->ManagerSeconds * 1000.0 / State->FramesRun, State->ManagerFired);
+			return false;
+		}));
+	})
+);
+#pragma endregion
+
+#pragma region FlightProfiles
+/*Aircraft.Benchmark.FlightProfiles [Count] [Steps] [Profile] - the profile-specialised flight integrator against the generic one on identical aircraft*/
+static FAutoConsoleCommandWithWorldAndArgs GAircraftFlightProfilesBenchmark
+(
+	TEXT("Aircraft.Benchmark.FlightProfiles"),
+	TEXT("Integrates Count aircraft with random pilot input for Steps frames, once through the step specialised for Profile and once through the generic step reading the same constants at run time, and logs the cost of both and the largest difference between their results. Usage: Aircraft.Benchmark.FlightProfiles [Count=4096] [Steps=600] [Profile=0..3]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 Count	= Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 4096;
+		const int32 Steps	= Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 600;
+		const EAircraftFlightProfile Profile = (EAircraftFlightProfile)FMath::Clamp(Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 0, 0, (int32)EAircraftFlightProfile::EAFP_MAX - 1);
+		const FAircraftFlightTuning Tuning = FAircraftFlightTuning::FromProfile(Profile);
+		const float DeltaTime = 1.0f / 60.0f;
+
+		FRandomStream RandomStream(5);
+		TArray<FAircraftFlightState> InitialStates;
+		TArray<FAircraftFlightInput> Inputs;
+		InitialStates.SetNum(Count);
+		Inputs.SetNum(Count);
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			FAircraftFlightState& State = InitialStates[Index];
+			State.ThrustSpeed			= RandomStream.FRandRange(Tuning.MinThrustSpeedThreshold * 0.5f, Tuning.MaxThrustSpeed);
+			State.CurrentSpeed			= State.ThrustSpeed;
+			State.GravitationalForce	= Tuning.GravitationalForce;
+
+			FAircraftFlightInput& Input = Inputs[Index];
+			Input.Throttle			= RandomStream.FRandRange(-1.0f, 1.0f);
+			Input.Pitch				= RandomStream.FRandRange(-1.0f, 1.0f);
+			Input.Yaw				= RandomStream.FRandRange(-1.0f, 1.0f);
+			Input.Roll				= RandomStream.FRandRange(-1.0f, 1.0f);
+			Input.Forward			= RandomStream.VRand();
+			Input.bBoostActivated	= RandomStream.FRand() < 0.25f;
+			Input.bTakingOff		= RandomStream.FRand() < 0.05f;
+		}
+
+		TArray<FAircraftFlightStep> OutSteps;
+		OutSteps.SetNum(Count);
+
+		TArray<FAircraftFlightState> SpecialisedStates = InitialStates;
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Step = 0; Step < Steps; ++Step)
+		{
+			FAircraftFlightIntegrator::IntegrateBatch(Profile, SpecialisedStates, Inputs, DeltaTime, OutSteps);
+		}
+		const double SpecialisedSeconds = FPlatformTime::Seconds() - StartTime;
+
+		TArray<FAircraftFlightState> GenericStates = InitialStates;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Step = 0; Step < Steps; ++Step)
+		{
+			FAircraftFlightIntegrator::IntegrateBatch(Tuning, GenericStates, Inputs, DeltaTime, OutSteps);
+		}
+		const double GenericSeconds = FPlatformTime::Seconds() - StartTime;
+
+		float MaxSpeedDifference = 0.0f;
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			MaxSpeedDifference = FMath::Max(MaxSpeedDifference, FMath::Abs(SpecialisedStates[Index].CurrentSpeed - GenericStates[Index].CurrentSpeed));
+		}
+
+		const double AircraftSteps = (double)Count * Steps;
+		UE_LOG(LogTemp, Log, TEXT("Aircraft.Benchmark.FlightProfiles: %s, %d aircraft x %d steps"), *UEnum::GetValueAsString(Profile), Count, Steps);
+		UE_LOG(LogTemp, Log, TEXT("Aircraft.Benchmark.FlightProfiles: specialised %.2f ms (%.1f ns per aircraft step), generic %.2f ms (%.1f ns per aircraft step), max speed difference %.4f"),
+			SpecialisedSeconds * 1000.0, SpecialisedSeconds * 1.0e9 / AircraftSteps, GenericSeconds * 1000.0, GenericSeconds * 1.0e9 / AircraftSteps, MaxSpeedDifference);
+	})
+);
+#pragma endregion
+
+#pragma region HotState
+/*Aircraft.Benchmark.HotState [Count] [Steps] - flight steps reading their working set from one packed block against the same fields spread over the actor*/
+static FAutoConsoleCommandWithWorldAndArgs GAircraftHotStateBenchmark
+(
+	TEXT("Aircraft.Benchmark.HotState"),
+	TEXT("Lays out Count aircraft-sized objects twice, once with the per-frame state in one FAircraftHotState and once with the same fields deliberately spread over four distant cache lines (a synthetic worst case, not the exact layout AAircraft had before FAircraftHotState), runs the flight step over all of them for Steps frames and logs the cost of both. Usage: Aircraft.Benchmark.HotState [Count=8192] [Steps=300]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 Count	= Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 8192;
+		const int32 Steps	= Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 300;
+		const float DeltaTime = 1.0f / 60.0f;
+
+		/*Both layouts use the real actor size as stride, so only the number of lines touched per aircraft differs. The scattered
+		  offsets put every field group on its own distant line, so the gap is an upper bound on what packing can save
+		  rather than a measurement of the old AAircraft layout*/
+		const int32 Stride = Align(AAircraft::StaticClass()->GetStructureSize(), PLATFORM_CACHE_LINE_SIZE);
+		const int32 HotOffset		= PLATFORM_CACHE_LINE_SIZE;
+		const int32 InputOffset		= PLATFORM_CACHE_LINE_SIZE;
+		const int32 FlagsOffset		= Align(Stride / 4, PLATFORM_CACHE_LINE_SIZE);
+		const int32 FlightOffset	= Align(Stride / 2, PLATFORM_CACHE_LINE_SIZE);
+		const int32 DestroyedOffset	= Stride - PLATFORM_CACHE_LINE_SIZE;
+
+		uint8* Packed		= (uint8*)FMemory::Malloc((SIZE_T)Count * Stride, PLATFORM_CACHE_LINE_SIZE);
+		uint8* Scattered	= (uint8*)FMemory::Malloc((SIZE_T)Count * Stride, PLATFORM_CACHE_LINE_SIZE);
+		FMemory::Memzero(Packed, (SIZE_T)Count * Stride);
+		FMemory::Memzero(Scattered, (SIZE_T)Count * Stride);
+
+		const FAircraftFlightTuning Tuning = FAircraftFlightTuning::FromProfile(EAircraftFlightProfile::EAFP_Fighter);
+		const FAircraftFlightIntegrator::FStepFunction StepFunction = FAircraftFlightIntegrator::GetStepFunction(EAircraftFlightProfile::EAFP_Fighter);
+
+		FRandomStream RandomStream(9);
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			FAircraftHotState& Hot = *new (Packed + (SIZE_T)Index * Stride + HotOffset) FAircraftHotState();
+			Hot.Flight.ThrustSpeed		= RandomStream.FRandRange(Tuning.MinThrustSpeedThreshold, Tuning.MaxThrustSpeed);
+			Hot.Flight.CurrentSpeed		= Hot.Flight.ThrustSpeed;
+			Hot.InputThrottle			= RandomStream.FRandRange(-1.0f, 1.0f);
+			Hot.InputPitch				= RandomStream.FRandRange(-1.0f, 1.0f);
+			Hot.InputYaw				= RandomStream.FRandRange(-1.0f, 1.0f);
+			Hot.InputRoll				= RandomStream.FRandRange(-1.0f, 1.0f);
+			Hot.StepFunction			= StepFunction;
+			Hot.bEngineStarted			= true;
+			Hot.bPlayerEnteredVehicle	= true;
+			Hot.bAircraftTakenOff		= true;
+
+			uint8* Aircraft = Scattered + (SIZE_T)Index * Stride;
+			FMemory::Memcpy(Aircraft + InputOffset, &Hot.InputThrottle, sizeof(float) * 4);
+			Aircraft[FlagsOffset]		= 1;	/*Engine started*/
+			Aircraft[FlagsOffset + 1]	= 1;	/*Pilot entered*/
+			Aircraft[FlagsOffset + 2]	= 1;	/*Taken off*/
+			*(FAircraftFlightIntegrator::FStepFunction*)(Aircraft + FlightOffset) = StepFunction;
+			new (Aircraft + FlightOffset + sizeof(FAircraftFlightIntegrator::FStepFunction)) FAircraftFlightState(Hot.Flight);
+			Aircraft[DestroyedOffset]	= 0;
+		}
+
+		FAircraftFlightInput Input;
+		FAircraftFlightStep Step;
+
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 StepIndex = 0; StepIndex < Steps; ++StepIndex)
+		{
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				FAircraftHotState& Hot = *(FAircraftHotState*)(Packed + (SIZE_T)Index * Stride + HotOffset);
+				if (Hot.bPlayerEnteredVehicle == false || Hot.bEngineStarted == false || Hot.bAircraftTakenOff == false || Hot.bAircraftDestroyed) continue;
+
+				Input.Throttle			= Hot.InputThrottle;
+				Input.Pitch				= Hot.InputPitch;
+				Input.Yaw				= Hot.InputYaw;
+				Input.Roll				= Hot.InputRoll;
+				Input.bBoostActivated	= Hot.bBoostActivated;
+				Hot.StepFunction(Hot.Flight, Input, DeltaTime, Step);
+				Hot.ActivityState = EAircraftActivityState::EAAS_Flying;
+			}
+		}
+		const double PackedSeconds = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 StepIndex = 0; StepIndex < Steps; ++StepIndex)
+		{
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				uint8* Aircraft = Scattered + (SIZE_T)Index * Stride;
+				if (Aircraft[FlagsOffset + 1] == 0 || Aircraft[FlagsOffset] == 0 || Aircraft[FlagsOffset + 2] == 0 || Aircraft[DestroyedOffset]) continue;
+
+				const float* StoredInput = (const float*)(Aircraft + InputOffset);
+				Input.Throttle			= StoredInput[0];
+				Input.Pitch				= StoredInput[1];
+				Input.Yaw				= StoredInput[2];
+				Input.Roll				= StoredInput[3];
+				Input.bBoostActivated	= Aircraft[FlagsOffset + 3] != 0;
+
+				const FAircraftFlightIntegrator::FStepFunction ScatteredStep = *(FAircraftFlightIntegrator::FStepFunction*)(Aircraft + FlightOffset);
+				ScatteredStep(*(FAircraftFlightState*)(Aircraft + FlightOffset + sizeof(FAircraftFlightIntegrator::FStepFunction)), Input, DeltaTime, Step);
+				Aircraft[DestroyedOffset + 1] = (uint8)EAircraftActivityState::EAAS_Flying;
+			}
+		}
+		const double ScatteredSeconds = FPlatformTime::Seconds() - StartTime;
+
+		/*Same input and the same step, so both layouts must end on the same speeds*/
+		float MaxSpeedDifference = 0.0f;
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			const FAircraftHotState& Hot = *(const FAircraftHotState*)(Packed + (SIZE_T)Index * Stride + HotOffset);
+			const FAircraftFlightState& Flight = *(const FAircraftFlightState*)(Scattered + (SIZE_T)Index * Stride + FlightOffset + sizeof(FAircraftFlightIntegrator::FStepFunction));
+			MaxSpeedDifference = FMath::Max(MaxSpeedDifference, FMath::Abs(Hot.Flight.CurrentSpeed - Flight.CurrentSpeed));
+		}
+
+		FMemory::Free(Packed);
+		FMemory::Free(Scattered);
+
+		const double AircraftSteps = (double)Count * Steps;
+		UE_LOG(LogTemp, Log, TEXT("Aircraft.Benchmark.HotState: %d aircraft of %d bytes x %d steps, hot block %d bytes"), Count, Stride, Steps, (int32)sizeof(FAircraftHotState));
+		UE_LOG(LogTemp, Log, TEXT("Aircraft.Benchmark.HotState: packed %.2f ms (%.1f ns per aircraft step), scattered %.2f ms (%.1f ns per aircraft step), max speed difference %.4f"),
+			PackedSeconds * 1000.0, PackedSeconds * 1.0e9 / AircraftSteps, ScatteredSeconds * 1000.0, ScatteredSeconds * 1.0e9 / AircraftSteps, MaxSpeedDifference);
+	})
+);
+#pragma endregion
@@ -0,0 +1,221 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+
+#include "AircraftBotController.h"
+
+#include "Aircraft.h"
+#include "AircraftPoolSubsystem.h"
+#include "FighterAircraft.h"
+
+#include "EngineUtils.h"
+
+AAircraftBotController::AAircraftBotController()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	bWantsPlayerState = false;
+}
+
+TSubclassOf<AAircraft> AAircraftBotController::LoadBotAircraftClass(const TCHAR* Params)
+{
+	FString ClassPath;
+	if (FParse::Value(Params, TEXT("AircraftBotClass="), ClassPath) == false || ClassPath.IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("AircraftBot: -AircraftBotClass=<Blueprint aircraft class path> is required to spawn bots"));
+		return nullptr;
+	}
+
+	UClass* AircraftClass = LoadClass<AAircraft>(nullptr, *ClassPath);
+	if (AircraftClass == nullptr)
+	{
+		UE_LOG(LogTemp, Error, TEXT("AircraftBot: could not load aircraft class %s"), *ClassPath);
+		return nullptr;
+	}
+	if (AircraftClass->HasAnyClassFlags(CLASS_Native))
+	{
+		UE_LOG(LogTemp, Error, TEXT("AircraftBot: %s is a native class without mesh or weapons, pass its Blueprint subclass"), *ClassPath);
+		return nullptr;
+	}
+	return AircraftClass;
+}
+
+int32 AAircraftBotController::SpawnBotSwarm(UWorld* World, TSubclassOf<AAircraft> AircraftClass, int32 Count, float Radius, float Altitude, TArray<AAircraft*>& OutAircraft)
+{
+	UAircraftPoolSubsystem* PoolSubsystem = World ? World->GetSubsystem<UAircraftPoolSubsystem>() : nullptr;
+	if (PoolSubsystem == nullptr || AircraftClass == nullptr) return 0;
+
+	int32 NumSpawned = 0;
+	for (; NumSpawned < Count; ++NumSpawned)
+	{
+		const FVector2D Offset = FMath::RandPointInCircle(Radius);
+		const FRotator SpawnRotation(0.0f, FMath::FRandRange(-180.0f, 180.0f), 0.0f);
+		const FTransform SpawnTransform(SpawnRotation, FVector(Offset.X, Offset.Y, Altitude));
+
+		AAircraft* Aircraft = PoolSubsystem->AcquireAircraft(AircraftClass, SpawnTransform);
+		if (Aircraft == nullptr) break;
+
+		FActorSpawnParameters ControllerSpawnParameters;
+		ControllerSpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		AAircraftBotController* BotController = World->SpawnActor<AAircraftBotController>(AAircraftBotController::StaticClass(), SpawnTransform, ControllerSpawnParameters);
+		BotController->Possess(Aircraft);
+
+		OutAircraft.Add(Aircraft);
+	}
+	return NumSpawned;
+}
+
+void AAircraftBotController::OnPossess(APawn* InPawn)
+{
+	Super::OnPossess(InPawn);
+
+	PilotedAircraft = Cast<AAircraft>(InPawn);
+	if (PilotedAircraft == nullptr) return;
+
+	PilotedAircraft->SetPlayerEnteredVehicle(true);
+	PilotedAircraft->SetEnginesRunning(true);
+
+	/*Spread target selection across frames when a whole swarm is possessed at once*/
+	TargetSelectionTimer = FMath::FRandRange(0.0f, TargetSelectionInterval);
+}
+
+void AAircraftBotController::OnUnPossess()
+{
+	if (PilotedAircraft)
+	{
+		PilotedAircraft->SetPilotInput(0.0f, 0.0f, 0.0f, 0.0f);
+		PilotedAircraft->SetBoosterActive(false);
+		if (AFighterAircraft* Fighter = Cast<AFighterAircraft>(PilotedAircraft))
+		{
+			Fighter->SetTurretTriggerHeld(false);
+			Fighter->SetRocketTriggerHeld(false);
+		}
+	}
+	PilotedAircraft = nullptr;
+	CurrentTarget.Reset();
+
+	Super::OnUnPossess();
+}
+
+void AAircraftBotController::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (IsValid(PilotedAircraft) == false || PilotedAircraft->GetActivityState() == EAircraftActivityState::EAAS_Destroyed) return;
+
+	TargetSelectionTimer -= DeltaTime;
+	if (TargetSelectionTimer <= 0.0f || CurrentTarget.IsValid() == false)
+	{
+		TargetSelectionTimer = TargetSelectionInterval;
+		SelectTarget();
+	}
+
+	const AAircraft* Target = CurrentTarget.Get();
+	UpdateBehaviour(PilotedAircraft, Target);
+
+	const FVector Location = PilotedAircraft->GetActorLocation();
+	FVector DesiredDirection = PilotedAircraft->GetActorForwardVector();
+	float Throttle = 1.0f;
+
+	if (Behaviour == EAircraftBotBehaviour::EABB_Evade)
+	{
+		EvadeTimer -= DeltaTime;
+		DesiredDirection = EvadeDirection;
+	}
+	else if (Target)
+	{
+		/*Lead the target by the time it takes to close the distance at our current speed*/
+		const FVector ToTarget = Target->GetActorLocation() - Location;
+		const float ClosingTime = ToTarget.Size() / FMath::Max(PilotedAircraft->GetVelocity().Size(), 1000.0f);
+		DesiredDirection = (ToTarget + Target->GetVelocity() * ClosingTime).GetSafeNormal();
+
+		/*Ease off when about to overshoot a slower target*/
+		Throttle = ToTarget.SizeSquared() < FMath::Square(EvadeDistance) ? 0.0f : 1.0f;
+	}
+
+	if (Location.Z < MinimumAltitude)
+	{
+		DesiredDirection = (DesiredDirection + FVector::UpVector).GetSafeNormal();
+	}
+
+	Steer(PilotedAircraft, DesiredDirection, Throttle);
+	UpdateWeapons(PilotedAircraft, Behaviour == EAircraftBotBehaviour::EABB_Pursuit ? Target : nullptr);
+}
+
+void AAircraftBotController::SelectTarget()
+{
+	const FVector Location = PilotedAircraft->GetActorLocation();
+	AAircraft* ClosestAircraft = nullptr;
+	float ClosestDistanceSquared = TNumericLimits<float>::Max();
+
+	for (TActorIterator<AAircraft> It(GetWorld()); It; ++It)
+	{
+		AAircraft* Candidate = *It;
+		if (Candidate == PilotedAircraft || Candidate->GetActivityState() != EAircraftActivityState::EAAS_Flying) continue;
+
+		const float DistanceSquared = FVector::DistSquared(Location, Candidate->GetActorLocation());
+		if (DistanceSquared < ClosestDistanceSquared)
+		{
+			ClosestDistanceSquared = DistanceSquared;
+			ClosestAircraft = Candidate;
+		}
+	}
+	CurrentTarget = ClosestAircraft;
+}
+
+void AAircraftBotController::UpdateBehaviour(const AAircraft* Aircraft, const AAircraft* Target)
+{
+	if (Behaviour == EAircraftBotBehaviour::EABB_Evade)
+	{
+		if (EvadeTimer <= 0.0f)
+		{
+			Behaviour = EAircraftBotBehaviour::EABB_Pursuit;
+		}
+		return;
+	}
+
+	if (Target == nullptr) return;
+
+	/*Someone close behind us and pointing at us: break hard to one side*/
+	const FVector FromTarget = Aircraft->GetActorLocation() - Target->GetActorLocation();
+	const bool bTargetBehind = FVector::DotProduct(Aircraft->GetActorForwardVector(), FromTarget) > 0.0f;
+	const bool bTargetAimingAtUs = FVector::DotProduct(Target->GetActorForwardVector(), FromTarget.GetSafeNormal()) > 0.9f;
+
+	if (bTargetBehind && bTargetAimingAtUs && FromTarget.SizeSquared() < FMath::Square(EvadeDistance))
+	{
+		const float BreakSide = FMath::RandBool() ? 1.0f : -1.0f;
+		EvadeDirection = (Aircraft->GetActorRightVector() * BreakSide + Aircraft->GetActorUpVector() * 0.3f).GetSafeNormal();
+		EvadeTimer = EvadeDuration;
+		Behaviour = EAircraftBotBehaviour::EABB_Evade;
+	}
+}
+
+void AAircraftBotController::Steer(AAircraft* Aircraft, const FVector& WorldDirection, float Throttle)
+{
+	/*Express the desired direction in the aircraft's frame; the axis updates rotate about the local axes*/
+	const FVector LocalDirection = Aircraft->GetActorTransform().InverseTransformVectorNoScale(WorldDirection);
+
+	/*Positive pitch input rotates the nose down (rotation about local +Y), positive yaw turns right*/
+	const float PitchInput	= FMath::Clamp(-LocalDirection.Z * 3.0f, -1.0f, 1.0f);
+	const float YawInput	= FMath::Clamp(LocalDirection.Y * 3.0f, -1.0f, 1.0f);
+
+	/*Bank into the turn, level the wings otherwise; positive roll input raises the right wing*/
+	const float DesiredRightWingHeight	= -YawInput * 0.6f;
+	const float RightWingHeight			= FVector::DotProduct(Aircraft->GetActorRightVector(), FVector::UpVector);
+	const float RollInput				= FMath::Clamp((DesiredRightWingHeight - RightWingHeight) * 2.0f, -1.0f, 1.0f);
+
+	Aircraft->SetPilotInput(Throttle, PitchInput, YawInput, RollInput);
+	Aircraft->SetBoosterActive(Behaviour == EAircraftBotBehaviour::EABB_Evade || LocalDirection.X < 0.0f);
+}
+
+void AAircraftBotController::UpdateWeapons(AAircraft* Aircraft, const AAircraft* Target)
+{
+	AFighterAircraft* Fighter = Cast<AFighterAircraft>(Aircraft);
+	if (Fighter == nullptr) return;
+
+	const FVector ToTarget = Target ? Target->GetActorLocation() - Aircraft->GetActorLocation() : FVector::ZeroVector;
+	const float DistanceSquared = ToTarget.SizeSquared();
+	const bool bInCone = Target && FVector::DotProduct(Aircraft->GetActorForwardVector(), ToTarget.GetSafeNormal()) > FireConeCosine;
+
+	/*The fighter's fire schedulers pace the rounds; the bot only holds or releases the triggers like a player would*/
+	Fighter->SetTurretTriggerHeld(bInCone && DistanceSquared < FMath::Square(TurretRange));
+	Fighter->SetRocketTriggerHeld(bInCone && DistanceSquared < FMath::Square(RocketRange));
+}
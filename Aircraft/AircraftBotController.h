@@ -0,0 +1,89 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * AAircraftBotController flies an AAircraft without a player, for server load testing.
+ * It drives the aircraft only through the public pilot entry points (SetPilotInput, SetBoosterActive and the
+ * fighter's SetTurretTriggerHeld / SetRocketTriggerHeld), so bots exercise the same code paths as human pilots.
+ * The behaviour is deliberately simple: pursue the nearest other aircraft and fire when it is in the gun cone,
+ * break away with the booster when an aircraft sits close on the tail.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "AircraftBotController.generated.h"
+
+class AAircraft;
+
+UENUM()
+enum class EAircraftBotBehaviour : uint8
+{
+	EABB_Pursuit	UMETA(DisplayName = "Pursuit"),
+	EABB_Evade		UMETA(DisplayName = "Evade")
+};
+
+UCLASS()
+class AIRCRAFT_API AAircraftBotController : public AAIController
+{
+	GENERATED_BODY()
+
+public:
+	AAircraftBotController();
+
+	virtual void Tick(float DeltaTime) override;
+
+	/**
+	 * Loads the Blueprint aircraft class bots fly from -AircraftBotClass=/Game/...BP_Fighter.BP_Fighter_C in Params.
+	 * The native classes have no mesh, FX or projectile classes, so bots in one would never fire; returns null and
+	 * logs an error when the option is missing, does not load or names a native class.
+	 */
+	static TSubclassOf<AAircraft> LoadBotAircraftClass(const TCHAR* Params);
+
+	/*Spawns aircraft through the pool at random points of a disc at Altitude and possesses each with a bot*/
+	static int32 SpawnBotSwarm(UWorld* World, TSubclassOf<AAircraft> AircraftClass, int32 Count, float Radius, float Altitude, TArray<AAircraft*>& OutAircraft);
+
+protected:
+	virtual void OnPossess(APawn* InPawn) override;
+	virtual void OnUnPossess() override;
+
+private:
+	void SelectTarget();
+	void UpdateBehaviour(const AAircraft* Aircraft, const AAircraft* Target);
+	void Steer(AAircraft* Aircraft, const FVector& WorldDirection, float Throttle);
+	void UpdateWeapons(AAircraft* Aircraft, const AAircraft* Target);
+
+	UPROPERTY()
+	AAircraft* PilotedAircraft = nullptr;
+
+	TWeakObjectPtr<AAircraft> CurrentTarget;
+	EAircraftBotBehaviour Behaviour = EAircraftBotBehaviour::EABB_Pursuit;
+
+	float TargetSelectionTimer = 0.0f;
+	float EvadeTimer = 0.0f;
+	FVector EvadeDirection = FVector::ZeroVector;
+
+	/*Tuning*/
+	UPROPERTY(EditAnywhere, Category = "Bot")
+	float TargetSelectionInterval = 1.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Bot")
+	float TurretRange = 15000.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Bot")
+	float RocketRange = 30000.0f;
+
+	/*Cosine of the half angle inside which the bot opens fire*/
+	UPROPERTY(EditAnywhere, Category = "Bot")
+	float FireConeCosine = 0.985f;
+
+	UPROPERTY(EditAnywhere, Category = "Bot")
+	float EvadeDistance = 6000.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Bot")
+	float EvadeDuration = 3.0f;
+
+	/*Keeps bots from flying into the ground while chasing low targets*/
+	UPROPERTY(EditAnywhere, Category = "Bot")
+	float MinimumAltitude = 3000.0f;
+};
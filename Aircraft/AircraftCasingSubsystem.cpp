@@ -0,0 +1,194 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+
+#include "AircraftCasingSubsystem.h"
+
+#include "AircraftStats.h"
+
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Update Casings"),				STAT_AircraftUpdateCasings,		STATGROUP_Aircraft);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Casings Ejected"),		STAT_AircraftCasingsEjected,	STATGROUP_Aircraft);
+
+namespace AircraftCasing
+{
+	/*Parked instances are collapsed to nothing rather than removed, so instance indices never change*/
+	static const FTransform HiddenTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector);
+}
+
+bool UAircraftCasingSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && IsRunningDedicatedServer() == false;
+}
+
+void UAircraftCasingSubsystem::Deinitialize()
+{
+	for (AActor* InstanceHost : InstanceHosts)
+	{
+		if (IsValid(InstanceHost))
+		{
+			InstanceHost->Destroy();
+		}
+	}
+	InstanceHosts.Reset();
+	Rings.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId UAircraftCasingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAircraftCasingSubsystem, STATGROUP_Aircraft);
+}
+
+void UAircraftCasingSubsystem::SpawnCasing(const UObject* WorldContextObject, const UClass* AircraftClass, UStaticMesh* Mesh, const FTransform& EjectTransform, const FVector& EjectVelocity)
+{
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	if (World == nullptr) return;
+
+	if (UAircraftCasingSubsystem* CasingSubsystem = World->GetSubsystem<UAircraftCasingSubsystem>())
+	{
+		CasingSubsystem->EjectCasing(AircraftClass, Mesh, EjectTransform, EjectVelocity);
+	}
+}
+
+UAircraftCasingSubsystem::FCasingRing* UAircraftCasingSubsystem::FindOrCreateRing(const UClass* AircraftClass, UStaticMesh* Mesh)
+{
+	FCasingRing* ExistingRing = Rings.Find(AircraftClass);
+	if (ExistingRing && ExistingRing->Instances.IsValid())
+	{
+		return ExistingRing;
+	}
+
+	UWorld* World = GetWorld();
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.ObjectFlags |= RF_Transient;
+
+	AActor* InstanceHost = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParameters);
+	if (InstanceHost == nullptr) return nullptr;
+
+	/*
+	* A plain instanced mesh rather than a hierarchical one: every live casing moves every frame, and a HISM would
+	* rebuild its cluster tree on each batch update, which costs more than the culling it buys for a few dozen casings
+	*/
+	UInstancedStaticMeshComponent* Instances = NewObject<UInstancedStaticMeshComponent>(InstanceHost, TEXT("CasingInstances"));
+	Instances->SetMobility(EComponentMobility::Movable);
+	Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Instances->SetCastShadow(false);
+	Instances->SetStaticMesh(Mesh);
+	InstanceHost->SetRootComponent(Instances);
+	Instances->RegisterComponent();
+	InstanceHosts.Add(InstanceHost);
+
+	FCasingRing& Ring = Rings.Add(AircraftClass);
+	Ring.Instances = Instances;
+	Ring.Casings.SetNum(RingCapacity);
+	Ring.Transforms.Init(AircraftCasing::HiddenTransform, RingCapacity);
+	Instances->AddInstances(Ring.Transforms, false, true);
+	return &Ring;
+}
+
+void UAircraftCasingSubsystem::EjectCasing(const UClass* AircraftClass, UStaticMesh* Mesh, const FTransform& EjectTransform, const FVector& EjectVelocity)
+{
+	if (AircraftClass == nullptr || Mesh == nullptr) return;
+
+	FCasingRing* Ring = FindOrCreateRing(AircraftClass, Mesh);
+	if (Ring == nullptr || Ring->Casings.Num() == 0) return;
+
+	UWorld* World = GetWorld();
+	const float GravityZ = World->GetGravityZ();
+
+	/*The oldest casing is recycled; with the ring full it simply disappears a little early*/
+	FCasing& Casing = Ring->Casings[Ring->NextSlot];
+	Ring->NextSlot = (Ring->NextSlot + 1) % Ring->Casings.Num();
+	Ring->bSettled = false;
+
+	Casing.EjectTime	= World->GetTimeSeconds();
+	Casing.Origin		= EjectTransform.GetLocation();
+	Casing.Velocity		= EjectVelocity;
+	Casing.Rotation		= EjectTransform.GetRotation();
+	Casing.Scale		= EjectTransform.GetScale3D();
+	Casing.SpinAxis		= FMath::VRand();
+	Casing.SpinRate		= FMath::FRandRange(6.0f, 14.0f);
+	Casing.LandTime		= -1.0f;
+
+	/*One trace decides where the arc meets the ground; nothing is queried while the casing flies*/
+	FHitResult GroundHit;
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(AircraftCasingGround), false);
+	if (GravityZ < 0.0f && World->LineTraceSingleByChannel(GroundHit, Casing.Origin, Casing.Origin - FVector(0.0f, 0.0f, GroundTraceDistance), ECC_WorldStatic, QueryParams))
+	{
+		/*Later root of Origin.Z + Vz t + g t^2 / 2 = GroundZ*/
+		const float Height = Casing.Origin.Z - GroundHit.ImpactPoint.Z;
+		const float Discriminant = FMath::Square(Casing.Velocity.Z) - 2.0f * GravityZ * Height;
+		const float LandTime = (-Casing.Velocity.Z - FMath::Sqrt(FMath::Max(Discriminant, 0.0f))) / GravityZ;
+
+		const FVector Gravity(0.0f, 0.0f, GravityZ);
+		const FVector LandVelocity = Casing.Velocity + Gravity * LandTime;
+
+		Casing.LandTime			= LandTime;
+		Casing.LandLocation		= Casing.Origin + Casing.Velocity * LandTime + Gravity * (0.5f * LandTime * LandTime);
+		Casing.LandLocation.Z	= GroundHit.ImpactPoint.Z;
+		Casing.BounceVelocity	= FVector(LandVelocity.X * BounceFriction, LandVelocity.Y * BounceFriction, -LandVelocity.Z * BounceRestitution);
+		Casing.RestTime			= 2.0f * Casing.BounceVelocity.Z / -GravityZ;
+	}
+
+	INC_DWORD_STAT(STAT_AircraftCasingsEjected);
+}
+
+FTransform UAircraftCasingSubsystem::EvaluateCasing(const FCasing& Casing, float Age, float GravityZ) const
+{
+	const FVector Gravity(0.0f, 0.0f, GravityZ);
+
+	FVector Location;
+	float SpinTime = Age;
+	if (Casing.LandTime < 0.0f || Age < Casing.LandTime)
+	{
+		Location = Casing.Origin + Casing.Velocity * Age + Gravity * (0.5f * Age * Age);
+	}
+	else
+	{
+		/*One bounce, then the casing lies where the bounce ends and stops spinning*/
+		const float BounceAge = FMath::Min(Age - Casing.LandTime, Casing.RestTime);
+		Location = Casing.LandLocation + Casing.BounceVelocity * BounceAge + Gravity * (0.5f * BounceAge * BounceAge);
+		SpinTime = Casing.LandTime + BounceAge;
+	}
+
+	return FTransform(FQuat(Casing.SpinAxis, Casing.SpinRate * SpinTime) * Casing.Rotation, Location, Casing.Scale);
+}
+
+void UAircraftCasingSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AircraftUpdateCasings);
+
+	const UWorld* World = GetWorld();
+	const double Now = World->GetTimeSeconds();
+	const float GravityZ = World->GetGravityZ();
+
+	for (TPair<TObjectKey<UClass>, FCasingRing>& RingPair : Rings)
+	{
+		FCasingRing& Ring = RingPair.Value;
+		UInstancedStaticMeshComponent* Instances = Ring.Instances.Get();
+		if (Instances == nullptr || Ring.bSettled) continue;
+
+		bool bAnyAlive = false;
+		for (int32 Slot = 0; Slot < Ring.Casings.Num(); ++Slot)
+		{
+			const FCasing& Casing = Ring.Casings[Slot];
+			const float Age = (float)(Now - Casing.EjectTime);
+			if (Casing.EjectTime < 0.0 || Age > CasingLifetime)
+			{
+				Ring.Transforms[Slot] = AircraftCasing::HiddenTransform;
+				continue;
+			}
+
+			Ring.Transforms[Slot] = EvaluateCasing(Casing, Age, GravityZ);
+			bAnyAlive = true;
+		}
+
+		Instances->BatchUpdateInstancesTransforms(0, Ring.Transforms, true, true, true);
+		Ring.bSettled = bAnyAlive == false;
+	}
+}
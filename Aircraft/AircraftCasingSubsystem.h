@@ -0,0 +1,86 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * UAircraftCasingSubsystem draws ejected ammunition casings without spawning actors.
+ * Each aircraft class gets one instanced static mesh with a fixed number of instances, recycled as a ring: ejecting
+ * a casing overwrites the oldest slot. Casings follow an analytic ballistic arc from their ejection state with a single
+ * bounce off the ground found by one downward trace at ejection, then lie still until their lifetime ends. All moving
+ * instances are written back in one batch per frame, so the cost depends on the ring capacity, not on the fire rate.
+ * Not created on dedicated servers.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AircraftCasingSubsystem.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+UCLASS()
+class AIRCRAFT_API UAircraftCasingSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void EjectCasing(const UClass* AircraftClass, UStaticMesh* Mesh, const FTransform& EjectTransform, const FVector& EjectVelocity);
+
+	/*Goes through the subsystem when available; dedicated servers drop the casing*/
+	static void SpawnCasing(const UObject* WorldContextObject, const UClass* AircraftClass, UStaticMesh* Mesh, const FTransform& EjectTransform, const FVector& EjectVelocity);
+
+	/*Casings per aircraft class before the oldest is reused*/
+	int32 RingCapacity = 64;
+
+	float CasingLifetime = 6.0f;
+
+	/*Fraction of the vertical speed kept by the bounce, and of the horizontal speed kept while sliding after it*/
+	float BounceRestitution = 0.3f;
+	float BounceFriction = 0.5f;
+
+	/*How far below the ejection point the ground is looked for; casings dropped higher than this never land*/
+	float GroundTraceDistance = 20000.0f;
+
+private:
+	/*Ballistic state of one casing; everything after ejection is derived from it*/
+	struct FCasing
+	{
+		double EjectTime = -1.0;
+		FVector Origin = FVector::ZeroVector;
+		FVector Velocity = FVector::ZeroVector;
+		FQuat Rotation = FQuat::Identity;
+		FVector SpinAxis = FVector::UpVector;
+		float SpinRate = 0.0f;
+		FVector Scale = FVector::OneVector;
+
+		/*Seconds after ejection at which the casing reaches the ground, negative when no ground was found*/
+		float LandTime = -1.0f;
+		FVector LandLocation = FVector::ZeroVector;
+		FVector BounceVelocity = FVector::ZeroVector;
+		float RestTime = 0.0f;
+	};
+
+	struct FCasingRing
+	{
+		TWeakObjectPtr<UInstancedStaticMeshComponent> Instances;
+		TArray<FCasing> Casings;
+		TArray<FTransform> Transforms;
+		int32 NextSlot = 0;
+
+		/*Set once every casing has expired and been hidden, so idle rings cost nothing*/
+		bool bSettled = true;
+	};
+
+	FCasingRing* FindOrCreateRing(const UClass* AircraftClass, UStaticMesh* Mesh);
+	FTransform EvaluateCasing(const FCasing& Casing, float Age, float GravityZ) const;
+
+	TMap<TObjectKey<UClass>, FCasingRing> Rings;
+
+	UPROPERTY(Transient)
+	TArray<AActor*> InstanceHosts;
+};
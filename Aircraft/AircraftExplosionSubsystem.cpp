@@ -0,0 +1,247 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+
+#include "AircraftExplosionSubsystem.h"
+
+#include "AircraftHealthMonitor.h"
+#include "AircraftStats.h"
+
+#include "Engine/DamageEvents.h"
+#include "Engine/World.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/DamageType.h"
+#include "GameFramework/Pawn.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_CYCLE_STAT(TEXT("Resolve Explosions"),			STAT_AircraftResolveExplosions,		STATGROUP_Aircraft);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Explosions Resolved"),	STAT_AircraftExplosionsResolved,	STATGROUP_Aircraft);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Explosion Candidates"),	STAT_AircraftExplosionCandidates,	STATGROUP_Aircraft);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Explosion Traces"),		STAT_AircraftExplosionTraces,		STATGROUP_Aircraft);
+
+APawn* FAircraftRadialDamageRequest::GetInstigatorPawn() const
+{
+	const AController* Controller = InstigatorController.Get();
+	return Controller ? Controller->GetPawn() : nullptr;
+}
+
+bool UAircraftExplosionSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && World->GetNetMode() != NM_Client;
+}
+
+TStatId UAircraftExplosionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAircraftExplosionSubsystem, STATGROUP_Aircraft);
+}
+
+void UAircraftExplosionSubsystem::Tick(float DeltaTime)
+{
+	if (QueuedExplosions.Num() > 0)
+	{
+		ResolveQueuedExplosions();
+	}
+}
+
+void UAircraftExplosionSubsystem::QueueRadialDamage(const FAircraftRadialDamageRequest& Request)
+{
+	if (Request.OuterRadius <= 0.0f) return;
+	QueuedExplosions.Add(Request);
+}
+
+void UAircraftExplosionSubsystem::ApplyRadialDamage(UObject* WorldContextObject, const FAircraftRadialDamageRequest& Request)
+{
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : nullptr;
+	if (World == nullptr) return;
+
+	if (UAircraftExplosionSubsystem* ExplosionSubsystem = World->GetSubsystem<UAircraftExplosionSubsystem>())
+	{
+		ExplosionSubsystem->QueueRadialDamage(Request);
+		return;
+	}
+
+	TArray<AActor*> IgnoredActors;
+	if (AActor* DamageCauser = Request.DamageCauser.Get())
+	{
+		IgnoredActors.Add(DamageCauser);
+	}
+	if (APawn* InstigatorPawn = Request.GetInstigatorPawn())
+	{
+		IgnoredActors.Add(InstigatorPawn);
+	}
+
+	UGameplayStatics::ApplyRadialDamageWithFalloff
+	(
+		WorldContextObject,
+		Request.BaseDamage,
+		Request.MinimumDamage,
+		Request.Origin,
+		Request.InnerRadius,
+		Request.OuterRadius,
+		Request.Falloff,
+		Request.DamageTypeClass,
+		IgnoredActors,
+		Request.DamageCauser.Get(),
+		Request.InstigatorController.Get()
+	);
+}
+
+void UAircraftExplosionSubsystem::ResolveQueuedExplosions()
+{
+	SCOPE_CYCLE_COUNTER(STAT_AircraftResolveExplosions);
+	FAircraftHealthScope HealthScope(EAircraftHealthPhase::EAHP_Damage);
+
+	UWorld* World = GetWorld();
+	if (World == nullptr)
+	{
+		QueuedExplosions.Reset();
+		return;
+	}
+
+	/*1. Cluster explosions whose outer radii overlap; a cluster grows until it touches no other, so a salvo spread
+	  over the map becomes several small queries instead of one box spanning everything between them*/
+	Clusters.Reset();
+	for (int32 ExplosionIndex = 0; ExplosionIndex < QueuedExplosions.Num(); ++ExplosionIndex)
+	{
+		const FAircraftRadialDamageRequest& Explosion = QueuedExplosions[ExplosionIndex];
+		FExplosionCluster Cluster = { FBox::BuildAABB(Explosion.Origin, FVector(Explosion.OuterRadius)), 1, ExplosionIndex, 0, 0 };
+
+		bool bMerged;
+		do
+		{
+			bMerged = false;
+			for (int32 ClusterIndex = Clusters.Num() - 1; ClusterIndex >= 0; --ClusterIndex)
+			{
+				if (Clusters[ClusterIndex].Bounds.Intersect(Cluster.Bounds))
+				{
+					Cluster.Bounds += Clusters[ClusterIndex].Bounds;
+					Cluster.NumExplosions += Clusters[ClusterIndex].NumExplosions;
+					Clusters.RemoveAtSwap(ClusterIndex);
+					bMerged = true;
+				}
+			}
+		}
+		while (bMerged);
+
+		Clusters.Add(Cluster);
+	}
+
+	/*Final clusters are disjoint, so each origin lies in exactly one of them*/
+	ExplosionClusters.SetNumUninitialized(QueuedExplosions.Num());
+	for (int32 ExplosionIndex = 0; ExplosionIndex < QueuedExplosions.Num(); ++ExplosionIndex)
+	{
+		const FVector& Origin = QueuedExplosions[ExplosionIndex].Origin;
+		ExplosionClusters[ExplosionIndex] = Clusters.IndexOfByPredicate([&Origin](const FExplosionCluster& Cluster) { return Cluster.Bounds.IsInsideOrOn(Origin); });
+	}
+
+	/*2. One overlap query per cluster, a sphere when the cluster is a single explosion, merging the overlapped
+	  components into one bounding box per actor*/
+	FCollisionQueryParams OverlapParams(SCENE_QUERY_STAT(AircraftExplosionOverlap), false);
+	const FCollisionObjectQueryParams ObjectParams(FCollisionObjectQueryParams::InitType::AllDynamicObjects);
+
+	Candidates.Reset();
+	for (FExplosionCluster& Cluster : Clusters)
+	{
+		Overlaps.Reset();
+		OverlapParams.ClearIgnoredActors();
+		if (Cluster.NumExplosions == 1)
+		{
+			/*Only a lone explosion's query can leave them out; in a shared one, one explosion's causer may be another's target*/
+			const FAircraftRadialDamageRequest& Explosion = QueuedExplosions[Cluster.FirstExplosion];
+			OverlapParams.AddIgnoredActor(Explosion.DamageCauser.Get());
+			OverlapParams.AddIgnoredActor(Explosion.GetInstigatorPawn());
+			World->OverlapMultiByObjectType(Overlaps, Explosion.Origin, FQuat::Identity, ObjectParams, FCollisionShape::MakeSphere(Explosion.OuterRadius), OverlapParams);
+		}
+		else
+		{
+			World->OverlapMultiByObjectType(Overlaps, Cluster.Bounds.GetCenter(), FQuat::Identity, ObjectParams, FCollisionShape::MakeBox(Cluster.Bounds.GetExtent()), OverlapParams);
+		}
+
+		Cluster.FirstCandidate = Candidates.Num();
+		CandidateIndices.Reset();
+		for (const FOverlapResult& Overlap : Overlaps)
+		{
+			AActor* OverlapActor = Overlap.OverlapObjectHandle.FetchActor();
+			UPrimitiveComponent* OverlapComponent = Overlap.Component.Get();
+			if (OverlapActor == nullptr || OverlapComponent == nullptr || OverlapActor->CanBeDamaged() == false) continue;
+
+			const FBox ComponentBounds = OverlapComponent->Bounds.GetBox();
+			if (const int32* CandidateIndex = CandidateIndices.Find(OverlapActor))
+			{
+				Candidates[*CandidateIndex].Bounds += ComponentBounds;
+			}
+			else
+			{
+				CandidateIndices.Add(OverlapActor, Candidates.Add({ OverlapActor, ComponentBounds }));
+			}
+		}
+		Cluster.NumCandidates = Candidates.Num() - Cluster.FirstCandidate;
+	}
+	INC_DWORD_STAT_BY(STAT_AircraftExplosionCandidates, Candidates.Num());
+
+	/*3. Falloff for every explosion-target pair of a cluster, then a visibility trace only for pairs that can take damage*/
+	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(AircraftExplosionVisibility), false);
+
+	AggregatedDamage.Reset();
+	for (int32 ExplosionIndex = 0; ExplosionIndex < QueuedExplosions.Num(); ++ExplosionIndex)
+	{
+		const FAircraftRadialDamageRequest& Explosion = QueuedExplosions[ExplosionIndex];
+		const FExplosionCluster& Cluster = Clusters[ExplosionClusters[ExplosionIndex]];
+		const float OuterRadiusSquared = FMath::Square(Explosion.OuterRadius);
+		const float RadiusRange = FMath::Max(Explosion.OuterRadius - Explosion.InnerRadius, KINDA_SMALL_NUMBER);
+
+		/*An explosion never damages the projectile that caused it or the aircraft that fired it*/
+		AActor* DamageCauser = Explosion.DamageCauser.Get();
+		APawn* InstigatorPawn = Explosion.GetInstigatorPawn();
+		TraceParams.ClearIgnoredActors();
+		TraceParams.AddIgnoredActor(DamageCauser);
+		TraceParams.AddIgnoredActor(InstigatorPawn);
+
+		for (int32 CandidateIndex = Cluster.FirstCandidate; CandidateIndex < Cluster.FirstCandidate + Cluster.NumCandidates; ++CandidateIndex)
+		{
+			const FExplosionCandidate& Candidate = Candidates[CandidateIndex];
+			if (Candidate.Actor == DamageCauser || Candidate.Actor == InstigatorPawn) continue;
+
+			const float DistanceSquared = Candidate.Bounds.ComputeSquaredDistanceToPoint(Explosion.Origin);
+			if (DistanceSquared >= OuterRadiusSquared) continue;
+
+			const float Distance = FMath::Sqrt(DistanceSquared);
+			float DamageScale = 1.0f;
+			if (Distance > Explosion.InnerRadius && Explosion.Falloff > 0.0f)
+			{
+				DamageScale = FMath::Pow(1.0f - (Distance - Explosion.InnerRadius) / RadiusRange, Explosion.Falloff);
+			}
+
+			const float Damage = FMath::Lerp(Explosion.MinimumDamage, Explosion.BaseDamage, FMath::Clamp(DamageScale, 0.0f, 1.0f));
+			if (Damage <= 0.0f) continue;
+
+			FHitResult VisibilityHit;
+			INC_DWORD_STAT(STAT_AircraftExplosionTraces);
+			const bool bBlocked = World->LineTraceSingleByChannel(VisibilityHit, Explosion.Origin, Candidate.Bounds.GetCenter(), ECC_Visibility, TraceParams);
+			if (bBlocked && VisibilityHit.GetActor() != Candidate.Actor) continue;
+
+			const FAggregatedDamageKey Key = { Candidate.Actor, Explosion.InstigatorController, Explosion.DamageTypeClass.Get() };
+			if (FAggregatedDamage* Existing = AggregatedDamage.Find(Key))
+			{
+				Existing->Damage += Damage;
+			}
+			else
+			{
+				AggregatedDamage.Add(Key, { Explosion.DamageCauser, Damage });
+			}
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_AircraftExplosionsResolved, QueuedExplosions.Num());
+	QueuedExplosions.Reset();
+
+	/*4. One damage event per damaged actor and instigator*/
+	for (const TPair<FAggregatedDamageKey, FAggregatedDamage>& Entry : AggregatedDamage)
+	{
+		if (IsValid(Entry.Key.Actor) == false) continue;
+
+		const FDamageEvent DamageEvent(Entry.Key.DamageTypeClass ? TSubclassOf<UDamageType>(Entry.Key.DamageTypeClass) : TSubclassOf<UDamageType>(UDamageType::StaticClass()));
+		Entry.Key.Actor->TakeDamage(Entry.Value.Damage, DamageEvent, Entry.Key.InstigatorController.Get(), Entry.Value.DamageCauser.Get());
+	}
+	AggregatedDamage.Reset();
+}
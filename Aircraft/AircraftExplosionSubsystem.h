@@ -0,0 +1,105 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * UAircraftExplosionSubsystem replaces per-explosion ApplyRadialDamageWithFalloff calls on the server.
+ * Every radial damage request made during a frame is queued and resolved together: explosions whose outer radii
+ * overlap are clustered and each cluster gathers its candidates with one overlap query, falloff is evaluated for
+ * every explosion-target pair within a cluster, visibility is traced only for pairs inside the outer radius, and
+ * each damaged actor receives a single aggregated TakeDamage call per instigator.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/OverlapResult.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AircraftExplosionSubsystem.generated.h"
+
+class AController;
+class APawn;
+class UDamageType;
+
+struct FAircraftRadialDamageRequest
+{
+	float BaseDamage = 0.0f;
+	float MinimumDamage = 0.0f;
+	FVector Origin = FVector::ZeroVector;
+	float InnerRadius = 0.0f;
+	float OuterRadius = 0.0f;
+	float Falloff = 1.0f;
+
+	TSubclassOf<UDamageType> DamageTypeClass;
+	TWeakObjectPtr<AActor> DamageCauser;
+	TWeakObjectPtr<AController> InstigatorController;
+
+	/*The aircraft the instigator was flying, ignored by the explosion together with DamageCauser*/
+	APawn* GetInstigatorPawn() const;
+};
+
+UCLASS()
+class AIRCRAFT_API UAircraftExplosionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void QueueRadialDamage(const FAircraftRadialDamageRequest& Request);
+
+	/*Resolves everything queued so far; normally called from Tick once per frame*/
+	void ResolveQueuedExplosions();
+
+	/*Queues through the subsystem when available, otherwise falls back to an immediate ApplyRadialDamageWithFalloff*/
+	static void ApplyRadialDamage(UObject* WorldContextObject, const FAircraftRadialDamageRequest& Request);
+
+private:
+	TArray<FAircraftRadialDamageRequest> QueuedExplosions;
+
+	/*Scratch buffers kept between frames to avoid reallocating*/
+	struct FExplosionCluster
+	{
+		FBox Bounds;
+		int32 NumExplosions;
+		int32 FirstExplosion;
+		int32 FirstCandidate;
+		int32 NumCandidates;
+	};
+
+	struct FExplosionCandidate
+	{
+		AActor* Actor;
+		FBox Bounds;
+	};
+
+	struct FAggregatedDamageKey
+	{
+		AActor* Actor;
+		TWeakObjectPtr<AController> InstigatorController;
+		UClass* DamageTypeClass;
+
+		bool operator==(const FAggregatedDamageKey& Other) const
+		{
+			return Actor == Other.Actor && InstigatorController == Other.InstigatorController && DamageTypeClass == Other.DamageTypeClass;
+		}
+
+		friend uint32 GetTypeHash(const FAggregatedDamageKey& Key)
+		{
+			return HashCombine(HashCombine(GetTypeHash(Key.Actor), GetTypeHash(Key.InstigatorController)), GetTypeHash(Key.DamageTypeClass));
+		}
+	};
+
+	struct FAggregatedDamage
+	{
+		TWeakObjectPtr<AActor> DamageCauser;
+		float Damage;
+	};
+
+	TArray<FExplosionCluster> Clusters;
+	TArray<int32> ExplosionClusters;
+	TArray<FExplosionCandidate> Candidates;
+	TMap<AActor*, int32> CandidateIndices;
+	TMap<FAggregatedDamageKey, FAggregatedDamage> AggregatedDamage;
+	TArray<FOverlapResult> Overlaps;
+};
@@ -0,0 +1,35 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+
+#include "AircraftFireScheduler.h"
+
+int32 FAircraftFireScheduler::Advance(float DeltaTime, FRoundAges& OutRoundAges, bool bWeaponReady)
+{
+	if (bTriggerHeld == false || bWeaponReady == false)
+	{
+		/*The weapon cools down while idle but never banks rounds for later*/
+		TimeUntilNextRound = FMath::Max(TimeUntilNextRound - DeltaTime, 0.0f);
+		return 0;
+	}
+
+	if (bFreshPull)
+	{
+		TimeUntilNextRound = FMath::Max(TimeUntilNextRound, DeltaTime);
+		bFreshPull = false;
+	}
+
+	/*The frame covers [0, DeltaTime]; a round is due at TimeUntilNextRound and ages until the end of the frame*/
+	int32 NumRounds = 0;
+	while (TimeUntilNextRound <= DeltaTime && NumRounds < MaxRoundsPerFrame)
+	{
+		OutRoundAges.Add(DeltaTime - FMath::Max(TimeUntilNextRound, 0.0f));
+		TimeUntilNextRound += FireInterval;
+		++NumRounds;
+	}
+
+	TimeUntilNextRound -= DeltaTime;
+
+	/*Whatever the per-frame cap cut off is dropped rather than carried into the next frame*/
+	TimeUntilNextRound = FMath::Max(TimeUntilNextRound, 0.0f);
+	return NumRounds;
+}
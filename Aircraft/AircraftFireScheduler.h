@@ -0,0 +1,50 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * FAircraftFireScheduler decides how many rounds a weapon owes each frame, independently of the frame rate.
+ * It keeps the fractional time left until the next round and, while the trigger is held, works off the debt a
+ * frame accumulates by emitting every round whose fire time fell inside the frame together with its age: how long ago,
+ * relative to the end of the frame, that round should have left the muzzle. Callers spawn the whole batch in one
+ * go and use the age to place each round where it would be had it been fired on time.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct AIRCRAFT_API FAircraftFireScheduler
+{
+	typedef TArray<float, TInlineAllocator<16>> FRoundAges;
+
+	explicit FAircraftFireScheduler(float InFireInterval = 0.1f) : FireInterval(InFireInterval) {}
+
+	/*
+	* Advances the schedule by DeltaTime and appends the age of every round owed in this frame, oldest first.
+	* bWeaponReady false (weapon not selected) cools the weapon down like a released trigger without releasing it.
+	*/
+	int32 Advance(float DeltaTime, FRoundAges& OutRoundAges, bool bWeaponReady = true);
+
+	void SetTriggerHeld(bool bHeld) { bFreshPull |= bHeld && !bTriggerHeld; bTriggerHeld = bHeld; }
+	bool IsTriggerHeld() const { return bTriggerHeld; }
+
+	void SetFireInterval(float NewFireInterval) { FireInterval = FMath::Max(NewFireInterval, KINDA_SMALL_NUMBER); }
+	float GetFireInterval() const { return FireInterval; }
+
+	/*Carries the cooldown over when the aircraft is handed to another airspace shard*/
+	float GetTimeUntilNextRound() const { return TimeUntilNextRound; }
+	void SetTimeUntilNextRound(float Time) { TimeUntilNextRound = Time; }
+
+	/*Clears any cooldown or debt, e.g. when the aircraft is reset from the pool*/
+	void Reset() { TimeUntilNextRound = 0.0f; bTriggerHeld = false; bFreshPull = false; }
+
+	/*Upper bound on rounds in one frame so a long hitch cannot dump a whole magazine at once*/
+	int32 MaxRoundsPerFrame = 16;
+
+private:
+	float FireInterval;
+	float TimeUntilNextRound = 0.0f;
+	bool bTriggerHeld = false;
+
+	/*Set when the trigger is pulled; the pull happened somewhere in the frame, so its first round is not aged*/
+	bool bFreshPull = false;
+};
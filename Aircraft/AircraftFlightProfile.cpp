@@ -0,0 +1,56 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+
+#include "AircraftFlightProfile.h"
+
+FAircraftFlightTuning FAircraftFlightTuning::FromProfile(EAircraftFlightProfile Profile)
+{
+	switch (Profile)
+	{
+		case EAircraftFlightProfile::EAFP_Interceptor:	return FromProfile<FAircraftInterceptorProfile>();
+		case EAircraftFlightProfile::EAFP_Bomber:		return FromProfile<FAircraftBomberProfile>();
+		case EAircraftFlightProfile::EAFP_Transport:	return FromProfile<FAircraftTransportProfile>();
+		default:										return FromProfile<FAircraftFighterProfile>();
+	}
+}
+
+FAircraftFlightIntegrator::FStepFunction FAircraftFlightIntegrator::GetStepFunction(EAircraftFlightProfile Profile)
+{
+	switch (Profile)
+	{
+		case EAircraftFlightProfile::EAFP_Interceptor:	return &TAircraftFlightIntegrator<FAircraftInterceptorProfile>::StepFunction;
+		case EAircraftFlightProfile::EAFP_Bomber:		return &TAircraftFlightIntegrator<FAircraftBomberProfile>::StepFunction;
+		case EAircraftFlightProfile::EAFP_Transport:	return &TAircraftFlightIntegrator<FAircraftTransportProfile>::StepFunction;
+		default:										return &TAircraftFlightIntegrator<FAircraftFighterProfile>::StepFunction;
+	}
+}
+
+void FAircraftFlightIntegrator::Step(const FAircraftFlightTuning& Tuning, FAircraftFlightState& State, const FAircraftFlightInput& Input, float DeltaTime, FAircraftFlightStep& OutStep)
+{
+	TAircraftFlightIntegrator<FAircraftFlightTuning>::Step(Tuning, State, Input, DeltaTime, OutStep);
+}
+
+void FAircraftFlightIntegrator::IntegrateBatch(EAircraftFlightProfile Profile, TArrayView<FAircraftFlightState> States, TArrayView<const FAircraftFlightInput> Inputs, float DeltaTime, TArrayView<FAircraftFlightStep> OutSteps)
+{
+	/*One switch per batch; the loop inside each case is fully specialised*/
+	switch (Profile)
+	{
+		case EAircraftFlightProfile::EAFP_Interceptor:
+			TAircraftFlightIntegrator<FAircraftInterceptorProfile>::IntegrateBatch(FAircraftInterceptorProfile(), States, Inputs, DeltaTime, OutSteps);
+			break;
+		case EAircraftFlightProfile::EAFP_Bomber:
+			TAircraftFlightIntegrator<FAircraftBomberProfile>::IntegrateBatch(FAircraftBomberProfile(), States, Inputs, DeltaTime, OutSteps);
+			break;
+		case EAircraftFlightProfile::EAFP_Transport:
+			TAircraftFlightIntegrator<FAircraftTransportProfile>::IntegrateBatch(FAircraftTransportProfile(), States, Inputs, DeltaTime, OutSteps);
+			break;
+		default:
+			TAircraftFlightIntegrator<FAircraftFighterProfile>::IntegrateBatch(FAircraftFighterProfile(), States, Inputs, DeltaTime, OutSteps);
+			break;
+	}
+}
+
+void FAircraftFlightIntegrator::IntegrateBatch(const FAircraftFlightTuning& Tuning, TArrayView<FAircraftFlightState> States, TArrayView<const FAircraftFlightInput> Inputs, float DeltaTime, TArrayView<FAircraftFlightStep> OutSteps)
+{
+	TAircraftFlightIntegrator<FAircraftFlightTuning>::IntegrateBatch(Tuning, States, Inputs, DeltaTime, OutSteps);
+}
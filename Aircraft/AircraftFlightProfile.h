@@ -0,0 +1,407 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * Flight tuning and the integrator that advances an aircraft's speed, gravity and attitude each frame.
+ * The built-in profiles (fighter, interceptor, bomber, transport) are trait structs of static constexpr constants;
+ * TAircraftFlightIntegrator is instantiated per profile so every constant folds into the generated code and
+ * features a profile lacks (booster, stall attitude correction) compile away. Designer-tuned variants use the same
+ * integrator body instantiated over FAircraftFlightTuning, read at run time from a UAircraftFlightProfileAsset.
+ * The integrator only computes; the aircraft applies the resulting offset and rotations to itself.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "AircraftFlightProfile.generated.h"
+
+UENUM(BlueprintType)
+enum class EAircraftFlightProfile : uint8
+{
+	EAFP_Fighter		UMETA(DisplayName = "Fighter"),
+	EAFP_Interceptor	UMETA(DisplayName = "Interceptor"),
+	EAFP_Bomber			UMETA(DisplayName = "Bomber"),
+	EAFP_Transport		UMETA(DisplayName = "Transport"),
+
+	EAFP_MAX			UMETA(Hidden)
+};
+
+#pragma region Profiles
+/*The reference profile; the others only restate what differs from it*/
+struct FAircraftFighterProfile
+{
+	static constexpr float MaxThrustSpeed			= 4000.0f;
+	static constexpr float MinThrustSpeedThreshold	= 1000.0f;
+	static constexpr float ThrustMultiplier			= 1000.0f;
+
+	static constexpr bool  bHasBooster				= true;
+	static constexpr float MaxBoostSpeed			= 1500.0f;
+	static constexpr float BoostIncreaseRate		= 500.0f;
+	static constexpr float BoostDecreaseRate		= 750.0f;
+
+	static constexpr float GravitationalForce		= 2000.0f;
+	static constexpr float StallGravityIncrease		= 10.0f;
+	static constexpr float AirDragFactor			= 0.5f;
+	static constexpr bool  bStallAttitudeCorrection	= true;
+	static constexpr float TurnRateMargin			= 0.35f;
+
+	static constexpr float PitchInputScale			= 0.794f;
+	static constexpr float PitchControlSpeed		= 0.25f;
+	static constexpr float YawControlSpeed			= 0.50f;
+	static constexpr float RollControlSpeed			= 1.50f;
+	static constexpr float AxisInterpolationSpeed	= 2.0f;
+
+	static constexpr float TakeOffTargetSpeed		= 1500.0f;
+	static constexpr float TakeOffAcceleration		= 0.588f;
+	static constexpr float TakeOffDragMultiplier	= 1.213f;
+	static constexpr float TakeOffPitchDownSpeed	= 900.0f;
+	static constexpr float TakeOffPitchUpSpeed		= 1300.0f;
+	static constexpr float TakeOffRotateSpeed		= 1350.0f;
+	static constexpr float TakeOffLiftOffMargin		= 50.0f;
+	static constexpr float TakeOffPitchDownInput	= -0.5f;
+	static constexpr float TakeOffPitchUpInput		= 1.2f;
+	static constexpr float TakeOffAxisInterpolationSpeed = 1.0f;
+};
+
+struct FAircraftInterceptorProfile : FAircraftFighterProfile
+{
+	static constexpr float MaxThrustSpeed			= 5000.0f;
+	static constexpr float MinThrustSpeedThreshold	= 1200.0f;
+	static constexpr float ThrustMultiplier			= 1400.0f;
+	static constexpr float MaxBoostSpeed			= 2500.0f;
+	static constexpr float BoostIncreaseRate		= 800.0f;
+	static constexpr float AirDragFactor			= 0.4f;
+	static constexpr float PitchControlSpeed		= 0.30f;
+	static constexpr float YawControlSpeed			= 0.40f;
+	static constexpr float RollControlSpeed			= 2.20f;
+	static constexpr float TakeOffTargetSpeed		= 1800.0f;
+	static constexpr float TakeOffPitchDownSpeed	= 1100.0f;
+	static constexpr float TakeOffPitchUpSpeed		= 1550.0f;
+	static constexpr float TakeOffRotateSpeed		= 1600.0f;
+};
+
+struct FAircraftBomberProfile : FAircraftFighterProfile
+{
+	static constexpr float MaxThrustSpeed			= 3000.0f;
+	static constexpr float MinThrustSpeedThreshold	= 900.0f;
+	static constexpr float ThrustMultiplier			= 600.0f;
+	static constexpr float MaxBoostSpeed			= 800.0f;
+	static constexpr float AirDragFactor			= 0.6f;
+	static constexpr float PitchControlSpeed		= 0.15f;
+	static constexpr float YawControlSpeed			= 0.30f;
+	static constexpr float RollControlSpeed			= 0.60f;
+};
+
+struct FAircraftTransportProfile : FAircraftFighterProfile
+{
+	static constexpr float MaxThrustSpeed			= 2400.0f;
+	static constexpr float MinThrustSpeedThreshold	= 800.0f;
+	static constexpr float ThrustMultiplier			= 450.0f;
+	static constexpr bool  bHasBooster				= false;
+	static constexpr float MaxBoostSpeed			= 0.0f;
+	static constexpr float AirDragFactor			= 0.7f;
+	static constexpr bool  bStallAttitudeCorrection	= false;
+	static constexpr float PitchControlSpeed		= 0.12f;
+	static constexpr float YawControlSpeed			= 0.25f;
+	static constexpr float RollControlSpeed			= 0.45f;
+	static constexpr float TakeOffTargetSpeed		= 1200.0f;
+	static constexpr float TakeOffPitchDownSpeed	= 700.0f;
+	static constexpr float TakeOffPitchUpSpeed		= 1000.0f;
+	static constexpr float TakeOffRotateSpeed		= 1050.0f;
+};
+#pragma endregion
+
+/*Run-time copy of a profile, for designer-tuned variants and for code that only reads the limits*/
+USTRUCT(BlueprintType)
+struct AIRCRAFT_API FAircraftFlightTuning
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Thrust")
+	float MaxThrustSpeed = FAircraftFighterProfile::MaxThrustSpeed;
+
+	UPROPERTY(EditAnywhere, Category = "Thrust")
+	float MinThrustSpeedThreshold = FAircraftFighterProfile::MinThrustSpeedThreshold;
+
+	UPROPERTY(EditAnywhere, Category = "Thrust")
+	float ThrustMultiplier = FAircraftFighterProfile::ThrustMultiplier;
+
+	UPROPERTY(EditAnywhere, Category = "Boost")
+	bool bHasBooster = FAircraftFighterProfile::bHasBooster;
+
+	UPROPERTY(EditAnywhere, Category = "Boost")
+	float MaxBoostSpeed = FAircraftFighterProfile::MaxBoostSpeed;
+
+	UPROPERTY(EditAnywhere, Category = "Boost")
+	float BoostIncreaseRate = FAircraftFighterProfile::BoostIncreaseRate;
+
+	UPROPERTY(EditAnywhere, Category = "Boost")
+	float BoostDecreaseRate = FAircraftFighterProfile::BoostDecreaseRate;
+
+	UPROPERTY(EditAnywhere, Category = "Gravity")
+	float GravitationalForce = FAircraftFighterProfile::GravitationalForce;
+
+	/*Added to the gravitational force every frame spent well below the minimum thrust speed*/
+	UPROPERTY(EditAnywhere, Category = "Gravity")
+	float StallGravityIncrease = FAircraftFighterProfile::StallGravityIncrease;
+
+	UPROPERTY(EditAnywhere, Category = "Gravity")
+	float AirDragFactor = FAircraftFighterProfile::AirDragFactor;
+
+	UPROPERTY(EditAnywhere, Category = "Gravity")
+	bool bStallAttitudeCorrection = FAircraftFighterProfile::bStallAttitudeCorrection;
+
+	/*Radians per second the movement validator allows on top of full control deflection. It bounds the stall attitude
+	  correction, which turns a near-fixed angle per frame: about 0.07 rad/s at 60 fps, reaching 0.35 at roughly 330 fps*/
+	UPROPERTY(EditAnywhere, Category = "Gravity")
+	float TurnRateMargin = FAircraftFighterProfile::TurnRateMargin;
+
+	UPROPERTY(EditAnywhere, Category = "Controls")
+	float PitchInputScale = FAircraftFighterProfile::PitchInputScale;
+
+	UPROPERTY(EditAnywhere, Category = "Controls")
+	float PitchControlSpeed = FAircraftFighterProfile::PitchControlSpeed;
+
+	UPROPERTY(EditAnywhere, Category = "Controls")
+	float YawControlSpeed = FAircraftFighterProfile::YawControlSpeed;
+
+	UPROPERTY(EditAnywhere, Category = "Controls")
+	float RollControlSpeed = FAircraftFighterProfile::RollControlSpeed;
+
+	UPROPERTY(EditAnywhere, Category = "Controls")
+	float AxisInterpolationSpeed = FAircraftFighterProfile::AxisInterpolationSpeed;
+
+	UPROPERTY(EditAnywhere, Category = "TakeOff")
+	float TakeOffTargetSpeed = FAircraftFighterProfile::TakeOffTargetSpeed;
+
+	UPROPERTY(EditAnywhere, Category = "TakeOff")
+	float TakeOffAcceleration = FAircraftFighterProfile::TakeOffAcceleration;
+
+	UPROPERTY(EditAnywhere, Category = "TakeOff")
+	float TakeOffDragMultiplier = FAircraftFighterProfile::TakeOffDragMultiplier;
+
+	/*Speeds at which the take-off run noses down, pulls up, and rotates; lift-off follows TakeOffLiftOffMargin later*/
+	UPROPERTY(EditAnywhere, Category = "TakeOff")
+	float TakeOffPitchDownSpeed = FAircraftFighterProfile::TakeOffPitchDownSpeed;
+
+	UPROPERTY(EditAnywhere, Category = "TakeOff")
+	float TakeOffPitchUpSpeed = FAircraftFighterProfile::TakeOffPitchUpSpeed;
+
+	UPROPERTY(EditAnywhere, Category = "TakeOff")
+	float TakeOffRotateSpeed = FAircraftFighterProfile::TakeOffRotateSpeed;
+
+	UPROPERTY(EditAnywhere, Category = "TakeOff")
+	float TakeOffLiftOffMargin = FAircraftFighterProfile::TakeOffLiftOffMargin;
+
+	UPROPERTY(EditAnywhere, Category = "TakeOff")
+	float TakeOffPitchDownInput = FAircraftFighterProfile::TakeOffPitchDownInput;
+
+	UPROPERTY(EditAnywhere, Category = "TakeOff")
+	float TakeOffPitchUpInput = FAircraftFighterProfile::TakeOffPitchUpInput;
+
+	/*The take-off run eases the nose more slowly than AxisInterpolationSpeed does in flight*/
+	UPROPERTY(EditAnywhere, Category = "TakeOff")
+	float TakeOffAxisInterpolationSpeed = FAircraftFighterProfile::TakeOffAxisInterpolationSpeed;
+
+	float GetMaxSpeed() const { return MaxThrustSpeed + MaxBoostSpeed; }
+
+	template<typename TProfile>
+	static FAircraftFlightTuning FromProfile();
+
+	static FAircraftFlightTuning FromProfile(EAircraftFlightProfile Profile);
+};
+
+UCLASS(BlueprintType)
+class AIRCRAFT_API UAircraftFlightProfileAsset : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, Category = "Flight")
+	FAircraftFlightTuning Tuning;
+};
+
+/*Everything the integrator advances from frame to frame*/
+struct FAircraftFlightState
+{
+	float ThrustSpeed = 0.0f;
+	float CurrentSpeed = 0.0f;
+	float BoostSpeed = 0.0f;
+	float AppliedGravity = 0.0f;
+	float GravitationalForce = FAircraftFighterProfile::GravitationalForce;
+
+	float CurrentPitch = 0.0f;
+	float CurrentYaw = 0.0f;
+	float CurrentRoll = 0.0f;
+
+	friend FArchive& operator<<(FArchive& Ar, FAircraftFlightState& State)
+	{
+		Ar << State.ThrustSpeed << State.CurrentSpeed << State.BoostSpeed << State.AppliedGravity << State.GravitationalForce;
+		Ar << State.CurrentPitch << State.CurrentYaw << State.CurrentRoll;
+		return Ar;
+	}
+};
+
+struct FAircraftFlightInput
+{
+	float Throttle = 0.0f;
+	float Pitch = 0.0f;
+	float Yaw = 0.0f;
+	float Roll = 0.0f;
+	FVector Forward = FVector::ForwardVector;
+	bool bBoostActivated = false;
+	bool bTakingOff = false;
+};
+
+/*What the aircraft applies to itself after a step, in this order*/
+struct FAircraftFlightStep
+{
+	FVector WorldOffset = FVector::ZeroVector;
+	FRotator WorldRotation = FRotator::ZeroRotator;
+	FQuat LocalRotation = FQuat::Identity;
+	bool bTakeOffComplete = false;
+};
+
+struct AIRCRAFT_API FAircraftFlightIntegrator
+{
+	typedef void (*FStepFunction)(FAircraftFlightState& State, const FAircraftFlightInput& Input, float DeltaTime, FAircraftFlightStep& OutStep);
+
+	/*The specialised step for a built-in profile*/
+	static FStepFunction GetStepFunction(EAircraftFlightProfile Profile);
+
+	/*The same step reading its constants from Tuning at run time*/
+	static void Step(const FAircraftFlightTuning& Tuning, FAircraftFlightState& State, const FAircraftFlightInput& Input, float DeltaTime, FAircraftFlightStep& OutStep);
+
+	static void IntegrateBatch(EAircraftFlightProfile Profile, TArrayView<FAircraftFlightState> States, TArrayView<const FAircraftFlightInput> Inputs, float DeltaTime, TArrayView<FAircraftFlightStep> OutSteps);
+	static void IntegrateBatch(const FAircraftFlightTuning& Tuning, TArrayView<FAircraftFlightState> States, TArrayView<const FAircraftFlightInput> Inputs, float DeltaTime, TArrayView<FAircraftFlightStep> OutSteps);
+};
+
+/*TTuning is either a profile trait struct, whose constants fold, or FAircraftFlightTuning*/
+template<typename TTuning>
+struct TAircraftFlightIntegrator
+{
+	static FORCEINLINE float InterpAxis(float Current, float Target, float DeltaTime, const TTuning& Tuning)
+	{
+		return FMath::FInterpTo(Current, Target, DeltaTime, Tuning.AxisInterpolationSpeed);
+	}
+
+	static FORCEINLINE void Step(const TTuning& Tuning, FAircraftFlightState& State, const FAircraftFlightInput& Input, float DeltaTime, FAircraftFlightStep& OutStep)
+	{
+		OutStep = FAircraftFlightStep();
+
+		if (Input.bTakingOff)
+		{
+			/*Take-off run: accelerate towards the rotation speed, nose down, pull up, then level out and lift off*/
+			State.CurrentSpeed = FMath::FInterpTo(State.CurrentSpeed, Tuning.TakeOffTargetSpeed, DeltaTime * Tuning.TakeOffAcceleration, Tuning.AirDragFactor * Tuning.TakeOffDragMultiplier);
+			State.AppliedGravity = 0.0f;
+			OutStep.WorldOffset = Input.Forward * (State.CurrentSpeed * DeltaTime);
+
+			float TakeOffPitch = 0.0f;
+			if (State.CurrentSpeed >= Tuning.TakeOffPitchDownSpeed && State.CurrentSpeed <= Tuning.TakeOffPitchUpSpeed)
+			{
+				TakeOffPitch = Tuning.TakeOffPitchDownInput;
+			}
+			else if (State.CurrentSpeed > Tuning.TakeOffPitchUpSpeed && State.CurrentSpeed <= Tuning.TakeOffRotateSpeed)
+			{
+				TakeOffPitch = Tuning.TakeOffPitchUpInput;
+			}
+
+			State.CurrentPitch = FMath::FInterpTo(State.CurrentPitch, TakeOffPitch * Tuning.PitchInputScale, DeltaTime, Tuning.TakeOffAxisInterpolationSpeed);
+			OutStep.LocalRotation = FQuat(FVector::RightVector, State.CurrentPitch * DeltaTime * Tuning.PitchControlSpeed);
+			OutStep.bTakeOffComplete = State.CurrentSpeed > Tuning.TakeOffRotateSpeed + Tuning.TakeOffLiftOffMargin;
+			return;
+		}
+
+		/*Speed: drag bleeds it off towards the thrust speed, thrust above it applies at once*/
+		State.CurrentSpeed = State.ThrustSpeed < State.CurrentSpeed ? FMath::FInterpTo(State.CurrentSpeed, State.ThrustSpeed, DeltaTime, Tuning.AirDragFactor) : State.ThrustSpeed;
+
+		/*Gravity grows while stalling and fades out as the aircraft reaches the minimum thrust speed*/
+		if (State.CurrentSpeed <= Tuning.MinThrustSpeedThreshold / 2 + 200.0f)
+		{
+			State.GravitationalForce += Tuning.StallGravityIncrease;
+		}
+		else if (State.CurrentSpeed > Tuning.MinThrustSpeedThreshold)
+		{
+			State.GravitationalForce = Tuning.GravitationalForce;
+		}
+		State.AppliedGravity = FMath::GetMappedRangeValueClamped(FVector2f(0.0f, Tuning.MinThrustSpeedThreshold), FVector2f(State.GravitationalForce, 0.0f), State.CurrentSpeed);
+
+		OutStep.WorldOffset = Input.Forward * (State.CurrentSpeed * DeltaTime);
+		OutStep.WorldOffset.Z -= State.AppliedGravity * DeltaTime;
+
+		if (Tuning.bStallAttitudeCorrection && State.CurrentSpeed < Tuning.MinThrustSpeedThreshold)
+		{
+			const FRotator StallRotation(-0.09f, -0.2f, -0.09f);
+			OutStep.WorldRotation = FMath::RInterpTo(StallRotation * 0.25f, StallRotation, DeltaTime, 2.0f);
+		}
+
+		/*Throttle and boost feed next frame's thrust speed*/
+		if (Tuning.bHasBooster && Input.bBoostActivated)
+		{
+			State.BoostSpeed = FMath::Clamp(State.BoostSpeed + Tuning.BoostIncreaseRate * DeltaTime, 0.0f, Tuning.MaxBoostSpeed);
+		}
+		else
+		{
+			State.BoostSpeed = FMath::Clamp(State.BoostSpeed - Tuning.BoostDecreaseRate * DeltaTime, 0.0f, Tuning.MaxBoostSpeed);
+		}
+		State.ThrustSpeed = FMath::Clamp(Input.Throttle * DeltaTime * Tuning.ThrustMultiplier + State.ThrustSpeed, 0.0f, Tuning.MaxThrustSpeed) + State.BoostSpeed;
+
+		/*Attitude: pitch and roll follow their input, yaw only turns while held and then settles back*/
+		State.CurrentPitch = InterpAxis(State.CurrentPitch, Input.Pitch * Tuning.PitchInputScale, DeltaTime, Tuning);
+		State.CurrentYaw = InterpAxis(State.CurrentYaw, FMath::Abs(Input.Yaw) > 0.01f ? Input.Yaw : 0.0f, DeltaTime, Tuning);
+		State.CurrentRoll = InterpAxis(State.CurrentRoll, Input.Roll, DeltaTime, Tuning);
+
+		const FQuat PitchRotation(FVector::RightVector, State.CurrentPitch * DeltaTime * Tuning.PitchControlSpeed);
+		const FQuat YawRotation(FVector::UpVector, State.CurrentYaw * DeltaTime * Tuning.YawControlSpeed);
+		const FQuat RollRotation(FVector::ForwardVector, State.CurrentRoll * DeltaTime * Tuning.RollControlSpeed);
+		OutStep.LocalRotation = PitchRotation * YawRotation * RollRotation;
+	}
+
+	static void StepFunction(FAircraftFlightState& State, const FAircraftFlightInput& Input, float DeltaTime, FAircraftFlightStep& OutStep)
+	{
+		Step(TTuning(), State, Input, DeltaTime, OutStep);
+	}
+
+	static void IntegrateBatch(const TTuning& Tuning, TArrayView<FAircraftFlightState> States, TArrayView<const FAircraftFlightInput> Inputs, float DeltaTime, TArrayView<FAircraftFlightStep> OutSteps)
+	{
+		check(States.Num() == Inputs.Num() && States.Num() == OutSteps.Num());
+		for (int32 Index = 0; Index < States.Num(); ++Index)
+		{
+			Step(Tuning, States[Index], Inputs[Index], DeltaTime, OutSteps[Index]);
+		}
+	}
+};
+
+template<typename TProfile>
+FAircraftFlightTuning FAircraftFlightTuning::FromProfile()
+{
+	FAircraftFlightTuning Tuning;
+	Tuning.MaxThrustSpeed			= TProfile::MaxThrustSpeed;
+	Tuning.MinThrustSpeedThreshold	= TProfile::MinThrustSpeedThreshold;
+	Tuning.ThrustMultiplier			= TProfile::ThrustMultiplier;
+	Tuning.bHasBooster				= TProfile::bHasBooster;
+	Tuning.MaxBoostSpeed			= TProfile::MaxBoostSpeed;
+	Tuning.BoostIncreaseRate		= TProfile::BoostIncreaseRate;
+	Tuning.BoostDecreaseRate		= TProfile::BoostDecreaseRate;
+	Tuning.GravitationalForce		= TProfile::GravitationalForce;
+	Tuning.StallGravityIncrease		= TProfile::StallGravityIncrease;
+	Tuning.AirDragFactor			= TProfile::AirDragFactor;
+	Tuning.bStallAttitudeCorrection	= TProfile::bStallAttitudeCorrection;
+	Tuning.TurnRateMargin			= TProfile::TurnRateMargin;
+	Tuning.PitchInputScale			= TProfile::PitchInputScale;
+	Tuning.PitchControlSpeed		= TProfile::PitchControlSpeed;
+	Tuning.YawControlSpeed			= TProfile::YawControlSpeed;
+	Tuning.RollControlSpeed			= TProfile::RollControlSpeed;
+	Tuning.AxisInterpolationSpeed	= TProfile::AxisInterpolationSpeed;
+	Tuning.TakeOffTargetSpeed		= TProfile::TakeOffTargetSpeed;
+	Tuning.TakeOffAcceleration		= TProfile::TakeOffAcceleration;
+	Tuning.TakeOffDragMultiplier	= TProfile::TakeOffDragMultiplier;
+	Tuning.TakeOffPitchDownSpeed	= TProfile::TakeOffPitchDownSpeed;
+	Tuning.TakeOffPitchUpSpeed		= TProfile::TakeOffPitchUpSpeed;
+	Tuning.TakeOffRotateSpeed		= TProfile::TakeOffRotateSpeed;
+	Tuning.TakeOffLiftOffMargin		= TProfile::TakeOffLiftOffMargin;
+	Tuning.TakeOffPitchDownInput	= TProfile::TakeOffPitchDownInput;
+	Tuning.TakeOffPitchUpInput		= TProfile::TakeOffPitchUpInput;
+	Tuning.TakeOffAxisInterpolationSpeed = TProfile::TakeOffAxisInterpolationSpeed;
+	return Tuning;
+}
@@ -0,0 +1,356 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+
+#include "AircraftHealthMonitor.h"
+
+#include "Aircraft.h"
+#include "AircraftStats.h"
+
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/TraceAuxiliary.h"
+#include "Tasks/Task.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Health Monitor Hitches"), STAT_AircraftHealthHitches, STATGROUP_Aircraft);
+
+static TAutoConsoleVariable<float> CVarAircraftHealthHitchMs
+(
+	TEXT("Aircraft.Health.HitchMs"),
+	50.0f,
+	TEXT("Game-thread frame time in milliseconds above which the aircraft health monitor captures a hitch snapshot. 0 disables captures.")
+);
+
+static TAutoConsoleVariable<float> CVarAircraftHealthHitchCooldown
+(
+	TEXT("Aircraft.Health.HitchCooldown"),
+	30.0f,
+	TEXT("Minimum seconds between two hitch captures.")
+);
+
+static TAutoConsoleVariable<float> CVarAircraftHealthHitchTraceSeconds
+(
+	TEXT("Aircraft.Health.HitchTraceSeconds"),
+	2.0f,
+	TEXT("Seconds of Unreal Insights trace (cpu, frame, log, bookmark) recorded after a hitch. 0 writes the frame snapshot only.")
+);
+
+static TAutoConsoleVariable<float> CVarAircraftHealthLogInterval
+(
+	TEXT("Aircraft.Health.LogInterval"),
+	60.0f,
+	TEXT("Seconds between periodic health logs of the last minute on dedicated servers. 0 disables them.")
+);
+
+bool FAircraftHealthScope::bRecording = false;
+uint64 FAircraftHealthScope::PhaseCycles[(int32)EAircraftHealthPhase::EAHP_MAX] = {};
+uint8 FAircraftHealthScope::Depth[(int32)EAircraftHealthPhase::EAHP_MAX] = {};
+
+UAircraftHealthMonitor* UAircraftHealthMonitor::ActiveMonitor = nullptr;
+
+static uint32 CyclesToMicroseconds(uint64 Cycles)
+{
+	return (uint32)FMath::Min(FPlatformTime::ToSeconds64(Cycles) * 1000000.0, (double)FAircraftLatencyHistogram::MaxMicroseconds);
+}
+
+#pragma region Lifetime
+bool UAircraftHealthMonitor::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UAircraftHealthMonitor::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (ActiveMonitor != nullptr) return;
+	ActiveMonitor = this;
+
+	Slices.SetNum(NumSlices);
+	FrameHistory.SetNum(HitchHistoryFrames);
+	CurrentSliceStart = FPlatformTime::Seconds();
+	NextLogTime = CurrentSliceStart + CVarAircraftHealthLogInterval.GetValueOnGameThread();
+
+	BeginFrameHandle = FCoreDelegates::OnBeginFrame.AddUObject(this, &UAircraftHealthMonitor::OnBeginFrame);
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UAircraftHealthMonitor::OnEndFrame);
+	WorldPostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UAircraftHealthMonitor::OnWorldPostActorTick);
+	PostTickFlushHandle = GetWorld()->OnPostTickFlush().AddUObject(this, &UAircraftHealthMonitor::OnPostTickFlush);
+
+	FMemory::Memzero(FAircraftHealthScope::PhaseCycles, sizeof(FAircraftHealthScope::PhaseCycles));
+	FAircraftHealthScope::bRecording = true;
+}
+
+void UAircraftHealthMonitor::Deinitialize()
+{
+	if (ActiveMonitor == this)
+	{
+		FAircraftHealthScope::bRecording = false;
+		ActiveMonitor = nullptr;
+
+		FCoreDelegates::OnBeginFrame.Remove(BeginFrameHandle);
+		FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+		FWorldDelegates::OnWorldPostActorTick.Remove(WorldPostActorTickHandle);
+		GetWorld()->OnPostTickFlush().Remove(PostTickFlushHandle);
+
+#if UE_TRACE_ENABLED
+		if (HitchTraceStopTime > 0.0)
+		{
+			FTraceAuxiliary::Stop();
+			HitchTraceStopTime = 0.0;
+		}
+#endif
+	}
+
+	Super::Deinitialize();
+}
+#pragma endregion
+
+#pragma region Recording
+void UAircraftHealthMonitor::OnBeginFrame()
+{
+	FrameStartCycles = FPlatformTime::Cycles64();
+	FrameStartAircraftTicks = AAircraft::GetTotalTickCount();
+}
+
+void UAircraftHealthMonitor::OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld == GetWorld())
+	{
+		ReplicationStartCycles = FPlatformTime::Cycles64();
+	}
+}
+
+void UAircraftHealthMonitor::OnPostTickFlush(float DeltaSeconds)
+{
+	if (ReplicationStartCycles == 0) return;
+
+	FAircraftHealthScope::PhaseCycles[(int32)EAircraftHealthPhase::EAHP_Replication] += FPlatformTime::Cycles64() - ReplicationStartCycles;
+	ReplicationStartCycles = 0;
+}
+
+void UAircraftHealthMonitor::OnEndFrame()
+{
+	if (FrameStartCycles == 0) return;
+
+	const double Now = FPlatformTime::Seconds();
+	AdvanceSlice(Now);
+
+	FFrameRecord& Record = FrameHistory[NextFrameRecord];
+	NextFrameRecord = (NextFrameRecord + 1) % HitchHistoryFrames;
+
+	Record.FrameNumber = GFrameCounter;
+	Record.Time = Now;
+	Record.Microseconds[0] = CyclesToMicroseconds(FPlatformTime::Cycles64() - FrameStartCycles);
+	for (int32 Phase = 0; Phase < (int32)EAircraftHealthPhase::EAHP_MAX; ++Phase)
+	{
+		Record.Microseconds[Phase + 1] = CyclesToMicroseconds(FAircraftHealthScope::PhaseCycles[Phase]);
+		FAircraftHealthScope::PhaseCycles[Phase] = 0;
+	}
+	Record.AircraftTicks = (uint32)(AAircraft::GetTotalTickCount() - FrameStartAircraftTicks);
+
+	FWindow& Slice = Slices[CurrentSlice];
+	for (int32 Series = 0; Series < NumSeries; ++Series)
+	{
+		Slice.Series[Series].Record(Record.Microseconds[Series]);
+	}
+	FrameStartCycles = 0;
+
+	const float HitchMs = CVarAircraftHealthHitchMs.GetValueOnGameThread();
+	if (HitchMs > 0.0f && Record.Microseconds[0] > HitchMs * 1000.0f)
+	{
+		++NumHitches;
+		INC_DWORD_STAT(STAT_AircraftHealthHitches);
+		if (Now - LastHitchCaptureTime >= CVarAircraftHealthHitchCooldown.GetValueOnGameThread())
+		{
+			CaptureHitch(Record, Now);
+		}
+	}
+
+	UpdateHitchTrace(Now);
+
+	const float LogInterval = CVarAircraftHealthLogInterval.GetValueOnGameThread();
+	if (LogInterval > 0.0f && Now >= NextLogTime && GetWorld()->GetNetMode() == NM_DedicatedServer)
+	{
+		NextLogTime = Now + LogInterval;
+		LogWindow(60.0f);
+	}
+}
+
+void UAircraftHealthMonitor::AdvanceSlice(double Now)
+{
+	/*A long stall may skip whole slices; those are cleared rather than left holding samples from a minute ago*/
+	int32 SlicesToAdvance = FMath::Min((int32)((Now - CurrentSliceStart) / SliceSeconds), NumSlices);
+	if (SlicesToAdvance <= 0) return;
+
+	CurrentSliceStart += SliceSeconds * (int32)((Now - CurrentSliceStart) / SliceSeconds);
+	while (SlicesToAdvance-- > 0)
+	{
+		CurrentSlice = (CurrentSlice + 1) % NumSlices;
+		for (FAircraftLatencyHistogram& Histogram : Slices[CurrentSlice].Series)
+		{
+			Histogram.Reset();
+		}
+	}
+}
+#pragma endregion
+
+#pragma region Reporting
+const TCHAR* UAircraftHealthMonitor::GetSeriesName(int32 Series)
+{
+	static const TCHAR* Names[NumSeries] = { TEXT("Frame"), TEXT("Flight"), TEXT("Weapons"), TEXT("Damage"), TEXT("Replication") };
+	return Names[FMath::Clamp(Series, 0, NumSeries - 1)];
+}
+
+void UAircraftHealthMonitor::GetWindow(float Seconds, FWindow& OutWindow) const
+{
+	const int32 NumWindowSlices = FMath::Clamp(FMath::CeilToInt(Seconds / SliceSeconds), 1, NumSlices);
+	OutWindow.Seconds = NumWindowSlices * SliceSeconds;
+
+	for (FAircraftLatencyHistogram& Histogram : OutWindow.Series)
+	{
+		Histogram.Reset();
+	}
+
+	for (int32 Offset = 0; Offset < NumWindowSlices; ++Offset)
+	{
+		const FWindow& Slice = Slices[(CurrentSlice - Offset + NumSlices) % NumSlices];
+		for (int32 Series = 0; Series < NumSeries; ++Series)
+		{
+			OutWindow.Series[Series].Merge(Slice.Series[Series]);
+		}
+	}
+}
+
+void UAircraftHealthMonitor::LogWindow(float Seconds) const
+{
+	TUniquePtr<FWindow> Window = MakeUnique<FWindow>();
+	GetWindow(Seconds, *Window);
+
+	UE_LOG(LogTemp, Log, TEXT("Aircraft.Health last %.0f s: %llu frames, %llu hitches since start"), Window->Seconds, Window->Series[0].GetCount(), NumHitches);
+	for (int32 Series = 0; Series < NumSeries; ++Series)
+	{
+		const FAircraftLatencyHistogram& Histogram = Window->Series[Series];
+		UE_LOG(LogTemp, Log, TEXT("Aircraft.Health   %-12s mean %7.3f  p50 %7.3f  p95 %7.3f  p99 %7.3f  max %7.3f ms"),
+			GetSeriesName(Series), Histogram.GetMean() / 1000.0, Histogram.GetPercentile(0.50) / 1000.0, Histogram.GetPercentile(0.95) / 1000.0,
+			Histogram.GetPercentile(0.99) / 1000.0, Histogram.GetMax() / 1000.0);
+	}
+}
+
+void UAircraftHealthMonitor::ResetHistograms()
+{
+	for (FWindow& Slice : Slices)
+	{
+		for (FAircraftLatencyHistogram& Histogram : Slice.Series)
+		{
+			Histogram.Reset();
+		}
+	}
+	NumHitches = 0;
+}
+#pragma endregion
+
+#pragma region HitchCapture
+void UAircraftHealthMonitor::CaptureHitch(const FFrameRecord& Record, double Now)
+{
+	LastHitchCaptureTime = Now;
+
+	const FString CaptureName = FString::Printf(TEXT("hitch_%s_frame%llu"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")), Record.FrameNumber);
+	const FString CaptureDirectory = FPaths::Combine(FPaths::ProfilingDir(), TEXT("AircraftHitches"));
+
+	UE_LOG(LogTemp, Warning, TEXT("Aircraft.Health: %.2f ms frame %llu (flight %.2f, weapons %.2f, damage %.2f, replication %.2f ms, %u aircraft ticks), capturing %s"),
+		Record.Microseconds[0] / 1000.0, Record.FrameNumber, Record.Microseconds[1] / 1000.0, Record.Microseconds[2] / 1000.0,
+		Record.Microseconds[3] / 1000.0, Record.Microseconds[4] / 1000.0, Record.AircraftTicks, *CaptureName);
+
+	/*The snapshot is the frames leading up to the hitch, oldest first; the file is written off the game thread*/
+	FString Csv = TEXT("frame,time,frame_ms,flight_ms,weapons_ms,damage_ms,replication_ms,aircraft_ticks\n");
+	for (int32 Offset = 0; Offset < HitchHistoryFrames; ++Offset)
+	{
+		const FFrameRecord& Frame = FrameHistory[(NextFrameRecord + Offset) % HitchHistoryFrames];
+		if (Frame.FrameNumber == 0) continue;
+
+		Csv += FString::Printf(TEXT("%llu,%.4f,%.3f,%.3f,%.3f,%.3f,%.3f,%u\n"), Frame.FrameNumber, Frame.Time, Frame.Microseconds[0] / 1000.0,
+			Frame.Microseconds[1] / 1000.0, Frame.Microseconds[2] / 1000.0, Frame.Microseconds[3] / 1000.0, Frame.Microseconds[4] / 1000.0, Frame.AircraftTicks);
+	}
+
+	const FString CsvPath = FPaths::Combine(CaptureDirectory, CaptureName + TEXT(".csv"));
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [CaptureDirectory, CsvPath, Csv = MoveTemp(Csv)]()
+	{
+		IFileManager::Get().MakeDirectory(*CaptureDirectory, true);
+		FFileHelper::SaveStringToFile(Csv, *CsvPath);
+	});
+
+#if UE_TRACE_ENABLED
+	/*Never take over a trace someone else started*/
+	const float TraceSeconds = CVarAircraftHealthHitchTraceSeconds.GetValueOnGameThread();
+	if (TraceSeconds > 0.0f && HitchTraceStopTime <= 0.0 && FTraceAuxiliary::IsConnected() == false)
+	{
+		IFileManager::Get().MakeDirectory(*CaptureDirectory, true);
+		const FString TracePath = FPaths::Combine(CaptureDirectory, CaptureName + TEXT(".utrace"));
+		if (FTraceAuxiliary::Start(FTraceAuxiliary::EConnectionType::File, *TracePath, TEXT("cpu,frame,log,bookmark")))
+		{
+			HitchTraceStopTime = Now + TraceSeconds;
+		}
+	}
+#endif
+}
+
+void UAircraftHealthMonitor::UpdateHitchTrace(double Now)
+{
+#if UE_TRACE_ENABLED
+	if (HitchTraceStopTime > 0.0 && Now >= HitchTraceStopTime)
+	{
+		FTraceAuxiliary::Stop();
+		HitchTraceStopTime = 0.0;
+	}
+#endif
+}
+#pragma endregion
+
+#pragma region ConsoleCommands
+static FAutoConsoleCommandWithWorldAndArgs GAircraftHealthReportCommand
+(
+	TEXT("Aircraft.Health.Report"),
+	TEXT("Logs p50/p95/p99/max of game-thread frame time and of the flight, weapons, damage and replication phases over the last 10 and 60 seconds, or over the given window. Usage: Aircraft.Health.Report [Seconds] [reset]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UAircraftHealthMonitor* Monitor = UAircraftHealthMonitor::GetActive();
+		if (Monitor == nullptr)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Aircraft.Health.Report: no game world is being monitored"));
+			return;
+		}
+
+		bool bReset = false;
+		TArray<float> Windows;
+		for (const FString& Arg : Args)
+		{
+			if (Arg.Equals(TEXT("reset"), ESearchCase::IgnoreCase))
+			{
+				bReset = true;
+			}
+			else if (Arg.IsNumeric())
+			{
+				Windows.Add(FCString::Atof(*Arg));
+			}
+		}
+		if (Windows.Num() == 0)
+		{
+			Windows = { 10.0f, 60.0f };
+		}
+
+		for (const float Seconds : Windows)
+		{
+			Monitor->LogWindow(Seconds);
+		}
+
+		if (bReset)
+		{
+			Monitor->ResetHistograms();
+		}
+	})
+);
+#pragma endregion
@@ -0,0 +1,148 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * UAircraftHealthMonitor watches game-thread frame time and the aircraft phases inside it, for the tail latency of
+ * dedicated servers. Every frame it records into FAircraftLatencyHistogram slices of SliceSeconds each:
+ *
+ *   Frame        game thread from FCoreDelegates::OnBeginFrame to OnEndFrame
+ *   Flight       AAircraft::IntegrateFlight, summed over all aircraft        (FAircraftHealthScope)
+ *   Weapons      AFighterAircraft::UpdateWeapons                             (FAircraftHealthScope)
+ *   Damage       receiving, resolving and explosion damage                   (FAircraftHealthScope)
+ *   Replication  from the end of actor tick to the end of the net driver's tick flush
+ *
+ * Aircraft.Health.Report [Seconds] [reset] logs p50/p95/p99/max of each over the last 10 and 60 seconds (or the given
+ * window), and Aircraft.Health.LogInterval logs the same periodically. A frame longer than Aircraft.Health.HitchMs
+ * writes the last HitchHistoryFrames frame records to Saved/Profiling/AircraftHitches as CSV and, when
+ * Aircraft.Health.HitchTraceSeconds is set and no trace is already running, records that many seconds of Unreal Insights
+ * trace next to it. Captures are at least Aircraft.Health.HitchCooldown seconds apart.
+ * Only the first game world's monitor records, so PIE sessions with several worlds do not count frames twice.
+ * When nothing is wrong the per-frame cost is a handful of histogram increments and two clock reads per phase scope.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AircraftLatencyHistogram.h"
+#include "AircraftHealthMonitor.generated.h"
+
+UENUM()
+enum class EAircraftHealthPhase : uint8
+{
+	EAHP_Flight			UMETA(DisplayName = "Flight"),
+	EAHP_Weapons		UMETA(DisplayName = "Weapons"),
+	EAHP_Damage			UMETA(DisplayName = "Damage"),
+	EAHP_Replication	UMETA(DisplayName = "Replication"),
+
+	EAHP_MAX			UMETA(Hidden)
+};
+
+/*Adds the game-thread time of its scope to Phase for the current frame; a single branch while no monitor records*/
+class AIRCRAFT_API FAircraftHealthScope
+{
+public:
+	explicit FAircraftHealthScope(EAircraftHealthPhase InPhase)
+		: Phase(InPhase)
+		, bCounted(bRecording)
+	{
+		if (bCounted && Depth[(int32)Phase]++ == 0)
+		{
+			StartCycles = FPlatformTime::Cycles64();
+		}
+	}
+
+	~FAircraftHealthScope()
+	{
+		if (bCounted && --Depth[(int32)Phase] == 0)
+		{
+			PhaseCycles[(int32)Phase] += FPlatformTime::Cycles64() - StartCycles;
+		}
+	}
+
+	/*Game thread only; a scope inside one of the same phase (explosion damage reaching ReceiveDamage) counts once*/
+	static bool bRecording;
+	static uint64 PhaseCycles[(int32)EAircraftHealthPhase::EAHP_MAX];
+
+private:
+	static uint8 Depth[(int32)EAircraftHealthPhase::EAHP_MAX];
+
+	EAircraftHealthPhase Phase;
+	bool bCounted;
+	uint64 StartCycles = 0;
+};
+
+UCLASS()
+class AIRCRAFT_API UAircraftHealthMonitor : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/*The frame series followed by one series per EAircraftHealthPhase*/
+	static constexpr int32 NumSeries = (int32)EAircraftHealthPhase::EAHP_MAX + 1;
+
+	struct FWindow
+	{
+		FAircraftLatencyHistogram Series[NumSeries];
+		float Seconds = 0.0f;
+	};
+
+	/*Merges the slices covering the last Seconds, including the one being filled*/
+	void GetWindow(float Seconds, FWindow& OutWindow) const;
+	void LogWindow(float Seconds) const;
+	void ResetHistograms();
+
+	uint64 GetNumHitches() const { return NumHitches; }
+
+	static const TCHAR* GetSeriesName(int32 Series);
+	static UAircraftHealthMonitor* GetActive() { return ActiveMonitor; }
+
+private:
+	struct FFrameRecord
+	{
+		uint64 FrameNumber = 0;
+		double Time = 0.0;
+		uint32 Microseconds[NumSeries] = {};
+		uint32 AircraftTicks = 0;
+	};
+
+	void OnBeginFrame();
+	void OnEndFrame();
+	void OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+	void OnPostTickFlush(float DeltaSeconds);
+
+	void AdvanceSlice(double Now);
+	void CaptureHitch(const FFrameRecord& Record, double Now);
+	void UpdateHitchTrace(double Now);
+
+	static constexpr float SliceSeconds = 2.0f;
+	static constexpr int32 NumSlices = 30;
+	static constexpr int32 HitchHistoryFrames = 120;
+
+	/*Ring of slices; CurrentSlice is being filled*/
+	TArray<FWindow> Slices;
+	int32 CurrentSlice = 0;
+	double CurrentSliceStart = 0.0;
+
+	TArray<FFrameRecord> FrameHistory;
+	int32 NextFrameRecord = 0;
+
+	uint64 FrameStartCycles = 0;
+	uint64 ReplicationStartCycles = 0;
+	uint64 FrameStartAircraftTicks = 0;
+
+	uint64 NumHitches = 0;
+	double LastHitchCaptureTime = -DBL_MAX;
+	double HitchTraceStopTime = 0.0;
+	double NextLogTime = 0.0;
+
+	FDelegateHandle BeginFrameHandle;
+	FDelegateHandle EndFrameHandle;
+	FDelegateHandle WorldPostActorTickHandle;
+	FDelegateHandle PostTickFlushHandle;
+
+	static UAircraftHealthMonitor* ActiveMonitor;
+};
@@ -0,0 +1,175 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+
+#include "AircraftImpactEffectSubsystem.h"
+
+#include "AircraftStats.h"
+
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "NiagaraComponent.h"
+#include "NiagaraFunctionLibrary.h"
+#include "Particles/ParticleSystem.h"
+#include "Sound/SoundBase.h"
+
+DECLARE_CYCLE_STAT(TEXT("Spawn Impact Effects"),					STAT_AircraftSpawnImpactEffects,		STATGROUP_Aircraft);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Impact Effects Requested"),		STAT_AircraftImpactEffectsRequested,	STATGROUP_Aircraft);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Impact Effects Spawned"),		STAT_AircraftImpactEffectsSpawned,		STATGROUP_Aircraft);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Impact Effects Merged"),			STAT_AircraftImpactEffectsMerged,		STATGROUP_Aircraft);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Impact Effects Culled"),			STAT_AircraftImpactEffectsCulled,		STATGROUP_Aircraft);
+
+const FName UAircraftImpactEffectSubsystem::ImpactCountParameter(TEXT("ImpactCount"));
+
+bool UAircraftImpactEffectSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && IsRunningDedicatedServer() == false;
+}
+
+void UAircraftImpactEffectSubsystem::Deinitialize()
+{
+	PendingClusters.Reset();
+	RecentEffects.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId UAircraftImpactEffectSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAircraftImpactEffectSubsystem, STATGROUP_Aircraft);
+}
+
+void UAircraftImpactEffectSubsystem::SpawnImpactEffect(const UObject* WorldContextObject, const FAircraftImpactEffectRequest& Request)
+{
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	if (World == nullptr) return;
+
+	if (UAircraftImpactEffectSubsystem* ImpactEffectSubsystem = World->GetSubsystem<UAircraftImpactEffectSubsystem>())
+	{
+		ImpactEffectSubsystem->QueueImpact(Request);
+	}
+}
+
+void UAircraftImpactEffectSubsystem::QueueImpact(const FAircraftImpactEffectRequest& Request)
+{
+	const UObject* Effect = Request.System ? (const UObject*)Request.System : (const UObject*)Request.LegacyParticles;
+	if (Effect == nullptr && Request.Sound == nullptr) return;
+
+	INC_DWORD_STAT(STAT_AircraftImpactEffectsRequested);
+	++TotalImpactsRequested;
+
+	const float MergeRadiusSquared = FMath::Square(MergeRadius);
+
+	/*An instance that is still playing next to this impact absorbs it*/
+	const double Now = GetWorld()->GetTimeSeconds();
+	for (FRecentEffect& RecentEffect : RecentEffects)
+	{
+		if (RecentEffect.Effect == Effect && Now - RecentEffect.SpawnTime <= MergeWindow && FVector::DistSquared(RecentEffect.Location, Request.Location) <= MergeRadiusSquared)
+		{
+			++RecentEffect.ImpactCount;
+			if (UNiagaraComponent* Component = RecentEffect.Component.Get())
+			{
+				Component->SetVariableInt(ImpactCountParameter, RecentEffect.ImpactCount);
+			}
+			INC_DWORD_STAT(STAT_AircraftImpactEffectsMerged);
+			return;
+		}
+	}
+
+	/*Otherwise it joins a cluster of this frame, which is centred on the average of its impacts*/
+	for (FImpactCluster& Cluster : PendingClusters)
+	{
+		const UObject* ClusterEffect = Cluster.Request.System ? (const UObject*)Cluster.Request.System : (const UObject*)Cluster.Request.LegacyParticles;
+		if (ClusterEffect == Effect && Cluster.Request.Sound == Request.Sound && FVector::DistSquared(Cluster.Request.Location, Request.Location) <= MergeRadiusSquared)
+		{
+			++Cluster.ImpactCount;
+			Cluster.Request.Location += (Request.Location - Cluster.Request.Location) / Cluster.ImpactCount;
+			INC_DWORD_STAT(STAT_AircraftImpactEffectsMerged);
+			return;
+		}
+	}
+
+	FImpactCluster& Cluster = PendingClusters.AddDefaulted_GetRef();
+	Cluster.Request = Request;
+	Cluster.ImpactCount = 1;
+}
+
+void UAircraftImpactEffectSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AircraftSpawnImpactEffects);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	RecentEffects.RemoveAllSwap([this, Now](const FRecentEffect& RecentEffect) { return Now - RecentEffect.SpawnTime > MergeWindow; });
+
+	if (PendingClusters.Num() == 0) return;
+
+	FVector ViewLocation;
+	const bool bHasView = GetViewLocation(ViewLocation);
+	for (FImpactCluster& Cluster : PendingClusters)
+	{
+		Cluster.DistanceSquared = bHasView ? FVector::DistSquared(ViewLocation, Cluster.Request.Location) : 0.0;
+	}
+
+	/*Nearest first, so whatever the budget cuts is what the player is least likely to notice*/
+	PendingClusters.Sort([](const FImpactCluster& A, const FImpactCluster& B) { return A.DistanceSquared < B.DistanceSquared; });
+
+	const double MaxDistanceSquared = FMath::Square((double)MaxEffectDistance);
+	int32 NumSpawned = 0;
+	for (const FImpactCluster& Cluster : PendingClusters)
+	{
+		if (NumSpawned >= MaxSpawnsPerFrame || Cluster.DistanceSquared > MaxDistanceSquared)
+		{
+			INC_DWORD_STAT_BY(STAT_AircraftImpactEffectsCulled, Cluster.ImpactCount);
+			continue;
+		}
+
+		SpawnCluster(Cluster.Request, Cluster.ImpactCount);
+		++NumSpawned;
+	}
+	PendingClusters.Reset();
+}
+
+void UAircraftImpactEffectSubsystem::SpawnCluster(const FAircraftImpactEffectRequest& Request, int32 ImpactCount)
+{
+	UWorld* World = GetWorld();
+
+	UNiagaraComponent* Component = nullptr;
+	if (Request.System)
+	{
+		Component = UNiagaraFunctionLibrary::SpawnSystemAtLocation(World, Request.System, Request.Location, Request.Rotation, FVector(1.0f), false, true, ENCPoolMethod::AutoRelease);
+		if (Component)
+		{
+			Component->SetVariableInt(ImpactCountParameter, ImpactCount);
+		}
+	}
+	else if (Request.LegacyParticles)
+	{
+		UGameplayStatics::SpawnEmitterAtLocation(World, Request.LegacyParticles, FTransform(Request.Rotation, Request.Location), true, EPSCPoolMethod::AutoRelease);
+	}
+
+	if (Request.Sound)
+	{
+		UGameplayStatics::PlaySoundAtLocation(World, Request.Sound, Request.Location);
+	}
+
+	FRecentEffect& RecentEffect = RecentEffects.AddDefaulted_GetRef();
+	RecentEffect.Effect = Request.System ? (const UObject*)Request.System : (const UObject*)Request.LegacyParticles;
+	RecentEffect.Location = Request.Location;
+	RecentEffect.SpawnTime = World->GetTimeSeconds();
+	RecentEffect.ImpactCount = ImpactCount;
+	RecentEffect.Component = Component;
+
+	INC_DWORD_STAT(STAT_AircraftImpactEffectsSpawned);
+	++TotalEffectsSpawned;
+}
+
+bool UAircraftImpactEffectSubsystem::GetViewLocation(FVector& OutViewLocation) const
+{
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (PlayerController == nullptr || PlayerController->PlayerCameraManager == nullptr) return false;
+
+	OutViewLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+	return true;
+}
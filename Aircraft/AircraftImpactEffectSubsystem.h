@@ -0,0 +1,93 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * UAircraftImpactEffectSubsystem replaces the emitter and sound every projectile spawned on its own impact.
+ * Impacts requested during a frame are merged into clusters (same effect, within MergeRadius), and impacts landing
+ * near an effect spawned less than MergeWindow ago are folded into that instance instead of spawning another. Each
+ * instance receives the number of impacts it stands for through the User.ImpactCount Niagara parameter. Clusters are
+ * spawned nearest to the local view first, up to MaxSpawnsPerFrame, from the Niagara and particle component pools.
+ * Not created on dedicated servers, which have nothing to show.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AircraftImpactEffectSubsystem.generated.h"
+
+class UNiagaraComponent;
+class UNiagaraSystem;
+class UParticleSystem;
+class USoundBase;
+
+struct FAircraftImpactEffectRequest
+{
+	UNiagaraSystem* System = nullptr;
+
+	/*Cascade template for projectiles not yet moved to a Niagara impact system*/
+	UParticleSystem* LegacyParticles = nullptr;
+
+	USoundBase* Sound = nullptr;
+	FVector Location = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+};
+
+UCLASS()
+class AIRCRAFT_API UAircraftImpactEffectSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void QueueImpact(const FAircraftImpactEffectRequest& Request);
+
+	/*Queues through the subsystem when available; dedicated servers drop the request*/
+	static void SpawnImpactEffect(const UObject* WorldContextObject, const FAircraftImpactEffectRequest& Request);
+
+	/*Impacts closer than this, with the same effect, share one instance*/
+	float MergeRadius = 250.0f;
+
+	/*How long a spawned instance keeps absorbing nearby impacts*/
+	float MergeWindow = 0.1f;
+
+	int32 MaxSpawnsPerFrame = 8;
+
+	/*Impacts further than this from the view are not shown at all*/
+	float MaxEffectDistance = 40000.0f;
+
+	static const FName ImpactCountParameter;
+
+	/*Running totals for benchmarks: impacts requested and effect instances actually spawned*/
+	uint64 GetTotalImpactsRequested() const { return TotalImpactsRequested; }
+	uint64 GetTotalEffectsSpawned() const { return TotalEffectsSpawned; }
+
+private:
+	void SpawnCluster(const FAircraftImpactEffectRequest& Request, int32 ImpactCount);
+	bool GetViewLocation(FVector& OutViewLocation) const;
+
+	struct FImpactCluster
+	{
+		FAircraftImpactEffectRequest Request;
+		int32 ImpactCount = 0;
+		double DistanceSquared = 0.0;
+	};
+	TArray<FImpactCluster> PendingClusters;
+
+	/*Instances spawned within the last MergeWindow, still accepting impacts*/
+	struct FRecentEffect
+	{
+		const UObject* Effect = nullptr;
+		FVector Location = FVector::ZeroVector;
+		double SpawnTime = 0.0;
+		int32 ImpactCount = 0;
+		TWeakObjectPtr<UNiagaraComponent> Component;
+	};
+	TArray<FRecentEffect> RecentEffects;
+
+	uint64 TotalImpactsRequested = 0;
+	uint64 TotalEffectsSpawned = 0;
+};
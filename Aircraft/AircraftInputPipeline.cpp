@@ -0,0 +1,147 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+
+#include "AircraftInputPipeline.h"
+
+#include "Aircraft.h"
+#include "AircraftStats.h"
+
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Input To Flight Response (ms)"), STAT_AircraftInputLatency, STATGROUP_Aircraft);
+
+FAircraftInputAppliedHook FAircraftInputPipeline::OnInputApplied;
+
+float FAircraftInputPipeline::ApplyResponse(float RawValue, const FAircraftAxisResponse& Response)
+{
+	const float Deadzone = FMath::Clamp(Response.Deadzone, 0.0f, 0.9f);
+	float Magnitude = FMath::Abs(RawValue);
+	if (Magnitude <= Deadzone) return 0.0f;
+
+	/*Rescaled so leaving the deadzone starts at 0 instead of jumping to the deadzone's edge*/
+	Magnitude = FMath::Min((Magnitude - Deadzone) / (1.0f - Deadzone), 1.0f);
+	Magnitude = FMath::Lerp(Magnitude, Magnitude * Magnitude * Magnitude, FMath::Clamp(Response.Expo, 0.0f, 1.0f));
+
+	const float Sign = (RawValue < 0.0f) != Response.bInvert ? -1.0f : 1.0f;
+	return Sign * Magnitude;
+}
+
+void FAircraftInputPipeline::SetRawAxis(EAircraftInputAxis Axis, float Value)
+{
+	FAxisState& State = Axes[(int32)Axis];
+	const float ClampedValue = FMath::Clamp(Value, -1.0f, 1.0f);
+	if (ClampedValue == State.RawValue) return;
+
+	State.RawValue = ClampedValue;
+	if (State.PendingChangeTime == 0.0)
+	{
+		State.PendingChangeTime = FPlatformTime::Seconds();
+		State.PendingFromValue = State.SmoothedValue;
+	}
+}
+
+const FAircraftInputFrame& FAircraftInputPipeline::Sample(float DeltaTime, double ServerTime)
+{
+	FAircraftInputFrame Frame;
+	Frame.Sequence = LatestFrame.Sequence + 1;
+	Frame.SampleTime = FPlatformTime::Seconds();
+	Frame.ServerTime = ServerTime;
+
+	for (int32 AxisIndex = 0; AxisIndex < (int32)EAircraftInputAxis::EAIA_MAX; ++AxisIndex)
+	{
+		FAxisState& State = Axes[AxisIndex];
+		const float Shaped = ApplyResponse(State.RawValue, State.Response);
+
+		/*Frame-rate independent: the same time constant gives the same response at 30 and 144 fps*/
+		const float Alpha = State.Response.SmoothingTime > 0.0f ? 1.0f - FMath::Exp(-FMath::Max(DeltaTime, 0.0f) / State.Response.SmoothingTime) : 1.0f;
+		State.SmoothedValue += (Shaped - State.SmoothedValue) * Alpha;
+		if (FMath::IsNearlyEqual(State.SmoothedValue, Shaped, 1.0e-3f))
+		{
+			State.SmoothedValue = Shaped;
+		}
+		Frame.Axes[AxisIndex] = State.SmoothedValue;
+
+		/*Resolved once the output has covered ResponseFraction of the way from where it stood to the current target;
+		  a change the shaping swallows (inside the deadzone) resolves on the first sample*/
+		const float Travel = Shaped - State.PendingFromValue;
+		const bool bResponded = FMath::Abs(Travel) < KINDA_SMALL_NUMBER || (State.SmoothedValue - State.PendingFromValue) * FMath::Sign(Travel) >= ResponseFraction * FMath::Abs(Travel);
+		if (State.PendingChangeTime > 0.0 && bResponded)
+		{
+			Frame.OldestChangeTime = Frame.OldestChangeTime > 0.0 ? FMath::Min(Frame.OldestChangeTime, State.PendingChangeTime) : State.PendingChangeTime;
+			State.PendingChangeTime = 0.0;
+		}
+	}
+
+	LatestFrame = Frame;
+	History[Frame.Sequence % HistorySize] = Frame;
+	return LatestFrame;
+}
+
+void FAircraftInputPipeline::NotifyApplied()
+{
+	if (LatestFrame.OldestChangeTime <= 0.0) return;
+
+	const double Latency = FPlatformTime::Seconds() - LatestFrame.OldestChangeTime;
+	++LatencyReport.Samples;
+	LatencyReport.TotalSeconds += Latency;
+	LatencyReport.MaxSeconds = FMath::Max(LatencyReport.MaxSeconds, Latency);
+	SET_FLOAT_STAT(STAT_AircraftInputLatency, Latency * 1000.0);
+
+	OnInputApplied.Broadcast(LatestFrame, Latency);
+
+	/*Each change is measured once, by the first step that applies its response*/
+	LatestFrame.OldestChangeTime = 0.0;
+}
+
+void FAircraftInputPipeline::Reset()
+{
+	for (FAxisState& State : Axes)
+	{
+		State.RawValue = 0.0f;
+		State.SmoothedValue = 0.0f;
+		State.PendingChangeTime = 0.0;
+		State.PendingFromValue = 0.0f;
+	}
+}
+
+void FAircraftInputPipeline::GetRecentFrames(TArray<FAircraftInputFrame>& OutFrames) const
+{
+	OutFrames.Reset();
+
+	const uint32 NumFrames = FMath::Min<uint32>(LatestFrame.Sequence, HistorySize);
+	for (uint32 Sequence = LatestFrame.Sequence - NumFrames + 1; Sequence <= LatestFrame.Sequence; ++Sequence)
+	{
+		OutFrames.Add(History[Sequence % HistorySize]);
+	}
+}
+
+#pragma region ConsoleCommands
+static FAutoConsoleCommandWithWorldAndArgs GAircraftInputReportCommand
+(
+	TEXT("Aircraft.Input.Report"),
+	TEXT("Logs input-to-flight latency of locally piloted aircraft: from an axis change to the flight step that applied 90% of the smoothed response to it. Usage: Aircraft.Input.Report [reset]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (World == nullptr) return;
+
+		const bool bReset = Args.Num() > 0 && Args[0].Equals(TEXT("reset"), ESearchCase::IgnoreCase);
+		for (TActorIterator<AAircraft> It(World); It; ++It)
+		{
+			if (It->IsLocallyControlled() == false || It->IsPlayerControlled() == false) continue;
+
+			FAircraftInputPipeline& Pipeline = It->GetInputPipeline();
+			const FAircraftInputPipeline::FLatencyReport& Report = Pipeline.GetLatencyReport();
+			UE_LOG(LogTemp, Log, TEXT("Aircraft.Input %s: %llu changes applied, latency to 90%% response avg %.2f ms, max %.2f ms, last frame #%u"),
+				*It->GetName(), Report.Samples, Report.Samples > 0 ? Report.TotalSeconds * 1000.0 / Report.Samples : 0.0, Report.MaxSeconds * 1000.0,
+				Pipeline.GetLatestFrame().Sequence);
+
+			if (bReset)
+			{
+				Pipeline.ResetLatencyReport();
+			}
+		}
+	})
+);
+#pragma endregion
@@ -0,0 +1,134 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * FAircraftInputPipeline turns a pilot's raw analog axes into the flight input the integrator reads.
+ * Input bindings only record the latest raw value and when it changed. Sample runs once per frame before the
+ * flight step and takes every axis through the same chain: deadzone (rescaled so the output still starts at 0),
+ * expo curve, then exponential smoothing. Each sample is kept as a timestamped FAircraftInputFrame in a short
+ * history, for later use by client prediction or server reconciliation.
+ * A raw change counts as responded to once the smoothed output has covered ResponseFraction (90%) of the way from
+ * where it was to the new shaped target, so the latency includes the smoothing lag and not just the frame that first
+ * moved the output. After the flight step has moved the aircraft, NotifyApplied measures from the oldest raw change
+ * the frame responded to. The result goes to the per-pipeline totals (Aircraft.Input.Report) and to
+ * FAircraftInputPipeline::OnInputApplied for external instrumentation.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AircraftInputPipeline.generated.h"
+
+UENUM()
+enum class EAircraftInputAxis : uint8
+{
+	EAIA_Throttle	UMETA(DisplayName = "Throttle"),
+	EAIA_Pitch		UMETA(DisplayName = "Pitch"),
+	EAIA_Yaw		UMETA(DisplayName = "Yaw"),
+	EAIA_Roll		UMETA(DisplayName = "Roll"),
+
+	EAIA_MAX		UMETA(Hidden)
+};
+
+/*Response curve of one axis*/
+USTRUCT(BlueprintType)
+struct FAircraftAxisResponse
+{
+	GENERATED_BODY()
+
+	/*Raw deflection below this is treated as centred*/
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.0", ClampMax = "0.9"))
+	float Deadzone = 0.1f;
+
+	/*0 is linear, 1 is fully cubic: finer control around centre, same full deflection*/
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float Expo = 0.3f;
+
+	/*Time constant of the smoothing in seconds; 0 passes the shaped value straight through*/
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.0"))
+	float SmoothingTime = 0.05f;
+
+	UPROPERTY(EditAnywhere)
+	bool bInvert = false;
+};
+
+/*One sampled set of pilot input*/
+struct FAircraftInputFrame
+{
+	/*Increases by one per sample*/
+	uint32 Sequence = 0;
+
+	/*FPlatformTime::Seconds at sampling, and the replicated server clock for matching the frame up across the network*/
+	double SampleTime = 0.0;
+	double ServerTime = 0.0;
+
+	/*Oldest raw change whose response this frame is the first to reach ResponseFraction of; 0 when none did*/
+	double OldestChangeTime = 0.0;
+
+	float Axes[(int32)EAircraftInputAxis::EAIA_MAX] = {};
+
+	float GetAxis(EAircraftInputAxis Axis) const { return Axes[(int32)Axis]; }
+};
+
+/*Frame that reached the flight step and the seconds from its oldest raw change to the step applying its response*/
+DECLARE_MULTICAST_DELEGATE_TwoParams(FAircraftInputAppliedHook, const FAircraftInputFrame&, double);
+
+class AIRCRAFT_API FAircraftInputPipeline
+{
+public:
+	void SetResponse(EAircraftInputAxis Axis, const FAircraftAxisResponse& Response) { Axes[(int32)Axis].Response = Response; }
+
+	/*Called from the input bindings; the value is kept until the next Sample*/
+	void SetRawAxis(EAircraftInputAxis Axis, float Value);
+
+	/*Shapes and smooths every axis once for this frame and records the result in the history*/
+	const FAircraftInputFrame& Sample(float DeltaTime, double ServerTime);
+
+	/*Call once the flight step that consumed the latest frame has been applied*/
+	void NotifyApplied();
+
+	/*Drops held deflection and smoothing state, e.g. when the pilot leaves*/
+	void Reset();
+
+	const FAircraftInputFrame& GetLatestFrame() const { return LatestFrame; }
+
+	/*Up to HistorySize most recent frames, newest last*/
+	void GetRecentFrames(TArray<FAircraftInputFrame>& OutFrames) const;
+
+	struct FLatencyReport
+	{
+		uint64 Samples = 0;
+		double TotalSeconds = 0.0;
+		double MaxSeconds = 0.0;
+	};
+
+	const FLatencyReport& GetLatencyReport() const { return LatencyReport; }
+	void ResetLatencyReport() { LatencyReport = FLatencyReport(); }
+
+	static float ApplyResponse(float RawValue, const FAircraftAxisResponse& Response);
+
+	static FAircraftInputAppliedHook OnInputApplied;
+
+	static constexpr int32 HistorySize = 64;
+
+	/*Share of the step towards a new shaped target the output must cover before a change counts as applied*/
+	static constexpr float ResponseFraction = 0.9f;
+
+private:
+	struct FAxisState
+	{
+		FAircraftAxisResponse Response;
+		float RawValue = 0.0f;
+		float SmoothedValue = 0.0f;
+
+		/*When RawValue first changed since the output last responded, and the smoothed value at that time*/
+		double PendingChangeTime = 0.0;
+		float PendingFromValue = 0.0f;
+	};
+
+	FAxisState Axes[(int32)EAircraftInputAxis::EAIA_MAX];
+
+	FAircraftInputFrame LatestFrame;
+	FAircraftInputFrame History[HistorySize];
+
+	FLatencyReport LatencyReport;
+};
@@ -0,0 +1,98 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * FAircraftLatencyHistogram records durations in microseconds into fixed log-linear buckets, in the style of
+ * HdrHistogram: values below SubBuckets are exact, and every power of two above is split into SubBuckets linear
+ * buckets, so a recorded value is kept to within 1/SubBuckets (6.25%) of itself from 1 us to MaxMicroseconds with no
+ * samples stored. Recording is a log2 and an increment; percentiles walk the buckets. Histograms merge by adding
+ * counts, which is how UAircraftHealthMonitor builds its rolling windows out of short slices.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAircraftLatencyHistogram
+{
+	static constexpr int32 SubBucketBits = 4;
+	static constexpr int32 SubBuckets = 1 << SubBucketBits;
+
+	/*About 16.8 seconds; longer values are recorded as this*/
+	static constexpr uint32 MaxMicroseconds = (1u << 24) - 1;
+	static constexpr int32 NumBuckets = (24 - SubBucketBits + 1) * SubBuckets;
+
+	void Record(uint32 Microseconds)
+	{
+		Microseconds = FMath::Min(Microseconds, MaxMicroseconds);
+		++Counts[GetBucketIndex(Microseconds)];
+		++Count;
+		TotalMicroseconds += Microseconds;
+		MaxValue = FMath::Max(MaxValue, Microseconds);
+	}
+
+	void Merge(const FAircraftLatencyHistogram& Other)
+	{
+		if (Other.Count == 0) return;
+
+		for (int32 Index = 0; Index < NumBuckets; ++Index)
+		{
+			Counts[Index] += Other.Counts[Index];
+		}
+		Count += Other.Count;
+		TotalMicroseconds += Other.TotalMicroseconds;
+		MaxValue = FMath::Max(MaxValue, Other.MaxValue);
+	}
+
+	void Reset()
+	{
+		FMemory::Memzero(Counts, sizeof(Counts));
+		Count = 0;
+		TotalMicroseconds = 0;
+		MaxValue = 0;
+	}
+
+	/*Upper bound of the bucket holding the given fraction of samples, e.g. 0.99 for p99; never above the recorded max*/
+	uint32 GetPercentile(double Fraction) const
+	{
+		if (Count == 0) return 0;
+
+		const uint64 Target = FMath::Max<uint64>((uint64)FMath::CeilToDouble(FMath::Clamp(Fraction, 0.0, 1.0) * Count), 1);
+		uint64 Seen = 0;
+		for (int32 Index = 0; Index < NumBuckets; ++Index)
+		{
+			Seen += Counts[Index];
+			if (Seen >= Target)
+			{
+				return FMath::Min(GetBucketUpperBound(Index), MaxValue);
+			}
+		}
+		return MaxValue;
+	}
+
+	uint64 GetCount() const { return Count; }
+	uint32 GetMax() const { return MaxValue; }
+	double GetMean() const { return Count > 0 ? (double)TotalMicroseconds / Count : 0.0; }
+
+	static int32 GetBucketIndex(uint32 Microseconds)
+	{
+		if (Microseconds < (uint32)SubBuckets) return (int32)Microseconds;
+
+		const int32 Shift = (int32)FMath::FloorLog2(Microseconds) - SubBucketBits;
+		return (Shift + 1) * SubBuckets + (int32)(Microseconds >> Shift) - SubBuckets;
+	}
+
+	static uint32 GetBucketUpperBound(int32 Index)
+	{
+		if (Index < SubBuckets) return (uint32)Index;
+
+		const int32 Shift = Index / SubBuckets - 1;
+		const uint32 LowerBound = (uint32)(Index % SubBuckets + SubBuckets) << Shift;
+		return LowerBound + (1u << Shift) - 1;
+	}
+
+private:
+	uint32 Counts[NumBuckets] = {};
+	uint64 Count = 0;
+	uint64 TotalMicroseconds = 0;
+	uint32 MaxValue = 0;
+};
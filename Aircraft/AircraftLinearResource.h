@@ -0,0 +1,86 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * FAircraftLinearResource is a continuously changing stat (booster fuel, shield) stored as the value it had at a
+ * server timestamp plus the rate it has changed at since. The current value is evaluated on read and clamped to
+ * [0, MaxValue], so nothing ticks it. Only a rate change rebases it (boost on or off, damage, regeneration
+ * starting), which is also the only time the owning actor needs to replicate it: clients evaluate the same
+ * triple against the replicated server clock and see the value move smoothly without further traffic.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AircraftLinearResource.generated.h"
+
+USTRUCT()
+struct AIRCRAFT_API FAircraftLinearResource
+{
+	GENERATED_BODY()
+
+	FAircraftLinearResource() = default;
+	FAircraftLinearResource(float InValue, float InMaxValue)
+		: BaseValue(InValue)
+		, MaxValue(InMaxValue)
+	{
+	}
+
+	float GetValue(double ServerTime) const
+	{
+		/*The elapsed time is taken in double; a float server clock loses milliseconds after a few hours of uptime*/
+		return FMath::Clamp(BaseValue + Rate * (float)FMath::Max(ServerTime - BaseTime, 0.0), 0.0f, MaxValue);
+	}
+
+	float GetRate() const { return Rate; }
+	float GetMaxValue() const { return MaxValue; }
+
+	/*Seconds from ServerTime until the value reaches 0 or MaxValue, negative while it is not changing or already there*/
+	float GetTimeToLimit(double ServerTime) const
+	{
+		if (Rate == 0.0f) return -1.0f;
+
+		const float Value = GetValue(ServerTime);
+		const float Remaining = Rate > 0.0f ? MaxValue - Value : -Value;
+		return Remaining / Rate > 0.0f ? Remaining / Rate : -1.0f;
+	}
+
+	/*Both return whether anything replicated changed, so the caller knows when to mark the property dirty*/
+	bool SetRate(double ServerTime, float NewRate)
+	{
+		if (NewRate == Rate) return false;
+
+		Rebase(ServerTime, GetValue(ServerTime));
+		Rate = NewRate;
+		return true;
+	}
+
+	bool SetValue(double ServerTime, float NewValue, float NewRate = 0.0f)
+	{
+		const float ClampedValue = FMath::Clamp(NewValue, 0.0f, MaxValue);
+		if (ClampedValue == GetValue(ServerTime) && NewRate == Rate) return false;
+
+		Rebase(ServerTime, ClampedValue);
+		Rate = NewRate;
+		return true;
+	}
+
+private:
+	void Rebase(double ServerTime, float Value)
+	{
+		BaseValue = Value;
+		BaseTime = ServerTime;
+	}
+
+	UPROPERTY()
+	float BaseValue = 0.0f;
+
+	UPROPERTY()
+	float Rate = 0.0f;
+
+	UPROPERTY()
+	double BaseTime = 0.0;
+
+	/*Known to both sides from the class defaults, never sent*/
+	UPROPERTY(NotReplicated)
+	float MaxValue = 0.0f;
+};
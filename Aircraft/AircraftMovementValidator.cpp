@@ -0,0 +1,320 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+
+#include "AircraftMovementValidator.h"
+
+#include "Aircraft.h"
+#include "AircraftStats.h"
+
+#include "Async/Async.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/GameSession.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+
+DECLARE_CYCLE_STAT(TEXT("Movement Sampling"),						STAT_AircraftMovementSampling,			STATGROUP_Aircraft);
+DECLARE_CYCLE_STAT(TEXT("Movement Validation (Worker)"),				STAT_AircraftMovementValidation,		STATGROUP_Aircraft);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Movement Samples Validated"),		STAT_AircraftMovementSamplesValidated,	STATGROUP_Aircraft);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Movement Violations"),				STAT_AircraftMovementViolations,		STATGROUP_Aircraft);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Validation Cost Per Aircraft (us)"),	STAT_AircraftValidationCostPerAircraft,	STATGROUP_Aircraft);
+
+#pragma region SampleHistory
+void UAircraftMovementValidator::FSampleHistory::Add(const FAircraftMovementSample& Sample)
+{
+	if (Samples.Num() < SampleCapacity)
+	{
+		Samples.Add(Sample);
+	}
+	else
+	{
+		Samples[NextIndex] = Sample;
+	}
+	NextIndex = (NextIndex + 1) % SampleCapacity;
+}
+
+void UAircraftMovementValidator::FSampleHistory::Reset()
+{
+	Samples.Reset();
+	NextIndex = 0;
+}
+
+void UAircraftMovementValidator::FSampleHistory::CopyUnvalidated(TArray<FAircraftMovementSample>& OutSamples) const
+{
+	const int32 NumSamples = Samples.Num();
+	const int32 OldestIndex = NumSamples < SampleCapacity ? 0 : NextIndex;
+
+	for (int32 Offset = 0; Offset < NumSamples; ++Offset)
+	{
+		const FAircraftMovementSample& Sample = Samples[(OldestIndex + Offset) % SampleCapacity];
+		if (Sample.Time <= LastValidatedTime)
+		{
+			/*Keep only the newest validated sample as the baseline for the first new one*/
+			OutSamples.Reset();
+		}
+		OutSamples.Add(Sample);
+	}
+}
+#pragma endregion
+
+bool UAircraftMovementValidator::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && World->GetNetMode() != NM_Client;
+}
+
+void UAircraftMovementValidator::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	UAircraftWorkScheduler* WorkScheduler = Collection.InitializeDependency<UAircraftWorkScheduler>();
+	if (WorkScheduler)
+	{
+		SampleWork = WorkScheduler->RegisterWork(EAircraftWorkPriority::EAWP_High, SampleInterval, SampleInterval * 2.0f, FAircraftWorkDelegate::CreateWeakLambda(this, [this](float SinceLastRun)
+		{
+			SampleAircraft(GetWorld()->GetTimeSeconds());
+		}));
+	}
+}
+
+void UAircraftMovementValidator::Deinitialize()
+{
+	if (UAircraftWorkScheduler* WorkScheduler = GetWorld()->GetSubsystem<UAircraftWorkScheduler>())
+	{
+		WorkScheduler->UnregisterWork(SampleWork);
+	}
+	if (PendingValidation.IsValid())
+	{
+		PendingValidation.Wait();
+	}
+	Histories.Reset();
+	OnMovementViolation.Clear();
+
+	Super::Deinitialize();
+}
+
+TStatId UAircraftMovementValidator::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAircraftMovementValidator, STATGROUP_Aircraft);
+}
+
+void UAircraftMovementValidator::RegisterAircraft(AAircraft* Aircraft)
+{
+	if (Aircraft == nullptr) return;
+	if (Histories.ContainsByPredicate([Aircraft](const FSampleHistory& History) { return History.Aircraft == Aircraft; })) return;
+
+	FSampleHistory& History = Histories.AddDefaulted_GetRef();
+	History.Aircraft = Aircraft;
+}
+
+void UAircraftMovementValidator::UnregisterAircraft(AAircraft* Aircraft)
+{
+	Histories.RemoveAllSwap([Aircraft](const FSampleHistory& History) { return History.Aircraft == Aircraft; });
+}
+
+void UAircraftMovementValidator::Tick(float DeltaTime)
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	/*Never queue a second pass behind a running one; the next tick picks the samples up instead*/
+	if (Now >= NextValidationTime && (PendingValidation.IsValid() == false || PendingValidation.IsCompleted()))
+	{
+		NextValidationTime = Now + ValidationInterval;
+		LaunchValidation();
+	}
+}
+
+void UAircraftMovementValidator::SampleAircraft(double Now)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AircraftMovementSampling);
+
+	Histories.RemoveAllSwap([](const FSampleHistory& History) { return History.Aircraft.IsValid() == false; });
+
+	for (FSampleHistory& History : Histories)
+	{
+		AAircraft* Aircraft = History.Aircraft.Get();
+
+		/*Teleports between pooling, parking and take-off must not read as movement*/
+		if (Aircraft->GetActivityState() != EAircraftActivityState::EAAS_Flying)
+		{
+			History.Reset();
+			History.LastValidatedTime = Now;
+			continue;
+		}
+
+		FAircraftMovementSample Sample;
+		Sample.Time = Now;
+		Aircraft->FillMovementSample(Sample);
+		History.Add(Sample);
+	}
+}
+
+void UAircraftMovementValidator::LaunchValidation()
+{
+	TArray<FValidationJob> Jobs;
+	Jobs.Reserve(Histories.Num());
+
+	for (const FSampleHistory& History : Histories)
+	{
+		const AAircraft* Aircraft = History.Aircraft.Get();
+		if (Aircraft == nullptr) continue;
+
+		FValidationJob Job;
+		History.CopyUnvalidated(Job.Samples);
+		if (Job.Samples.Num() < 2) continue;
+
+		Job.Aircraft = History.Aircraft;
+		Aircraft->GetFlightEnvelope(Job.Envelope);
+		Jobs.Add(MoveTemp(Job));
+	}
+
+	if (Jobs.Num() == 0) return;
+
+	TWeakObjectPtr<UAircraftMovementValidator> WeakThis(this);
+	const float JobTolerance = Tolerance;
+
+	PendingValidation = UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, JobTolerance, Jobs = MoveTemp(Jobs)]()
+	{
+		const double StartTime = FPlatformTime::Seconds();
+
+		TArray<FValidationResult> Results;
+		RunValidation(Jobs, JobTolerance, Results);
+
+		const double CostPerAircraft = (FPlatformTime::Seconds() - StartTime) * 1000000.0 / Jobs.Num();
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, CostPerAircraft, Results = MoveTemp(Results)]()
+		{
+			if (UAircraftMovementValidator* Validator = WeakThis.Get())
+			{
+				Validator->ApplyValidationResults(Results, CostPerAircraft);
+			}
+		});
+	});
+}
+
+void UAircraftMovementValidator::RunValidation(const TArray<FValidationJob>& Jobs, float Tolerance, TArray<FValidationResult>& OutResults)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AircraftMovementValidation);
+
+	OutResults.Reserve(Jobs.Num());
+	for (const FValidationJob& Job : Jobs)
+	{
+		FValidationResult& Result = OutResults.AddDefaulted_GetRef();
+		Result.Aircraft = Job.Aircraft;
+		Result.ValidatedUntil = Job.Samples.Last().Time;
+
+		const float AllowedSpeed		= Job.Envelope.MaxSpeed * Tolerance;
+		const float AllowedAcceleration	= Job.Envelope.MaxAcceleration * Tolerance;
+		const float AllowedTurnRate		= Job.Envelope.MaxTurnRateRadians * Tolerance;
+
+		auto AddViolation = [&Result](EAircraftMovementViolation Violation, float Measured, float Allowed, const FAircraftMovementSample& Previous, const FAircraftMovementSample& Sample)
+		{
+			if (Result.Violations.Num() == 0)
+			{
+				Result.LastValidSample = Previous;
+			}
+			Result.Violations.Add({ Violation, Measured, Allowed, Sample });
+		};
+
+		float PreviousSpeed = -1.0f;
+		for (int32 Index = 1; Index < Job.Samples.Num(); ++Index)
+		{
+			const FAircraftMovementSample& Previous	= Job.Samples[Index - 1];
+			const FAircraftMovementSample& Current	= Job.Samples[Index];
+
+			const float DeltaTime = static_cast<float>(Current.Time - Previous.Time);
+			if (DeltaTime <= KINDA_SMALL_NUMBER) continue;
+
+			const float Speed = FVector::Dist(Current.Location, Previous.Location) / DeltaTime;
+			if (Speed > AllowedSpeed)
+			{
+				AddViolation(EAircraftMovementViolation::EAMV_Speed, Speed, AllowedSpeed, Previous, Current);
+			}
+
+			if (PreviousSpeed >= 0.0f)
+			{
+				const float Acceleration = FMath::Abs(Speed - PreviousSpeed) / DeltaTime;
+				if (Acceleration > AllowedAcceleration)
+				{
+					AddViolation(EAircraftMovementViolation::EAMV_Acceleration, Acceleration, AllowedAcceleration, Previous, Current);
+				}
+			}
+			PreviousSpeed = Speed;
+
+			const float TurnRate = static_cast<float>(Previous.Rotation.AngularDistance(Current.Rotation)) / DeltaTime;
+			if (TurnRate > AllowedTurnRate)
+			{
+				AddViolation(EAircraftMovementViolation::EAMV_TurnRate, TurnRate, AllowedTurnRate, Previous, Current);
+			}
+		}
+
+		INC_DWORD_STAT_BY(STAT_AircraftMovementSamplesValidated, Job.Samples.Num() - 1);
+	}
+}
+
+void UAircraftMovementValidator::ApplyValidationResults(const TArray<FValidationResult>& Results, double CostPerAircraftMicroseconds)
+{
+	LastCostPerAircraftMicroseconds = static_cast<float>(CostPerAircraftMicroseconds);
+	SET_FLOAT_STAT(STAT_AircraftValidationCostPerAircraft, LastCostPerAircraftMicroseconds);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	for (const FValidationResult& Result : Results)
+	{
+		FSampleHistory* History = Histories.FindByPredicate([&Result](const FSampleHistory& Entry) { return Entry.Aircraft == Result.Aircraft; });
+		AAircraft* Aircraft = Result.Aircraft.Get();
+		if (History == nullptr || Aircraft == nullptr) continue;
+
+		History->LastValidatedTime = FMath::Max(History->LastValidatedTime, Result.ValidatedUntil);
+
+		if (Result.Violations.Num() == 0) continue;
+		INC_DWORD_STAT_BY(STAT_AircraftMovementViolations, Result.Violations.Num());
+
+		/*Every violating pass is corrected; the samples since are dropped so the move back is not measured as one*/
+		Aircraft->CorrectMovement(Result.LastValidSample);
+		History->Reset();
+
+		if (Now - History->LastReportTime < MinSecondsBetweenReports) continue;
+		History->LastReportTime = Now;
+		++History->NumReports;
+
+		/*Report the worst offence of the pass, relative to what the envelope allows*/
+		const FAircraftMovementViolationReport* WorstViolation = &Result.Violations[0];
+		for (const FAircraftMovementViolationReport& Violation : Result.Violations)
+		{
+			if (Violation.MeasuredValue / Violation.AllowedValue > WorstViolation->MeasuredValue / WorstViolation->AllowedValue)
+			{
+				WorstViolation = &Violation;
+			}
+		}
+
+		const APlayerState* PilotState = Aircraft->GetPlayerState();
+		UE_LOG(LogTemp, Warning, TEXT("AircraftMovementValidator: %s (%s) %s %.1f exceeds %.1f"),
+			*GetNameSafe(Aircraft),
+			PilotState ? *PilotState->GetPlayerName() : TEXT("no pilot"),
+			*UEnum::GetValueAsString(WorstViolation->Violation),
+			WorstViolation->MeasuredValue,
+			WorstViolation->AllowedValue);
+
+		/*Read before broadcasting; a listener may unregister the aircraft and with it the history*/
+		const bool bKick = History->NumReports >= MaxReportsBeforeKick;
+		OnMovementViolation.Broadcast(Aircraft, *WorstViolation);
+
+		if (bKick && IsValid(Aircraft))
+		{
+			KickPilot(Aircraft);
+		}
+	}
+}
+
+void UAircraftMovementValidator::KickPilot(AAircraft* Aircraft)
+{
+	/*Bots have no session to leave; they are only ever corrected*/
+	APlayerController* PilotController = Cast<APlayerController>(Aircraft->GetController());
+	AGameModeBase* GameMode = GetWorld()->GetAuthGameMode();
+	if (PilotController == nullptr || GameMode == nullptr || GameMode->GameSession == nullptr) return;
+
+	const APlayerState* PilotState = PilotController->GetPlayerState<APlayerState>();
+	UE_LOG(LogTemp, Warning, TEXT("AircraftMovementValidator: kicking %s after %d movement reports"), PilotState ? *PilotState->GetPlayerName() : *GetNameSafe(PilotController), MaxReportsBeforeKick);
+	GameMode->GameSession->KickPlayer(PilotController, NSLOCTEXT("Aircraft", "MovementViolationKick", "Kicked for invalid aircraft movement."));
+}
@@ -0,0 +1,140 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * UAircraftMovementValidator checks piloted aircraft against their flight model on the server.
+ * Positions, rotations and pilot inputs are sampled into a small ring buffer per aircraft at a fixed rate.
+ * Periodically the unvalidated samples are handed to a worker task which checks speed, acceleration and
+ * turn rate against the reachable envelope of each aircraft. Violations come back to the game thread, where the
+ * aircraft is put back at its last valid sample. Reports are rate limited per aircraft, logged and broadcast
+ * through OnMovementViolation; a human pilot reported MaxReportsBeforeKick times is kicked from the session.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tasks/Task.h"
+#include "AircraftWorkScheduler.h"
+#include "AircraftMovementValidator.generated.h"
+
+class AAircraft;
+
+struct FAircraftMovementSample
+{
+	double Time = 0.0;
+	FVector Location = FVector::ZeroVector;
+	FQuat Rotation = FQuat::Identity;
+
+	/*Pilot inputs at the time of the sample, kept for the violation report*/
+	float Throttle = 0.0f;
+	float Pitch = 0.0f;
+	float Yaw = 0.0f;
+	float Roll = 0.0f;
+	bool bBoostActivated = false;
+};
+
+/*Upper bounds the flight model can reach, derived from the aircraft's tuning values*/
+struct FAircraftFlightEnvelope
+{
+	float MaxSpeed = 0.0f;
+	float MaxAcceleration = 0.0f;
+	float MaxTurnRateRadians = 0.0f;
+};
+
+UENUM()
+enum class EAircraftMovementViolation : uint8
+{
+	EAMV_Speed			UMETA(DisplayName = "Speed"),
+	EAMV_Acceleration	UMETA(DisplayName = "Acceleration"),
+	EAMV_TurnRate		UMETA(DisplayName = "TurnRate")
+};
+
+struct FAircraftMovementViolationReport
+{
+	EAircraftMovementViolation Violation = EAircraftMovementViolation::EAMV_Speed;
+	float MeasuredValue = 0.0f;
+	float AllowedValue = 0.0f;
+	FAircraftMovementSample Sample;
+};
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnAircraftMovementViolation, AAircraft* /*Aircraft*/, const FAircraftMovementViolationReport& /*Report*/);
+
+UCLASS()
+class AIRCRAFT_API UAircraftMovementValidator : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterAircraft(AAircraft* Aircraft);
+	void UnregisterAircraft(AAircraft* Aircraft);
+
+	/*Worker time of the last validation pass divided by the number of aircraft it covered*/
+	float GetLastCostPerAircraftMicroseconds() const { return LastCostPerAircraftMicroseconds; }
+
+	FOnAircraftMovementViolation OnMovementViolation;
+
+private:
+	static constexpr int32 SampleCapacity = 64;
+
+	struct FSampleHistory
+	{
+		TWeakObjectPtr<AAircraft> Aircraft;
+		TArray<FAircraftMovementSample, TFixedAllocator<SampleCapacity>> Samples;
+		int32 NextIndex = 0;
+		double LastValidatedTime = 0.0;
+		double LastReportTime = -DBL_MAX;
+		int32 NumReports = 0;
+
+		void Add(const FAircraftMovementSample& Sample);
+		void Reset();
+		/*Appends the samples newer than LastValidatedTime oldest first, plus the one before them as a baseline*/
+		void CopyUnvalidated(TArray<FAircraftMovementSample>& OutSamples) const;
+	};
+
+	/*Jobs carry the weak pointer only to route results back; the worker never dereferences it*/
+	struct FValidationJob
+	{
+		TWeakObjectPtr<AAircraft> Aircraft;
+		FAircraftFlightEnvelope Envelope;
+		TArray<FAircraftMovementSample> Samples;
+	};
+
+	struct FValidationResult
+	{
+		TWeakObjectPtr<AAircraft> Aircraft;
+		double ValidatedUntil = 0.0;
+		TArray<FAircraftMovementViolationReport> Violations;
+
+		/*The sample just before the first violation, where a correction puts the aircraft back*/
+		FAircraftMovementSample LastValidSample;
+	};
+
+	static void RunValidation(const TArray<FValidationJob>& Jobs, float Tolerance, TArray<FValidationResult>& OutResults);
+
+	void SampleAircraft(double Now);
+	void LaunchValidation();
+	void ApplyValidationResults(const TArray<FValidationResult>& Results, double CostPerAircraftMicroseconds);
+	void KickPilot(AAircraft* Aircraft);
+
+	TArray<FSampleHistory> Histories;
+
+	UE::Tasks::FTask PendingValidation;
+
+	/*Sampling runs as high-priority work on UAircraftWorkScheduler, every SampleInterval and at worst every other one*/
+	FAircraftWorkHandle SampleWork;
+	double NextValidationTime = 0.0;
+	float LastCostPerAircraftMicroseconds = 0.0f;
+
+	/*Tuning*/
+	float SampleInterval = 1.0f / 20.0f;
+	float ValidationInterval = 0.5f;
+	float Tolerance = 1.25f;
+	float MinSecondsBetweenReports = 5.0f;
+	int32 MaxReportsBeforeKick = 3;
+};
@@ -0,0 +1,166 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+
+#include "AircraftNetStatsSubsystem.h"
+
+#include "Aircraft.h"
+#include "AircraftBotController.h"
+#include "AircraftStats.h"
+
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/PackageMapClient.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/GameStateBase.h"
+#include "HAL/FileManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+
+bool UAircraftNetStatsSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	FString OutputPrefix;
+	return World && World->IsGameWorld() && FParse::Value(FCommandLine::Get(), TEXT("AircraftNetStats="), OutputPrefix);
+}
+
+void UAircraftNetStatsSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FString OutputPrefix;
+	FParse::Value(FCommandLine::Get(), TEXT("AircraftNetStats="), OutputPrefix);
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(OutputPrefix), true);
+
+	PositionsWriter.Reset(IFileManager::Get().CreateFileWriter(*(OutputPrefix + TEXT("_positions.csv"))));
+	CorrectionsWriter.Reset(IFileManager::Get().CreateFileWriter(*(OutputPrefix + TEXT("_corrections.csv"))));
+	ConnectionsWriter.Reset(IFileManager::Get().CreateFileWriter(*(OutputPrefix + TEXT("_connections.csv"))));
+
+	WriteLine(PositionsWriter.Get(), TEXT("time,aircraft,x,y,z,speed,role"));
+	WriteLine(CorrectionsWriter.Get(), TEXT("time,aircraft,snap_distance"));
+	WriteLine(ConnectionsWriter.Get(), TEXT("time,connection,out_bytes_per_second,in_bytes_per_second,ping_ms,packet_loss_out,packet_loss_in,open_channels"));
+}
+
+void UAircraftNetStatsSubsystem::Deinitialize()
+{
+	PositionsWriter.Reset();
+	CorrectionsWriter.Reset();
+	ConnectionsWriter.Reset();
+	ConnectionIndices.Reset();
+	BotAircraft.Reset();
+
+	Super::Deinitialize();
+}
+
+void UAircraftNetStatsSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	int32 NumBots = 0;
+	if (InWorld.GetNetMode() != NM_Client && FParse::Value(FCommandLine::Get(), TEXT("AircraftNetBots="), NumBots) && NumBots > 0)
+	{
+		if (const TSubclassOf<AAircraft> BotClass = AAircraftBotController::LoadBotAircraftClass(FCommandLine::Get()))
+		{
+			AAircraftBotController::SpawnBotSwarm(&InWorld, BotClass, NumBots, 50000.0f, 20000.0f, BotAircraft);
+		}
+	}
+}
+
+TStatId UAircraftNetStatsSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAircraftNetStatsSubsystem, STATGROUP_Aircraft);
+}
+
+void UAircraftNetStatsSubsystem::Tick(float DeltaTime)
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	if (Now >= NextPositionSampleTime)
+	{
+		NextPositionSampleTime = Now + PositionSampleInterval;
+		WritePositions();
+	}
+
+	if (Now >= NextConnectionSampleTime)
+	{
+		NextConnectionSampleTime = Now + ConnectionSampleInterval;
+		WriteConnections();
+	}
+}
+
+double UAircraftNetStatsSubsystem::GetSyncedTime() const
+{
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	return GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+}
+
+uint32 UAircraftNetStatsSubsystem::GetAircraftNetId(const AAircraft* Aircraft) const
+{
+	/*Network GUIDs match between server and clients, unlike actor names of dynamically spawned aircraft*/
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	return NetDriver && NetDriver->GuidCache.IsValid() ? NetDriver->GuidCache->GetNetGUID(Aircraft).Value : Aircraft->GetUniqueID();
+}
+
+void UAircraftNetStatsSubsystem::WritePositions()
+{
+	const double Time = GetSyncedTime();
+
+	for (TActorIterator<AAircraft> It(GetWorld()); It; ++It)
+	{
+		const AAircraft* Aircraft = *It;
+		if (Aircraft->GetActivityState() == EAircraftActivityState::EAAS_Parked) continue;
+
+		const FVector Location = Aircraft->GetActorLocation();
+		WriteLine(PositionsWriter.Get(), FString::Printf(TEXT("%.4f,%u,%.1f,%.1f,%.1f,%.1f,%s"),
+			Time, GetAircraftNetId(Aircraft), Location.X, Location.Y, Location.Z, Aircraft->GetVelocity().Size(),
+			Aircraft->HasAuthority() ? TEXT("authority") : (Aircraft->IsLocallyControlled() ? TEXT("autonomous") : TEXT("simulated"))));
+	}
+}
+
+void UAircraftNetStatsSubsystem::WriteConnections()
+{
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (NetDriver == nullptr) return;
+
+	const double Time = GetSyncedTime();
+	TArray<TPair<const UNetConnection*, FString>, TInlineAllocator<16>> Connections;
+	if (NetDriver->ServerConnection)
+	{
+		Connections.Add({ NetDriver->ServerConnection, TEXT("server") });
+	}
+	for (const UNetConnection* ClientConnection : NetDriver->ClientConnections)
+	{
+		if (ClientConnection == nullptr) continue;
+
+		const int32* ExistingIndex = ConnectionIndices.Find(ClientConnection);
+		const int32 ConnectionIndex = ExistingIndex ? *ExistingIndex : ConnectionIndices.Add(ClientConnection, ConnectionIndices.Num());
+		Connections.Add({ ClientConnection, FString::Printf(TEXT("client%d"), ConnectionIndex) });
+	}
+
+	for (const TPair<const UNetConnection*, FString>& Entry : Connections)
+	{
+		const UNetConnection* Connection = Entry.Key;
+		WriteLine(ConnectionsWriter.Get(), FString::Printf(TEXT("%.4f,%s,%d,%d,%.1f,%.4f,%.4f,%d"),
+			Time,
+			*Entry.Value,
+			Connection->OutBytesPerSecond,
+			Connection->InBytesPerSecond,
+			Connection->AvgLag * 1000.0,
+			Connection->GetOutLossPercentage().GetAvgLossPercentage(),
+			Connection->GetInLossPercentage().GetAvgLossPercentage(),
+			Connection->OpenChannels.Num()));
+	}
+}
+
+void UAircraftNetStatsSubsystem::RecordCorrection(const AAircraft* Aircraft, const FVector& PreviousLocation, const FVector& NewLocation)
+{
+	WriteLine(CorrectionsWriter.Get(), FString::Printf(TEXT("%.4f,%u,%.2f"), GetSyncedTime(), GetAircraftNetId(Aircraft), FVector::Dist(PreviousLocation, NewLocation)));
+}
+
+void UAircraftNetStatsSubsystem::WriteLine(FArchive* Writer, const FString& Line)
+{
+	if (Writer == nullptr) return;
+
+	FTCHARToUTF8 Utf8Line(*(Line + TEXT("\n")));
+	Writer->Serialize(const_cast<ANSICHAR*>(Utf8Line.Get()), Utf8Line.Length());
+}
@@ -0,0 +1,64 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * UAircraftNetStatsSubsystem records how aircraft replication behaves for offline analysis.
+ * It only exists when the process is started with -AircraftNetStats=<OutputPrefix> and writes three CSV files:
+ *   <prefix>_positions.csv    aircraft positions at 20 Hz, keyed by network GUID and server world time
+ *   <prefix>_corrections.csv  every replicated movement update received by a client and the snap distance it caused
+ *   <prefix>_connections.csv  per-connection in/out bytes per second and open channels once a second, keyed "server"
+ *                             on clients and "client<N>" in join order on the server, so runs can be compared
+ * Servers and clients write the same position format, so the two views of each aircraft can be compared.
+ * With -AircraftNetBots=<N> -AircraftBotClass=<Blueprint class path> the server also spawns N bot-piloted aircraft
+ * to generate flights and weapon fire; without a bot class it spawns none and logs an error.
+ * Tools/aircraft_net_harness.py launches the processes and turns the files into a report.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AircraftNetStatsSubsystem.generated.h"
+
+class AAircraft;
+class UNetConnection;
+
+UCLASS()
+class AIRCRAFT_API UAircraftNetStatsSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/*Called by AAircraft when a replicated movement update moves a simulated aircraft*/
+	void RecordCorrection(const AAircraft* Aircraft, const FVector& PreviousLocation, const FVector& NewLocation);
+
+private:
+	double GetSyncedTime() const;
+	uint32 GetAircraftNetId(const AAircraft* Aircraft) const;
+
+	void WritePositions();
+	void WriteConnections();
+	static void WriteLine(FArchive* Writer, const FString& Line);
+
+	TUniquePtr<FArchive> PositionsWriter;
+	TUniquePtr<FArchive> CorrectionsWriter;
+	TUniquePtr<FArchive> ConnectionsWriter;
+
+	UPROPERTY()
+	TArray<AAircraft*> BotAircraft;
+
+	/*Join order of each client connection seen by the server; addresses and ports change from run to run*/
+	TMap<TWeakObjectPtr<const UNetConnection>, int32> ConnectionIndices;
+
+	double NextPositionSampleTime = 0.0;
+	double NextConnectionSampleTime = 0.0;
+
+	float PositionSampleInterval = 1.0f / 20.0f;
+	float ConnectionSampleInterval = 1.0f;
+};
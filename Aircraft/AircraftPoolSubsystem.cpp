@@ -0,0 +1,153 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+
+#include "AircraftPoolSubsystem.h"
+
+#include "Aircraft.h"
+#include "AircraftAssetPreloadSubsystem.h"
+#include "AircraftStats.h"
+#include "AircraftTimerWheel.h"
+#include "AircraftWreck.h"
+
+#include "Engine/World.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pooled Aircraft Reused"),	STAT_AircraftPoolReused,	STATGROUP_Aircraft);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pooled Aircraft Spawned"),	STAT_AircraftPoolSpawned,	STATGROUP_Aircraft);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pooled Wrecks Spawned"),	STAT_AircraftWreckSpawned,	STATGROUP_Aircraft);
+
+bool UAircraftPoolSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UAircraftPoolSubsystem::Deinitialize()
+{
+	PooledAircraft.Reset();
+	PooledWrecks.Reset();
+	ActiveWrecks.Reset();
+
+	Super::Deinitialize();
+}
+
+#pragma region Aircraft
+AAircraft* UAircraftPoolSubsystem::AcquireAircraft(TSubclassOf<AAircraft> AircraftClass, const FTransform& SpawnTransform)
+{
+	UWorld* World = GetWorld();
+	if (World == nullptr || AircraftClass == nullptr) return nullptr;
+
+	PrunePooledAircraft();
+	const int32 PooledIndex = PooledAircraft.IndexOfByPredicate([AircraftClass](const AAircraft* Aircraft)
+	{
+		return Aircraft->GetClass() == AircraftClass;
+	});
+
+	if (PooledIndex != INDEX_NONE)
+	{
+		AAircraft* Aircraft = PooledAircraft[PooledIndex];
+		PooledAircraft.RemoveAtSwap(PooledIndex);
+
+		Aircraft->ResetForReuse(SpawnTransform);
+		INC_DWORD_STAT(STAT_AircraftPoolReused);
+		return Aircraft;
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	INC_DWORD_STAT(STAT_AircraftPoolSpawned);
+	return World->SpawnActor<AAircraft>(AircraftClass, SpawnTransform, SpawnParameters);
+}
+
+void UAircraftPoolSubsystem::AcquireAircraftAsync(TSubclassOf<AAircraft> AircraftClass, const FTransform& SpawnTransform, TFunction<void(AAircraft*)> OnAcquired)
+{
+	UWorld* World = GetWorld();
+	UAircraftAssetPreloadSubsystem* PreloadSubsystem = World ? World->GetSubsystem<UAircraftAssetPreloadSubsystem>() : nullptr;
+	if (PreloadSubsystem == nullptr)
+	{
+		AAircraft* Aircraft = AcquireAircraft(AircraftClass, SpawnTransform);
+		if (OnAcquired) OnAcquired(Aircraft);
+		return;
+	}
+
+	PreloadSubsystem->WhenAircraftClassReady(AircraftClass, FSimpleDelegate::CreateWeakLambda(this, [this, AircraftClass, SpawnTransform, OnAcquired = MoveTemp(OnAcquired)]()
+	{
+		AAircraft* Aircraft = AcquireAircraft(AircraftClass, SpawnTransform);
+		if (OnAcquired) OnAcquired(Aircraft);
+	}));
+}
+
+void UAircraftPoolSubsystem::ReleaseAircraft(AAircraft* Aircraft)
+{
+	if (IsValid(Aircraft) == false) return;
+
+	PrunePooledAircraft();
+	if (PooledAircraft.Num() >= MaxPooledAircraft)
+	{
+		Aircraft->Destroy();
+		return;
+	}
+
+	Aircraft->DeactivateForPool();
+	PooledAircraft.AddUnique(Aircraft);
+}
+
+void UAircraftPoolSubsystem::PrunePooledAircraft()
+{
+	/*Pooled aircraft can still be destroyed from outside, e.g. by a streaming level unloading; they would otherwise hold pool slots*/
+	PooledAircraft.RemoveAllSwap([](const AAircraft* Aircraft) { return IsValid(Aircraft) == false; });
+}
+#pragma endregion
+
+#pragma region Wrecks
+AAircraftWreck* UAircraftPoolSubsystem::AcquireWreck(UStaticMesh* Mesh, const FTransform& Transform, const FVector& Velocity, float Lifetime)
+{
+	UWorld* World = GetWorld();
+	if (World == nullptr) return nullptr;
+
+	AAircraftWreck* Wreck = nullptr;
+	while (PooledWrecks.Num() > 0 && Wreck == nullptr)
+	{
+		Wreck = PooledWrecks.Pop(false);
+		if (IsValid(Wreck) == false)
+		{
+			Wreck = nullptr;
+		}
+	}
+
+	if (Wreck == nullptr)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		Wreck = World->SpawnActor<AAircraftWreck>(AAircraftWreck::StaticClass(), Transform, SpawnParameters);
+		if (Wreck == nullptr) return nullptr;
+		INC_DWORD_STAT(STAT_AircraftWreckSpawned);
+	}
+
+	Wreck->ActivateWreck(Mesh, Transform, Velocity);
+	ActiveWrecks.Add(Wreck);
+
+	if (UAircraftTimerWheelSubsystem* TimerWheel = World->GetSubsystem<UAircraftTimerWheelSubsystem>())
+	{
+		Wreck->LifetimeTimer = TimerWheel->SetTimer(Lifetime, FSimpleDelegate::CreateWeakLambda(this, [this, WeakWreck = TWeakObjectPtr<AAircraftWreck>(Wreck)]()
+		{
+			ReleaseWreck(WeakWreck.Get());
+		}));
+	}
+	return Wreck;
+}
+
+void UAircraftPoolSubsystem::ReleaseWreck(AAircraftWreck* Wreck)
+{
+	if (IsValid(Wreck) == false || Wreck->IsWreckActive() == false) return;
+
+	if (UAircraftTimerWheelSubsystem* TimerWheel = GetWorld()->GetSubsystem<UAircraftTimerWheelSubsystem>())
+	{
+		TimerWheel->ClearTimer(Wreck->LifetimeTimer);
+	}
+	Wreck->DeactivateWreck();
+	ActiveWrecks.RemoveSwap(Wreck);
+	PooledWrecks.Add(Wreck);
+}
+#pragma endregion
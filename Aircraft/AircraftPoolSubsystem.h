@@ -0,0 +1,58 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * UAircraftPoolSubsystem recycles destroyed aircraft and their wrecks on the server.
+ * A destroyed AAircraft is reset and parked in the pool instead of being destroyed, and the wreck
+ * that replaces it on screen is taken from a pool of AAircraftWreck proxies. Respawning an aircraft
+ * of a class that is already pooled therefore costs a reset instead of a full SpawnActor.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AircraftPoolSubsystem.generated.h"
+
+class AAircraft;
+class AAircraftWreck;
+class UStaticMesh;
+
+UCLASS()
+class AIRCRAFT_API UAircraftPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+
+/*Aircraft*/
+	/*Returns a pooled aircraft of exactly this class reset at the transform, or spawns a new one*/
+	AAircraft* AcquireAircraft(TSubclassOf<AAircraft> AircraftClass, const FTransform& SpawnTransform);
+
+	/*Same as AcquireAircraft, but waits for the class's preload bundle so the aircraft never spawns with assets still loading*/
+	void AcquireAircraftAsync(TSubclassOf<AAircraft> AircraftClass, const FTransform& SpawnTransform, TFunction<void(AAircraft*)> OnAcquired);
+	void ReleaseAircraft(AAircraft* Aircraft);
+
+/*Wrecks*/
+	AAircraftWreck* AcquireWreck(UStaticMesh* Mesh, const FTransform& Transform, const FVector& Velocity, float Lifetime);
+	void ReleaseWreck(AAircraftWreck* Wreck);
+
+	int32 GetNumPooledAircraft() const { return PooledAircraft.Num(); }
+	int32 GetNumPooledWrecks() const { return PooledWrecks.Num(); }
+
+private:
+	void PrunePooledAircraft();
+
+	UPROPERTY()
+	TArray<AAircraft*> PooledAircraft;
+
+	UPROPERTY()
+	TArray<AAircraftWreck*> PooledWrecks;
+
+	UPROPERTY()
+	TArray<AAircraftWreck*> ActiveWrecks;
+
+	/*Upper bound on idle aircraft kept per world; extra releases are destroyed*/
+	int32 MaxPooledAircraft = 32;
+};
@@ -0,0 +1,123 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+
+#include "AircraftRocketImpactSubsystem.h"
+
+#include "ProjectileRocket.h"
+
+#include "Engine/World.h"
+
+#pragma region Relay
+AAircraftRocketImpactRelay::AAircraftRocketImpactRelay()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	/*NetWorking*/
+	bReplicates = true;
+	bAlwaysRelevant = true;
+	SetReplicatingMovement(false);
+	NetUpdateFrequency = 1.0f;
+}
+
+void AAircraftRocketImpactRelay::BeginPlay()
+{
+	Super::BeginPlay();
+
+	/*Clients learn about the relay only when it replicates in*/
+	if (UAircraftRocketImpactSubsystem* ImpactSubsystem = UAircraftRocketImpactSubsystem::Get(this))
+	{
+		ImpactSubsystem->Relay = this;
+	}
+}
+
+void AAircraftRocketImpactRelay::Multicast_RocketImpact_Implementation(uint32 RocketId, TSubclassOf<AProjectileRocket> RocketClass, FVector_NetQuantize ImpactLocation)
+{
+	if (HasAuthority()) return;
+
+	if (UAircraftRocketImpactSubsystem* ImpactSubsystem = UAircraftRocketImpactSubsystem::Get(this))
+	{
+		ImpactSubsystem->HandleRocketImpact(RocketId, RocketClass, ImpactLocation);
+	}
+}
+#pragma endregion
+
+#pragma region Subsystem
+bool UAircraftRocketImpactSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UAircraftRocketImpactSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (InWorld.GetNetMode() == NM_Client || InWorld.GetNetMode() == NM_Standalone) return;
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	Relay = InWorld.SpawnActor<AAircraftRocketImpactRelay>(AAircraftRocketImpactRelay::StaticClass(), FTransform::Identity, SpawnParameters);
+}
+
+void UAircraftRocketImpactSubsystem::Deinitialize()
+{
+	Relay = nullptr;
+	CosmeticRockets.Reset();
+
+	Super::Deinitialize();
+}
+
+uint32 UAircraftRocketImpactSubsystem::AllocateSalvoSequence()
+{
+	const uint32 Sequence = NextSalvoSequence;
+	NextSalvoSequence = NextSalvoSequence == MaxSalvoSequence ? 1 : NextSalvoSequence + 1;
+	return Sequence;
+}
+
+void UAircraftRocketImpactSubsystem::SendRocketImpact(uint32 RocketId, TSubclassOf<AProjectileRocket> RocketClass, const FVector& ImpactLocation)
+{
+	if (Relay)
+	{
+		Relay->Multicast_RocketImpact(RocketId, RocketClass, ImpactLocation);
+	}
+}
+
+void UAircraftRocketImpactSubsystem::RegisterCosmeticRocket(uint32 RocketId, AProjectileRocket* Rocket)
+{
+	CosmeticRockets.Add(RocketId, Rocket);
+}
+
+void UAircraftRocketImpactSubsystem::HandleRocketImpact(uint32 RocketId, TSubclassOf<AProjectileRocket> RocketClass, const FVector& ImpactLocation)
+{
+	TWeakObjectPtr<AProjectileRocket> Rocket;
+	CosmeticRockets.RemoveAndCopyValue(RocketId, Rocket);
+
+	if (Rocket.IsValid())
+	{
+		Rocket->ApplyServerImpact(ImpactLocation);
+	}
+	else if (RocketClass)
+	{
+		/*The salvo that launched it was lost or the local copy is gone; the explosion is still shown*/
+		RocketClass->GetDefaultObject<AProjectileRocket>()->SpawnImpactEffects(GetWorld(), FTransform(ImpactLocation));
+	}
+
+	/*Rockets that expired without an impact event leave stale entries behind*/
+	for (auto It = CosmeticRockets.CreateIterator(); It; ++It)
+	{
+		if (It->Value.IsValid() == false) It.RemoveCurrent();
+	}
+}
+
+uint32 UAircraftRocketImpactSubsystem::MakeRocketId(uint32 SalvoSequence, int32 HardpointIndex, int32 RoundIndex)
+{
+	/*Hardpoint index below AircraftHardpoint::Count (2 bits), round index below 64 (6 bits, the salvo's round count limit)*/
+	return ((SalvoSequence & MaxSalvoSequence) << 8) | ((uint32)(HardpointIndex & 0x3) << 6) | (uint32)(RoundIndex & 0x3F);
+}
+
+UAircraftRocketImpactSubsystem* UAircraftRocketImpactSubsystem::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UAircraftRocketImpactSubsystem>() : nullptr;
+}
+#pragma endregion
@@ -0,0 +1,76 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * UAircraftRocketImpactSubsystem carries rocket impacts from the server to clients independently of the aircraft that
+ * fired them. Every machine simulates a rocket locally from its salvo event, so the impact is the only per-rocket
+ * message. The server spawns one always-relevant AAircraftRocketImpactRelay per world and multicasts impacts through
+ * it, so an impact still arrives after the launching fighter has gone dormant, been pooled or left relevancy. Clients
+ * keep their locally simulated rockets by id until the impact arrives.
+ *
+ * Rocket ids are unique per world: the server numbers rocket salvos from one 24-bit world-wide sequence, and the low
+ * 8 bits hold the hardpoint and the round within the salvo.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "GameFramework/Info.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AircraftRocketImpactSubsystem.generated.h"
+
+class AProjectileRocket;
+
+UCLASS(NotPlaceable, Transient)
+class AIRCRAFT_API AAircraftRocketImpactRelay : public AInfo
+{
+	GENERATED_BODY()
+
+public:
+	AAircraftRocketImpactRelay();
+
+	virtual void BeginPlay() override;
+
+	UFUNCTION(NetMulticast, Reliable)
+	void Multicast_RocketImpact(uint32 RocketId, TSubclassOf<AProjectileRocket> RocketClass, FVector_NetQuantize ImpactLocation);
+};
+
+UCLASS()
+class AIRCRAFT_API UAircraftRocketImpactSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+/*Server*/
+	/*Numbers the next rocket salvo; never 0, which turret salvos carry*/
+	uint32 AllocateSalvoSequence();
+
+	/*The server's rocket hit; every client settles its local copy against it*/
+	void SendRocketImpact(uint32 RocketId, TSubclassOf<AProjectileRocket> RocketClass, const FVector& ImpactLocation);
+
+/*Client*/
+	void RegisterCosmeticRocket(uint32 RocketId, AProjectileRocket* Rocket);
+	void HandleRocketImpact(uint32 RocketId, TSubclassOf<AProjectileRocket> RocketClass, const FVector& ImpactLocation);
+
+	/*Derived from the salvo, so the server's and each client's copy of a rocket share one*/
+	static uint32 MakeRocketId(uint32 SalvoSequence, int32 HardpointIndex, int32 RoundIndex);
+
+	static UAircraftRocketImpactSubsystem* Get(const UObject* WorldContextObject);
+
+private:
+	friend class AAircraftRocketImpactRelay;
+
+	static constexpr uint32 MaxSalvoSequence = (1u << 24) - 1;
+
+	UPROPERTY()
+	AAircraftRocketImpactRelay* Relay = nullptr;
+
+	/*Locally simulated rockets in flight, by id, waiting for their impact event*/
+	TMap<uint32, TWeakObjectPtr<AProjectileRocket>> CosmeticRockets;
+
+	uint32 NextSalvoSequence = 1;
+};
@@ -0,0 +1,43 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+
+#include "AircraftSalvo.h"
+
+void FAircraftSalvoEvent::QuantizeTransform()
+{
+	MeshLocation = FVector(FMath::RoundToDouble(MeshLocation.X * 10.0) / 10.0, FMath::RoundToDouble(MeshLocation.Y * 10.0) / 10.0, FMath::RoundToDouble(MeshLocation.Z * 10.0) / 10.0);
+	MeshRotation = FRotator
+	(
+		FRotator::DecompressAxisFromShort(FRotator::CompressAxisToShort(MeshRotation.Pitch)),
+		FRotator::DecompressAxisFromShort(FRotator::CompressAxisToShort(MeshRotation.Yaw)),
+		FRotator::DecompressAxisFromShort(FRotator::CompressAxisToShort(MeshRotation.Roll))
+	);
+}
+
+bool FAircraftSalvoEvent::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	/*Weapon: 1 bit, hardpoints: 3 bits, rounds per hardpoint: 6 bits*/
+	uint32 Header = 0;
+	if (Ar.IsSaving())
+	{
+		Header = ((uint32)Weapon & 0x1) | ((uint32)(HardpointMask & 0x7) << 1) | ((uint32)FMath::Min<uint8>(RoundCount, 63) << 4);
+	}
+	Ar.SerializeBits(&Header, 10);
+	if (Ar.IsLoading())
+	{
+		Weapon = (EAircraftWeapon)(Header & 0x1);
+		HardpointMask = (uint8)((Header >> 1) & 0x7);
+		RoundCount = (uint8)((Header >> 4) & 0x3F);
+	}
+
+	Ar << QuantizedFirstRoundAge;
+	Ar << ServerTime;
+	Ar << RandomSeed;
+	Ar.SerializeIntPacked(Sequence);
+
+	bOutSuccess = true;
+	MeshLocation.NetSerialize(Ar, Map, bOutSuccess);
+	MeshRotation.SerializeCompressedShort(Ar);
+
+	return bOutSuccess;
+}
@@ -0,0 +1,87 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * FAircraftSalvoEvent describes every round one weapon fired in one server frame, compactly enough that a shooter's
+ * whole frame of fire fits in a single unreliable multicast instead of one replicated actor channel per projectile.
+ * It carries the weapon, the hardpoints that fired, the round count and the age of the first round, the server time
+ * of the frame, the quantized mesh transform the hardpoint sockets are resolved against, and the random seed used for
+ * spread. Clients rebuild the same rounds deterministically as cosmetic, non-replicated projectiles.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "AircraftSalvo.generated.h"
+
+UENUM()
+enum class EAircraftWeapon : uint8
+{
+	EAW_Turret	UMETA(DisplayName = "Turret"),
+	EAW_Rocket	UMETA(DisplayName = "Rocket")
+};
+
+/*Hardpoint bits, per weapon; they index the socket tables in AFighterAircraft*/
+namespace AircraftHardpoint
+{
+	static constexpr uint8 Right	= 1 << 0;
+	static constexpr uint8 Left		= 1 << 1;
+	static constexpr uint8 Middle	= 1 << 2;
+	static constexpr int32 Count	= 3;
+}
+
+USTRUCT()
+struct AIRCRAFT_API FAircraftSalvoEvent
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	EAircraftWeapon Weapon = EAircraftWeapon::EAW_Turret;
+
+	UPROPERTY()
+	uint8 HardpointMask = 0;
+
+	/*Rounds per hardpoint; consecutive rounds are exactly one fire interval apart*/
+	UPROPERTY()
+	uint8 RoundCount = 0;
+
+	/*Age of the first round at the end of the server frame, in 1/10 ms*/
+	UPROPERTY()
+	uint16 QuantizedFirstRoundAge = 0;
+
+	UPROPERTY()
+	float ServerTime = 0.0f;
+
+	UPROPERTY()
+	FVector_NetQuantize10 MeshLocation;
+
+	UPROPERTY()
+	FRotator MeshRotation = FRotator::ZeroRotator;
+
+	UPROPERTY()
+	uint16 RandomSeed = 0;
+
+	/*World-wide number of a rocket salvo, 0 for turret salvos; rocket ids are derived from it so they never repeat
+	  between salvos the way the 16-bit seed can*/
+	UPROPERTY()
+	uint32 Sequence = 0;
+
+	void SetFirstRoundAge(float Age) { QuantizedFirstRoundAge = (uint16)FMath::Clamp(FMath::RoundToInt(Age * 10000.0f), 0, (int32)MAX_uint16); }
+	float GetFirstRoundAge() const { return QuantizedFirstRoundAge / 10000.0f; }
+
+	/*Rounds the transform to what NetSerialize transmits, so the server spawns from exactly what clients receive*/
+	void QuantizeTransform();
+
+	/*Packs the header into 10 bits, the rotation into 16-bit components and the sequence as a packed int; about 20 bytes
+	  per turret event and up to 3 more per rocket event*/
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FAircraftSalvoEvent> : public TStructOpsTypeTraitsBase2<FAircraftSalvoEvent>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
@@ -0,0 +1,90 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+
+#include "AircraftShardGhost.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+
+AAircraftShardGhost::AAircraftShardGhost()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	GhostMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("GhostMesh"));
+	SetRootComponent(GhostMesh);
+
+	GhostMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	GhostMesh->SetGenerateOverlapEvents(false);
+	GhostMesh->SetHiddenInGame(true);
+
+	/*NetWorking*/
+	bReplicates = true;
+	SetReplicateMovement(true);
+	NetUpdateFrequency = 10.0f;
+	NetCullDistanceSquared = 1400000000.0f;
+}
+
+void AAircraftShardGhost::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams PushModelParams;
+	PushModelParams.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(AAircraftShardGhost, ReplicatedMesh, PushModelParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AAircraftShardGhost, bGhostActive, PushModelParams);
+}
+
+void AAircraftShardGhost::ActivateGhost(UStaticMesh* Mesh)
+{
+	ReplicatedMesh = Mesh;
+	bGhostActive = true;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAircraftShardGhost, ReplicatedMesh, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAircraftShardGhost, bGhostActive, this);
+
+	ApplyGhostState();
+}
+
+void AAircraftShardGhost::DeactivateGhost()
+{
+	bGhostActive = false;
+	GhostVelocity = FVector::ZeroVector;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAircraftShardGhost, bGhostActive, this);
+
+	ApplyGhostState();
+}
+
+void AAircraftShardGhost::UpdateGhost(const FVector& Location, const FRotator& Rotation, const FVector& Velocity)
+{
+	SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+	GhostVelocity = Velocity;
+}
+
+void AAircraftShardGhost::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	/*Dead reckoning until the owning shard's next update*/
+	AddActorWorldOffset(GhostVelocity * DeltaTime);
+}
+
+void AAircraftShardGhost::OnRep_GhostState()
+{
+	ApplyGhostState();
+}
+
+void AAircraftShardGhost::ApplyGhostState()
+{
+	if (GhostMesh)
+	{
+		GhostMesh->SetStaticMesh(ReplicatedMesh);
+		GhostMesh->SetHiddenInGame(bGhostActive == false);
+	}
+
+	/*Clients follow the replicated movement; only the server extrapolates*/
+	SetActorTickEnabled(bGhostActive && HasAuthority());
+}
@@ -0,0 +1,52 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * AAircraftShardGhost stands in for an aircraft simulated by a neighbouring airspace shard while that aircraft is
+ * close to the shared border. It is a single collision-free static mesh driven by the positions the owning shard
+ * sends; between updates it extrapolates along the last reported velocity. Ghosts replicate to this shard's
+ * clients like any actor, so players see aircraft on the other side of the border.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "AircraftShardGhost.generated.h"
+
+class UStaticMesh;
+class UStaticMeshComponent;
+
+UCLASS()
+class AIRCRAFT_API AAircraftShardGhost : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AAircraftShardGhost();
+
+	virtual void Tick(float DeltaTime) override;
+	virtual void GetLifetimeReplicatedProps(TArray< FLifetimeProperty >& OutLifetimeProps) const override;
+
+	void ActivateGhost(UStaticMesh* Mesh);
+	void DeactivateGhost();
+	void UpdateGhost(const FVector& Location, const FRotator& Rotation, const FVector& Velocity);
+
+	bool IsGhostActive() const { return bGhostActive; }
+
+private:
+	UPROPERTY(VisibleAnywhere)
+	UStaticMeshComponent* GhostMesh;
+
+	UPROPERTY(ReplicatedUsing = OnRep_GhostState)
+	UStaticMesh* ReplicatedMesh = nullptr;
+
+	UPROPERTY(ReplicatedUsing = OnRep_GhostState)
+	bool bGhostActive = false;
+
+	/*Server only, from the owning shard's last update*/
+	FVector GhostVelocity = FVector::ZeroVector;
+
+	UFUNCTION()
+	void OnRep_GhostState();
+	void ApplyGhostState();
+};
@@ -0,0 +1,786 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+
+#include "AircraftShardSubsystem.h"
+
+#include "Aircraft.h"
+#include "AircraftBotController.h"
+#include "AircraftPoolSubsystem.h"
+#include "AircraftShardGhost.h"
+#include "AircraftStats.h"
+
+#include "Common/UdpSocketBuilder.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "IPAddress.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Shard Receive"),					STAT_AircraftShardReceive,		STATGROUP_Aircraft);
+DECLARE_CYCLE_STAT(TEXT("Shard Handoff Scan"),				STAT_AircraftShardHandoffScan,	STATGROUP_Aircraft);
+DECLARE_CYCLE_STAT(TEXT("Shard Send Ghosts"),				STAT_AircraftShardSendGhosts,	STATGROUP_Aircraft);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Shard Handoffs"),			STAT_AircraftShardHandoffs,		STATGROUP_Aircraft);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Shard Ghosts"),		STAT_AircraftShardGhosts,		STATGROUP_Aircraft);
+
+enum class EAircraftShardMessage : uint8
+{
+	EASM_Handoff,
+	EASM_HandoffAck,
+	EASM_Ghosts,
+
+	EASM_MAX
+};
+
+/*Every datagram starts with this, so stray traffic on the port is ignored*/
+static constexpr uint16 ShardMessageMagic = 0xA5D7;
+static constexpr int32 MaxShardMessageBytes = 65507;
+static constexpr int32 MaxGhostsPerMessage = 256;
+
+static void WriteShardHeader(FBitWriter& Writer, EAircraftShardMessage Type, int32 FromShard)
+{
+	uint16 Magic = ShardMessageMagic;
+	uint8 TypeByte = (uint8)Type;
+	uint8 FromShardByte = (uint8)FromShard;
+	Writer << Magic << TypeByte << FromShardByte;
+}
+
+static bool ReadShardHeader(FBitReader& Reader, EAircraftShardMessage& OutType, int32& OutFromShard)
+{
+	uint16 Magic = 0;
+	uint8 TypeByte = 0;
+	uint8 FromShardByte = 0;
+	Reader << Magic << TypeByte << FromShardByte;
+
+	OutType = (EAircraftShardMessage)TypeByte;
+	OutFromShard = FromShardByte;
+	return Reader.IsError() == false && Magic == ShardMessageMagic && TypeByte < (uint8)EAircraftShardMessage::EASM_MAX;
+}
+
+static TArray<uint8> GetWrittenBytes(FBitWriter& Writer)
+{
+	return TArray<uint8>(Writer.GetData(), Writer.GetNumBytes());
+}
+
+bool UAircraftShardSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	int32 Index = 0;
+	int32 Count = 0;
+	return World && World->IsGameWorld() && IsRunningDedicatedServer()
+		&& FParse::Value(FCommandLine::Get(), TEXT("AircraftShard="), Index)
+		&& FParse::Value(FCommandLine::Get(), TEXT("AircraftShardCount="), Count);
+}
+
+void UAircraftShardSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	Collection.InitializeDependency<UAircraftPoolSubsystem>();
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	FParse::Value(CommandLine, TEXT("AircraftShard="), ShardIndex);
+	FParse::Value(CommandLine, TEXT("AircraftShardCount="), ShardCount);
+	FParse::Value(CommandLine, TEXT("AircraftShardPort="), BasePort);
+	FParse::Value(CommandLine, TEXT("AircraftShardBots="), NumBots);
+
+	FString BotClassPath;
+	if (NumBots > 0 || FParse::Value(CommandLine, TEXT("AircraftBotClass="), BotClassPath))
+	{
+		BotAircraftClass = AAircraftBotController::LoadBotAircraftClass(CommandLine);
+	}
+
+	float Width = (float)SlabWidth;
+	FParse::Value(CommandLine, TEXT("AircraftShardWidth="), Width);
+	SlabWidth = FMath::Max(Width, 2.0f * (HandoffMargin + GhostMargin));
+
+	/*The index travels as one byte in every message*/
+	ShardCount = FMath::Clamp(ShardCount, 1, (int32)MAX_uint8);
+	ShardIndex = FMath::Clamp(ShardIndex, 0, ShardCount - 1);
+
+	Socket = FUdpSocketBuilder(TEXT("AircraftShard"))
+		.AsNonBlocking()
+		.AsReusable()
+		.BoundToAddress(FIPv4Address::InternalLoopback)
+		.BoundToPort(BasePort + ShardIndex)
+		.WithReceiveBufferSize(4 * 1024 * 1024)
+		.WithSendBufferSize(4 * 1024 * 1024)
+		.Build();
+
+	if (Socket == nullptr)
+	{
+		UE_LOG(LogTemp, Error, TEXT("AircraftShard %d: could not bind UDP port %d, handoffs and ghosts are disabled"), ShardIndex, BasePort + ShardIndex);
+	}
+
+	for (int32 Index = 0; Index < ShardCount; ++Index)
+	{
+		PeerAddresses.Add(FIPv4Endpoint(FIPv4Address::InternalLoopback, BasePort + Index).ToInternetAddr());
+	}
+
+	FString OutputPrefix;
+	if (FParse::Value(CommandLine, TEXT("AircraftShardStats="), OutputPrefix))
+	{
+		IFileManager::Get().MakeDirectory(*FPaths::GetPath(OutputPrefix), true);
+		HandoffsWriter.Reset(IFileManager::Get().CreateFileWriter(*(OutputPrefix + TEXT("_handoffs.csv"))));
+		TicksWriter.Reset(IFileManager::Get().CreateFileWriter(*(OutputPrefix + TEXT("_ticks.csv"))));
+
+		WriteLine(HandoffsWriter.Get(), TEXT("time,handoff,direction,peer,bytes,attempts,latency_ms"));
+		WriteLine(TicksWriter.Get(), TEXT("time,actor_tick_ms,aircraft,ghosts"));
+	}
+
+	WorldTickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &UAircraftShardSubsystem::OnWorldTickStart);
+	WorldPostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UAircraftShardSubsystem::OnWorldPostActorTick);
+
+	UE_LOG(LogTemp, Log, TEXT("AircraftShard %d/%d: owns X [%.0f, %.0f), port %d"), ShardIndex, ShardCount, GetSlabMinX(ShardIndex), GetSlabMaxX(ShardIndex), BasePort + ShardIndex);
+}
+
+void UAircraftShardSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldTickStart.Remove(WorldTickStartHandle);
+	FWorldDelegates::OnWorldPostActorTick.Remove(WorldPostActorTickHandle);
+
+	if (Socket)
+	{
+		Socket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+		Socket = nullptr;
+	}
+
+	HandoffsWriter.Reset();
+	TicksWriter.Reset();
+	PendingHandoffs.Reset();
+	Ghosts.Reset();
+	FreeGhosts.Reset();
+
+	Super::Deinitialize();
+}
+
+void UAircraftShardSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (NumBots > 0 && BotAircraftClass)
+	{
+		/*Spawned around the origin, then moved into the middle of this shard's slab*/
+		TArray<AAircraft*> BotAircraft;
+		AAircraftBotController::SpawnBotSwarm(&InWorld, BotAircraftClass, NumBots, (float)SlabWidth * 0.4f, 20000.0f, BotAircraft);
+
+		const FVector SlabCentre((ShardIndex + 0.5 - ShardCount * 0.5) * SlabWidth, 0.0, 0.0);
+		for (AAircraft* Aircraft : BotAircraft)
+		{
+			Aircraft->SetActorLocation(Aircraft->GetActorLocation() + SlabCentre);
+		}
+	}
+}
+
+TStatId UAircraftShardSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAircraftShardSubsystem, STATGROUP_Aircraft);
+}
+
+double UAircraftShardSubsystem::GetSlabMinX(int32 Index) const
+{
+	return Index <= 0 ? TNumericLimits<double>::Lowest() : (Index - ShardCount * 0.5) * SlabWidth;
+}
+
+double UAircraftShardSubsystem::GetSlabMaxX(int32 Index) const
+{
+	return Index >= ShardCount - 1 ? TNumericLimits<double>::Max() : (Index + 1 - ShardCount * 0.5) * SlabWidth;
+}
+
+int32 UAircraftShardSubsystem::GetShardForX(double X) const
+{
+	return FMath::Clamp(FMath::FloorToInt(X / SlabWidth + ShardCount * 0.5), 0, ShardCount - 1);
+}
+
+void UAircraftShardSubsystem::Tick(float DeltaTime)
+{
+	/*Both sides of a handoff read the same machine-wide clock, so release and adoption times compare directly*/
+	const double Now = FPlatformTime::Seconds();
+
+	ReceiveMessages();
+	ScanForHandoffs();
+	UpdatePendingHandoffs(Now);
+
+	if (Now >= NextGhostSendTime)
+	{
+		NextGhostSendTime = Now + 1.0 / GhostRate;
+		SendGhosts();
+	}
+	ExpireGhosts(Now);
+
+	for (auto It = RecentlyAdopted.CreateIterator(); It; ++It)
+	{
+		if (Now - It.Value() > HandoffTimeout * 5.0f)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+#pragma region Messages
+void UAircraftShardSubsystem::ReceiveMessages()
+{
+	SCOPE_CYCLE_COUNTER(STAT_AircraftShardReceive);
+	if (Socket == nullptr) return;
+
+	TArray<uint8> Buffer;
+	Buffer.SetNumUninitialized(MaxShardMessageBytes);
+	TSharedRef<FInternetAddr> Sender = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->CreateInternetAddr();
+
+	uint32 PendingSize = 0;
+	while (Socket->HasPendingData(PendingSize))
+	{
+		int32 BytesRead = 0;
+		if (Socket->RecvFrom(Buffer.GetData(), Buffer.Num(), BytesRead, *Sender) == false || BytesRead <= 0) break;
+
+		FBitReader Reader(Buffer.GetData(), (int64)BytesRead * 8);
+		EAircraftShardMessage Type;
+		int32 FromShard = INDEX_NONE;
+		if (ReadShardHeader(Reader, Type, FromShard) == false || FromShard >= ShardCount || FromShard == ShardIndex) continue;
+
+		switch (Type)
+		{
+			case EAircraftShardMessage::EASM_Handoff:		HandleHandoff(FromShard, Reader);		break;
+			case EAircraftShardMessage::EASM_HandoffAck:	HandleHandoffAck(FromShard, Reader);	break;
+			case EAircraftShardMessage::EASM_Ghosts:		HandleGhosts(FromShard, Reader);		break;
+			default:																				break;
+		}
+	}
+}
+
+void UAircraftShardSubsystem::SendTo(int32 TargetShard, const TArray<uint8>& Message)
+{
+	if (Socket == nullptr || PeerAddresses.IsValidIndex(TargetShard) == false) return;
+
+	int32 BytesSent = 0;
+	Socket->SendTo(Message.GetData(), Message.Num(), BytesSent, *PeerAddresses[TargetShard]);
+}
+
+void UAircraftShardSubsystem::HandleHandoff(int32 FromShard, FBitReader& Reader)
+{
+	uint32 HandoffId = 0;
+	uint32 AircraftId = 0;
+	double ReleaseTime = 0.0;
+	Reader << HandoffId << AircraftId << ReleaseTime;
+	if (Reader.IsError()) return;
+
+	if (RecentlyAdopted.Contains(HandoffId) == false)
+	{
+		/*Not acknowledged if it cannot be adopted; the sender resends and eventually takes the aircraft back*/
+		if (AdoptAircraft(Reader, AircraftId) == nullptr) return;
+
+		const double Now = FPlatformTime::Seconds();
+		RecentlyAdopted.Add(HandoffId, Now);
+		RemoveGhost(AircraftId);
+		GhostSuppressedUntil.Add(AircraftId, Now + GhostTimeout);
+
+		const double Latency = Now - ReleaseTime;
+		++Report.HandoffsIn;
+		Report.TotalHandoffLatency += Latency;
+		Report.MaxHandoffLatency = FMath::Max(Report.MaxHandoffLatency, Latency);
+		INC_DWORD_STAT(STAT_AircraftShardHandoffs);
+		RecordHandoff(HandoffId, TEXT("in"), FromShard, (int32)(Reader.GetNumBits() / 8), 0, Latency);
+	}
+
+	/*Duplicates are acknowledged again, since the first acknowledgement may be the one that was lost*/
+	FBitWriter Writer(0, true);
+	WriteShardHeader(Writer, EAircraftShardMessage::EASM_HandoffAck, ShardIndex);
+	Writer << HandoffId;
+	SendTo(FromShard, GetWrittenBytes(Writer));
+}
+
+void UAircraftShardSubsystem::HandleHandoffAck(int32 FromShard, FBitReader& Reader)
+{
+	uint32 HandoffId = 0;
+	Reader << HandoffId;
+	if (Reader.IsError()) return;
+
+	const FPendingHandoff* Pending = PendingHandoffs.Find(HandoffId);
+	if (Pending == nullptr || Pending->TargetShard != FromShard) return;
+
+	RecordHandoff(HandoffId, TEXT("acked"), FromShard, Pending->Message.Num(), Pending->Attempts, FPlatformTime::Seconds() - Pending->ReleaseTime);
+	PendingHandoffs.Remove(HandoffId);
+}
+#pragma endregion
+
+#pragma region Handoff
+uint32 UAircraftShardSubsystem::GetAircraftId(const AAircraft* Aircraft)
+{
+	if (const uint32* ExistingId = AircraftIds.Find(Aircraft))
+	{
+		return *ExistingId;
+	}
+
+	/*The shard that first saw the aircraft in the top byte keeps ids unique without coordination*/
+	const uint32 AircraftId = ((uint32)(ShardIndex + 1) << 24) | (NextAircraftSerial++ & 0xFFFFFF);
+	AircraftIds.Add(Aircraft, AircraftId);
+	return AircraftId;
+}
+
+void UAircraftShardSubsystem::ScanForHandoffs()
+{
+	SCOPE_CYCLE_COUNTER(STAT_AircraftShardHandoffScan);
+
+	/*The margin keeps an aircraft flying along the border from bouncing between shards*/
+	const double MinX = GetSlabMinX(ShardIndex) - HandoffMargin;
+	const double MaxX = GetSlabMaxX(ShardIndex) + HandoffMargin;
+	const double Now = FPlatformTime::Seconds();
+
+	/*Aircraft destroyed or returned to the pool without a handoff would otherwise keep their entries forever*/
+	for (auto It = AircraftIds.CreateIterator(); It; ++It)
+	{
+		const AAircraft* Aircraft = It.Key().ResolveObjectPtr();
+		if (Aircraft == nullptr || Aircraft->IsInPool())
+		{
+			It.RemoveCurrent();
+		}
+	}
+	for (auto It = HandoffRetryTimes.CreateIterator(); It; ++It)
+	{
+		const AAircraft* Aircraft = It.Key().ResolveObjectPtr();
+		if (Aircraft == nullptr || Aircraft->IsInPool() || It.Value() <= Now)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	TArray<TPair<AAircraft*, int32>, TInlineAllocator<8>> LeavingAircraft;
+	NumOwnedAircraft = 0;
+
+	for (TActorIterator<AAircraft> It(GetWorld()); It; ++It)
+	{
+		AAircraft* Aircraft = *It;
+		const EAircraftActivityState State = Aircraft->GetActivityState();
+		if (State == EAircraftActivityState::EAAS_Parked || State == EAircraftActivityState::EAAS_Destroyed) continue;
+
+		++NumOwnedAircraft;
+		const double X = Aircraft->GetActorLocation().X;
+		if (X >= MinX && X < MaxX) continue;
+
+		if (HandoffRetryTimes.Contains(Aircraft)) continue;
+
+		const AController* Controller = Aircraft->GetController();
+		if (Controller && Controller->IsPlayerController())
+		{
+			++Report.BlockedHandoffs;
+			HandoffRetryTimes.Add(Aircraft, Now + HandoffTimeout);
+			continue;
+		}
+
+		LeavingAircraft.Add({ Aircraft, X < MinX ? ShardIndex - 1 : ShardIndex + 1 });
+	}
+
+	for (const TPair<AAircraft*, int32>& Leaving : LeavingAircraft)
+	{
+		HandOff(Leaving.Key, Leaving.Value);
+	}
+}
+
+void UAircraftShardSubsystem::HandOff(AAircraft* Aircraft, int32 TargetShard)
+{
+	UAircraftPoolSubsystem* PoolSubsystem = GetWorld()->GetSubsystem<UAircraftPoolSubsystem>();
+	if (PoolSubsystem == nullptr || Socket == nullptr) return;
+
+	const uint32 AircraftId = GetAircraftId(Aircraft);
+	uint32 HandoffId = ((uint32)(ShardIndex + 1) << 24) | (NextHandoffSerial++ & 0xFFFFFF);
+	double ReleaseTime = FPlatformTime::Seconds();
+
+	AController* Controller = Aircraft->GetController();
+	const bool bBotPiloted = Cast<AAircraftBotController>(Controller) != nullptr;
+
+	FBitWriter Writer(0, true);
+	WriteShardHeader(Writer, EAircraftShardMessage::EASM_Handoff, ShardIndex);
+
+	uint32 AircraftIdToWrite = AircraftId;
+	FString ClassPath = Aircraft->GetClass()->GetPathName();
+	FVector3f Location(Aircraft->GetActorLocation());
+	FRotator Rotation = Aircraft->GetActorRotation();
+
+	Writer << HandoffId << AircraftIdToWrite << ReleaseTime << ClassPath;
+	Writer.WriteBit(bBotPiloted);
+	Writer << Location;
+	Rotation.SerializeCompressedShort(Writer);
+	Aircraft->SerializeHandoffState(Writer);
+
+	FPendingHandoff& Pending = PendingHandoffs.Add(HandoffId);
+	Pending.TargetShard = TargetShard;
+	Pending.Message = GetWrittenBytes(Writer);
+	Pending.ReleaseTime = ReleaseTime;
+	Pending.LastSendTime = ReleaseTime;
+	Pending.Attempts = 1;
+	SendTo(TargetShard, Pending.Message);
+
+	/*The aircraft leaves this shard right away; the kept message is enough to bring it back if the neighbour never answers*/
+	AircraftIds.Remove(Aircraft);
+	PoolSubsystem->ReleaseAircraft(Aircraft);
+	if (bBotPiloted)
+	{
+		Controller->Destroy();
+	}
+
+	++Report.HandoffsOut;
+	INC_DWORD_STAT(STAT_AircraftShardHandoffs);
+}
+
+AAircraft* UAircraftShardSubsystem::AdoptAircraft(FBitReader& Reader, uint32 AircraftId)
+{
+	FString ClassPath;
+	FVector3f Location;
+	FRotator Rotation;
+
+	Reader << ClassPath;
+	const bool bBotPiloted = Reader.ReadBit() != 0;
+	Reader << Location;
+	Rotation.SerializeCompressedShort(Reader);
+	if (Reader.IsError()) return nullptr;
+
+	UWorld* World = GetWorld();
+	UAircraftPoolSubsystem* PoolSubsystem = World->GetSubsystem<UAircraftPoolSubsystem>();
+	/*Shards run the same map, so the class is normally preloaded already; a synchronous load here would stall the
+	  shard's receive loop, so an unloaded class is refused and the sender's timeout takes the aircraft back*/
+	UClass* AircraftClass = FindObject<UClass>(nullptr, *ClassPath);
+	if (PoolSubsystem == nullptr || AircraftClass == nullptr || AircraftClass->IsChildOf(AAircraft::StaticClass()) == false) return nullptr;
+
+	const FTransform SpawnTransform(Rotation, FVector(Location));
+	AAircraft* Aircraft = PoolSubsystem->AcquireAircraft(AircraftClass, SpawnTransform);
+	if (Aircraft == nullptr) return nullptr;
+
+	Aircraft->SerializeHandoffState(Reader);
+	if (Reader.IsError())
+	{
+		PoolSubsystem->ReleaseAircraft(Aircraft);
+		return nullptr;
+	}
+	AircraftIds.Add(Aircraft, AircraftId);
+
+	if (bBotPiloted)
+	{
+		FActorSpawnParameters ControllerSpawnParameters;
+		ControllerSpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		AAircraftBotController* BotController = World->SpawnActor<AAircraftBotController>(AAircraftBotController::StaticClass(), SpawnTransform, ControllerSpawnParameters);
+		BotController->Possess(Aircraft);
+	}
+	return Aircraft;
+}
+
+void UAircraftShardSubsystem::UpdatePendingHandoffs(double Now)
+{
+	for (auto It = PendingHandoffs.CreateIterator(); It; ++It)
+	{
+		FPendingHandoff& Pending = It.Value();
+
+		if (Now - Pending.ReleaseTime >= HandoffTimeout)
+		{
+			/*The neighbour is down or swamped; keep simulating the aircraft here rather than lose it*/
+			FBitReader Reader(Pending.Message.GetData(), (int64)Pending.Message.Num() * 8);
+			EAircraftShardMessage Type;
+			int32 FromShard = INDEX_NONE;
+			uint32 HandoffId = 0;
+			uint32 AircraftId = 0;
+			double ReleaseTime = 0.0;
+
+			if (ReadShardHeader(Reader, Type, FromShard))
+			{
+				Reader << HandoffId << AircraftId << ReleaseTime;
+				if (AAircraft* Aircraft = AdoptAircraft(Reader, AircraftId))
+				{
+					HandoffRetryTimes.Add(Aircraft, Now + HandoffTimeout);
+				}
+			}
+
+			++Report.HandoffsReturned;
+			RecordHandoff(It.Key(), TEXT("returned"), Pending.TargetShard, Pending.Message.Num(), Pending.Attempts, Now - Pending.ReleaseTime);
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (Now - Pending.LastSendTime >= HandoffResendInterval)
+		{
+			SendTo(Pending.TargetShard, Pending.Message);
+			Pending.LastSendTime = Now;
+			++Pending.Attempts;
+			++Report.Resends;
+		}
+	}
+}
+#pragma endregion
+
+#pragma region Ghosts
+void UAircraftShardSubsystem::SendGhosts()
+{
+	SCOPE_CYCLE_COUNTER(STAT_AircraftShardSendGhosts);
+	if (ShardCount <= 1 || Socket == nullptr) return;
+
+	for (const int32 Side : { -1, 1 })
+	{
+		const int32 Neighbour = ShardIndex + Side;
+		if (Neighbour < 0 || Neighbour >= ShardCount) continue;
+
+		const double BorderX = Side < 0 ? GetSlabMinX(ShardIndex) : GetSlabMaxX(ShardIndex);
+
+		TArray<AAircraft*, TInlineAllocator<64>> NearBorder;
+		for (TActorIterator<AAircraft> It(GetWorld()); It; ++It)
+		{
+			const EAircraftActivityState State = It->GetActivityState();
+			if (State == EAircraftActivityState::EAAS_Parked || State == EAircraftActivityState::EAAS_Destroyed) continue;
+
+			if (FMath::Abs(It->GetActorLocation().X - BorderX) <= GhostMargin)
+			{
+				NearBorder.Add(*It);
+			}
+		}
+
+		for (int32 First = 0; First < NearBorder.Num(); First += MaxGhostsPerMessage)
+		{
+			const int32 Count = FMath::Min(MaxGhostsPerMessage, NearBorder.Num() - First);
+
+			/*Class paths are sent once per message and referenced by index from each entry*/
+			TArray<UClass*, TInlineAllocator<4>> Classes;
+			for (int32 Index = First; Index < First + Count; ++Index)
+			{
+				Classes.AddUnique(NearBorder[Index]->GetClass());
+			}
+			if (Classes.Num() > MAX_uint8) continue;
+
+			FBitWriter Writer(0, true);
+			WriteShardHeader(Writer, EAircraftShardMessage::EASM_Ghosts, ShardIndex);
+
+			uint8 NumClasses = (uint8)Classes.Num();
+			Writer << NumClasses;
+			for (UClass* AircraftClass : Classes)
+			{
+				FString ClassPath = AircraftClass->GetPathName();
+				Writer << ClassPath;
+			}
+
+			uint16 NumEntries = (uint16)Count;
+			Writer << NumEntries;
+			for (int32 Index = First; Index < First + Count; ++Index)
+			{
+				AAircraft* Aircraft = NearBorder[Index];
+
+				uint32 AircraftId = GetAircraftId(Aircraft);
+				uint8 ClassIndex = (uint8)Classes.IndexOfByKey(Aircraft->GetClass());
+				FVector3f Location(Aircraft->GetActorLocation());
+				FRotator Rotation = Aircraft->GetActorRotation();
+
+				/*Whole centimetres per second are plenty for dead reckoning over one update interval*/
+				const FVector Velocity = Aircraft->GetFlightVelocity();
+				int16 QuantizedVelocity[3] =
+				{
+					(int16)FMath::Clamp(FMath::RoundToInt(Velocity.X), (int32)MIN_int16, (int32)MAX_int16),
+					(int16)FMath::Clamp(FMath::RoundToInt(Velocity.Y), (int32)MIN_int16, (int32)MAX_int16),
+					(int16)FMath::Clamp(FMath::RoundToInt(Velocity.Z), (int32)MIN_int16, (int32)MAX_int16)
+				};
+
+				Writer.SerializeIntPacked(AircraftId);
+				Writer << ClassIndex << Location;
+				Rotation.SerializeCompressedShort(Writer);
+				Writer << QuantizedVelocity[0] << QuantizedVelocity[1] << QuantizedVelocity[2];
+			}
+
+			SendTo(Neighbour, GetWrittenBytes(Writer));
+			Report.GhostUpdatesSent += Count;
+		}
+	}
+}
+
+void UAircraftShardSubsystem::HandleGhosts(int32 FromShard, FBitReader& Reader)
+{
+	uint8 NumClasses = 0;
+	Reader << NumClasses;
+
+	TArray<UStaticMesh*, TInlineAllocator<4>> ClassMeshes;
+	for (int32 Index = 0; Index < NumClasses && Reader.IsError() == false; ++Index)
+	{
+		FString ClassPath;
+		Reader << ClassPath;
+		ClassMeshes.Add(GetGhostMesh(ClassPath));
+	}
+
+	uint16 NumEntries = 0;
+	Reader << NumEntries;
+
+	UWorld* World = GetWorld();
+	const double Now = FPlatformTime::Seconds();
+	for (int32 Entry = 0; Entry < NumEntries; ++Entry)
+	{
+		uint32 AircraftId = 0;
+		uint8 ClassIndex = 0;
+		FVector3f Location;
+		FRotator Rotation;
+		int16 QuantizedVelocity[3] = {};
+
+		Reader.SerializeIntPacked(AircraftId);
+		Reader << ClassIndex << Location;
+		Rotation.SerializeCompressedShort(Reader);
+		Reader << QuantizedVelocity[0] << QuantizedVelocity[1] << QuantizedVelocity[2];
+		if (Reader.IsError() || ClassMeshes.IsValidIndex(ClassIndex) == false) break;
+
+		if (const double* SuppressedUntil = GhostSuppressedUntil.Find(AircraftId))
+		{
+			if (Now < *SuppressedUntil) continue;
+		}
+
+		FShardGhost& Ghost = Ghosts.FindOrAdd(AircraftId);
+		if (Ghost.Actor.IsValid() == false)
+		{
+			AAircraftShardGhost* GhostActor = nullptr;
+			while (FreeGhosts.Num() > 0 && GhostActor == nullptr)
+			{
+				GhostActor = FreeGhosts.Pop(false);
+				if (IsValid(GhostActor) == false)
+				{
+					GhostActor = nullptr;
+				}
+			}
+			if (GhostActor == nullptr)
+			{
+				FActorSpawnParameters SpawnParameters;
+				SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+				GhostActor = World->SpawnActor<AAircraftShardGhost>(AAircraftShardGhost::StaticClass(), FTransform(Rotation, FVector(Location)), SpawnParameters);
+			}
+			if (GhostActor == nullptr) continue;
+
+			GhostActor->ActivateGhost(ClassMeshes[ClassIndex]);
+			Ghost.Actor = GhostActor;
+		}
+
+		Ghost.Actor->UpdateGhost(FVector(Location), Rotation, FVector(QuantizedVelocity[0], QuantizedVelocity[1], QuantizedVelocity[2]));
+		Ghost.LastUpdateTime = Now;
+		++Report.GhostUpdatesReceived;
+	}
+}
+
+UStaticMesh* UAircraftShardSubsystem::GetGhostMesh(const FString& ClassPath)
+{
+	if (const TWeakObjectPtr<UStaticMesh>* CachedMesh = GhostMeshes.Find(ClassPath))
+	{
+		if (CachedMesh->IsValid())
+		{
+			return CachedMesh->Get();
+		}
+	}
+
+	/*Never loaded on demand; a ghost of a class this shard has not loaded is simply not drawn*/
+	const UClass* AircraftClass = FindObject<UClass>(nullptr, *ClassPath);
+	const AAircraft* DefaultAircraft = AircraftClass && AircraftClass->IsChildOf(AAircraft::StaticClass()) ? AircraftClass->GetDefaultObject<AAircraft>() : nullptr;
+	UStaticMesh* Mesh = DefaultAircraft ? DefaultAircraft->GetAirframeMesh() : nullptr;
+	GhostMeshes.Add(ClassPath, Mesh);
+	return Mesh;
+}
+
+void UAircraftShardSubsystem::RemoveGhost(uint32 AircraftId)
+{
+	FShardGhost Ghost;
+	if (Ghosts.RemoveAndCopyValue(AircraftId, Ghost) && Ghost.Actor.IsValid())
+	{
+		Ghost.Actor->DeactivateGhost();
+		FreeGhosts.Add(Ghost.Actor.Get());
+	}
+}
+
+void UAircraftShardSubsystem::ExpireGhosts(double Now)
+{
+	for (auto It = Ghosts.CreateIterator(); It; ++It)
+	{
+		FShardGhost& Ghost = It.Value();
+		if (Ghost.Actor.IsValid() && Now - Ghost.LastUpdateTime < GhostTimeout) continue;
+
+		if (Ghost.Actor.IsValid())
+		{
+			Ghost.Actor->DeactivateGhost();
+			FreeGhosts.Add(Ghost.Actor.Get());
+		}
+		It.RemoveCurrent();
+	}
+
+	for (auto It = GhostSuppressedUntil.CreateIterator(); It; ++It)
+	{
+		if (Now >= It.Value())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	SET_DWORD_STAT(STAT_AircraftShardGhosts, Ghosts.Num());
+}
+#pragma endregion
+
+#pragma region Stats
+void UAircraftShardSubsystem::OnWorldTickStart(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld == GetWorld())
+	{
+		ActorTickStartTime = FPlatformTime::Seconds();
+	}
+}
+
+void UAircraftShardSubsystem::OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld != GetWorld() || ActorTickStartTime <= 0.0) return;
+
+	const double Now = FPlatformTime::Seconds();
+	const double TickSeconds = Now - ActorTickStartTime;
+	ActorTickStartTime = 0.0;
+
+	++Report.Ticks;
+	Report.TotalTickSeconds += TickSeconds;
+	Report.MaxTickSeconds = FMath::Max(Report.MaxTickSeconds, TickSeconds);
+
+	WriteLine(TicksWriter.Get(), FString::Printf(TEXT("%.4f,%.3f,%d,%d"), Now, TickSeconds * 1000.0, NumOwnedAircraft, Ghosts.Num()));
+}
+
+void UAircraftShardSubsystem::RecordHandoff(uint32 HandoffId, const TCHAR* Direction, int32 Peer, int32 Bytes, int32 Attempts, double LatencySeconds)
+{
+	WriteLine(HandoffsWriter.Get(), FString::Printf(TEXT("%.4f,%u,%s,%d,%d,%d,%.3f"), FPlatformTime::Seconds(), HandoffId, Direction, Peer, Bytes, Attempts, LatencySeconds * 1000.0));
+}
+
+void UAircraftShardSubsystem::WriteLine(FArchive* Writer, const FString& Line)
+{
+	if (Writer == nullptr) return;
+
+	FTCHARToUTF8 Utf8Line(*(Line + TEXT("\n")));
+	Writer->Serialize(const_cast<ANSICHAR*>(Utf8Line.Get()), Utf8Line.Length());
+}
+#pragma endregion
+
+#pragma region ConsoleCommands
+static FAutoConsoleCommandWithWorldAndArgs GAircraftShardReportCommand
+(
+	TEXT("Aircraft.Shard.Report"),
+	TEXT("Logs this airspace shard's handoffs, handoff latency, ghosts and actor tick time. Usage: Aircraft.Shard.Report [reset]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UAircraftShardSubsystem* Shard = World ? World->GetSubsystem<UAircraftShardSubsystem>() : nullptr;
+		if (Shard == nullptr)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Aircraft.Shard.Report: this process is not running as an airspace shard"));
+			return;
+		}
+
+		const UAircraftShardSubsystem::FReport& Report = Shard->GetReport();
+		const double HandoffsIn = FMath::Max<double>(Report.HandoffsIn, 1.0);
+		const double Ticks = FMath::Max<double>(Report.Ticks, 1.0);
+		UE_LOG(LogTemp, Log, TEXT("Aircraft.Shard %d: %llu handoffs out, %llu in, %llu returned, %llu resends, %llu blocked (player piloted)"),
+			Shard->GetShardIndex(), Report.HandoffsOut, Report.HandoffsIn, Report.HandoffsReturned, Report.Resends, Report.BlockedHandoffs);
+		UE_LOG(LogTemp, Log, TEXT("Aircraft.Shard %d: handoff latency avg %.2f ms, max %.2f ms"),
+			Shard->GetShardIndex(), Report.TotalHandoffLatency * 1000.0 / HandoffsIn, Report.MaxHandoffLatency * 1000.0);
+		UE_LOG(LogTemp, Log, TEXT("Aircraft.Shard %d: %d ghosts, %llu ghost updates sent, %llu received"),
+			Shard->GetShardIndex(), Shard->GetNumGhosts(), Report.GhostUpdatesSent, Report.GhostUpdatesReceived);
+		UE_LOG(LogTemp, Log, TEXT("Aircraft.Shard %d: actor tick avg %.3f ms, max %.3f ms over %llu ticks"),
+			Shard->GetShardIndex(), Report.TotalTickSeconds * 1000.0 / Ticks, Report.MaxTickSeconds * 1000.0, Report.Ticks);
+
+		if (Args.Num() > 0 && Args[0].Equals(TEXT("reset"), ESearchCase::IgnoreCase))
+		{
+			Shard->ResetReport();
+		}
+	})
+);
+#pragma endregion
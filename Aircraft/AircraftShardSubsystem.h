@@ -0,0 +1,183 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * UAircraftShardSubsystem is an experimental mode that splits the airspace between several dedicated server
+ * processes on one machine. The map is cut into slabs along X, one per shard process, centred on the origin:
+ * shard i owns X in [(i - Count / 2) * Width, (i + 1 - Count / 2) * Width), and the outermost shards extend to infinity.
+ * Shards talk over UDP on the loopback interface, shard i listening on BasePort + i.
+ *
+ *   Handoff  an aircraft that flies HandoffMargin past its shard's border is serialized (class, transform, bot
+ *            flag, AAircraft::SerializeHandoffState) and released to the pool; the neighbour adopts it from its own
+ *            pool and acknowledges. Unacknowledged handoffs are resent, and after HandoffTimeout the sender adopts
+ *            the aircraft back itself. Player-piloted aircraft are not handed off (that needs a client travel).
+ *   Ghosts   aircraft within GhostMargin of a border are sent to the neighbour GhostRate times a second and shown
+ *            there as AAircraftShardGhost proxies, which expire when updates stop.
+ *
+ * Only exists on a server started with -AircraftShard=<Index> -AircraftShardCount=<N>. Optional:
+ * -AircraftShardWidth=<cm> -AircraftShardPort=<BasePort> -AircraftShardBots=<N> (bots spawned inside this shard,
+ * which also needs -AircraftBotClass=<Blueprint class path>; pass that to every shard so each can adopt and ghost them)
+ * -AircraftShardStats=<OutputPrefix> (writes <prefix>_handoffs.csv and <prefix>_ticks.csv).
+ * Aircraft.Shard.Report logs handoff latency and actor tick time; Tools/aircraft_shard_harness.py runs the shards.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "AircraftShardSubsystem.generated.h"
+
+class AAircraft;
+class AAircraftShardGhost;
+class FBitReader;
+class FInternetAddr;
+class FSocket;
+class UStaticMesh;
+
+UCLASS()
+class AIRCRAFT_API UAircraftShardSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/*The shard whose slab contains X*/
+	int32 GetShardForX(double X) const;
+	int32 GetShardIndex() const { return ShardIndex; }
+
+	struct FReport
+	{
+		uint64 HandoffsOut = 0;
+		uint64 HandoffsIn = 0;
+
+		/*Neighbour never acknowledged; the aircraft was adopted back*/
+		uint64 HandoffsReturned = 0;
+		uint64 Resends = 0;
+
+		/*Crossings skipped because a player pilots the aircraft*/
+		uint64 BlockedHandoffs = 0;
+
+		/*From release on the sending shard to adoption here, on the shared machine clock*/
+		double TotalHandoffLatency = 0.0;
+		double MaxHandoffLatency = 0.0;
+
+		uint64 GhostUpdatesSent = 0;
+		uint64 GhostUpdatesReceived = 0;
+
+		uint64 Ticks = 0;
+		double TotalTickSeconds = 0.0;
+		double MaxTickSeconds = 0.0;
+	};
+
+	const FReport& GetReport() const { return Report; }
+	void ResetReport() { Report = FReport(); }
+	int32 GetNumGhosts() const { return Ghosts.Num(); }
+
+private:
+	struct FPendingHandoff
+	{
+		int32 TargetShard = INDEX_NONE;
+		TArray<uint8> Message;
+		double ReleaseTime = 0.0;
+		double LastSendTime = 0.0;
+		int32 Attempts = 0;
+	};
+
+	struct FShardGhost
+	{
+		TWeakObjectPtr<AAircraftShardGhost> Actor;
+		double LastUpdateTime = 0.0;
+	};
+
+	/*Messages*/
+	void ReceiveMessages();
+	void SendTo(int32 TargetShard, const TArray<uint8>& Message);
+	void HandleHandoff(int32 FromShard, FBitReader& Reader);
+	void HandleHandoffAck(int32 FromShard, FBitReader& Reader);
+	void HandleGhosts(int32 FromShard, FBitReader& Reader);
+
+	/*Handoff*/
+	void ScanForHandoffs();
+	void HandOff(AAircraft* Aircraft, int32 TargetShard);
+	AAircraft* AdoptAircraft(FBitReader& Reader, uint32 AircraftId);
+	void UpdatePendingHandoffs(double Now);
+	uint32 GetAircraftId(const AAircraft* Aircraft);
+
+	/*Ghosts*/
+	void SendGhosts();
+	void ExpireGhosts(double Now);
+	void RemoveGhost(uint32 AircraftId);
+	UStaticMesh* GetGhostMesh(const FString& ClassPath);
+
+	/*Stats*/
+	void OnWorldTickStart(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+	void OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+	void RecordHandoff(uint32 HandoffId, const TCHAR* Direction, int32 Peer, int32 Bytes, int32 Attempts, double LatencySeconds);
+	static void WriteLine(FArchive* Writer, const FString& Line);
+
+	double GetSlabMinX(int32 Index) const;
+	double GetSlabMaxX(int32 Index) const;
+
+	int32 ShardIndex = 0;
+	int32 ShardCount = 1;
+	double SlabWidth = 200000.0;
+	int32 BasePort = 7900;
+
+	FSocket* Socket = nullptr;
+	TArray<TSharedPtr<FInternetAddr>> PeerAddresses;
+
+	/*Ids stay with an aircraft across handoffs, so ghosts and handoffs of the same aircraft can be matched*/
+	TMap<TObjectKey<AAircraft>, uint32> AircraftIds;
+	uint32 NextAircraftSerial = 1;
+	uint32 NextHandoffSerial = 1;
+
+	TMap<uint32, FPendingHandoff> PendingHandoffs;
+
+	/*Handoffs already adopted, by id, so a resend that crossed our acknowledgement is only acknowledged again*/
+	TMap<uint32, double> RecentlyAdopted;
+
+	/*Aircraft taken back after a failed handoff wait out HandoffTimeout before crossing again*/
+	TMap<TObjectKey<AAircraft>, double> HandoffRetryTimes;
+
+	TMap<uint32, FShardGhost> Ghosts;
+
+	/*Aircraft just adopted, so ghost updates for them still in flight from the previous owner are ignored*/
+	TMap<uint32, double> GhostSuppressedUntil;
+
+	TMap<FString, TWeakObjectPtr<UStaticMesh>> GhostMeshes;
+
+	UPROPERTY()
+	TArray<AAircraftShardGhost*> FreeGhosts;
+
+	/*Loaded at startup and kept referenced: adopting a neighbour's bot and drawing its ghost never load classes*/
+	UPROPERTY()
+	TSubclassOf<AAircraft> BotAircraftClass;
+
+	int32 NumBots = 0;
+
+	int32 NumOwnedAircraft = 0;
+	double NextGhostSendTime = 0.0;
+	double ActorTickStartTime = 0.0;
+
+	FDelegateHandle WorldTickStartHandle;
+	FDelegateHandle WorldPostActorTickHandle;
+
+	TUniquePtr<FArchive> HandoffsWriter;
+	TUniquePtr<FArchive> TicksWriter;
+
+	FReport Report;
+
+	/*Tuning*/
+	float HandoffMargin = 500.0f;
+	float HandoffResendInterval = 0.1f;
+	float HandoffTimeout = 2.0f;
+	float GhostMargin = 20000.0f;
+	float GhostRate = 10.0f;
+	float GhostTimeout = 1.0f;
+};
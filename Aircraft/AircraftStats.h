@@ -0,0 +1,18 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * Stat group shared by the aircraft, weapon and projectile systems.
+ * Use "stat Aircraft" in the console to inspect the counters declared here.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("Aircraft"), STATGROUP_Aircraft, STATCAT_Advanced);
+
+/*Damage*/
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Damage Hits Queued"),		STAT_AircraftDamageHitsQueued,		STATGROUP_Aircraft, AIRCRAFT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Damage Batches Resolved"),	STAT_AircraftDamageBatchesResolved,	STATGROUP_Aircraft, AIRCRAFT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Vitals Updates Marked"),		STAT_AircraftVitalsUpdates,	STATGROUP_Aircraft, AIRCRAFT_API);
@@ -0,0 +1,185 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+
+#include "AircraftSwarmCommandlet.h"
+
+#include "Aircraft.h"
+#include "AircraftBotController.h"
+#include "Projectile.h"
+
+#include "Containers/Ticker.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+UAircraftSwarmCommandlet::UAircraftSwarmCommandlet()
+{
+	IsClient = false;
+	IsServer = true;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UAircraftSwarmCommandlet::Main(const FString& Params)
+{
+	FString MapName;
+	if (FParse::Value(*Params, TEXT("Map="), MapName) == false)
+	{
+		UE_LOG(LogTemp, Error, TEXT("AircraftSwarm: -Map= is required"));
+		return 1;
+	}
+
+	FString BotCountsParam = TEXT("8,16,32,64");
+	FString CsvPath;
+	FParse::Value(*Params, TEXT("Bots="), BotCountsParam);
+	FParse::Value(*Params, TEXT("Duration="), MeasureDuration);
+	FParse::Value(*Params, TEXT("Warmup="), WarmupDuration);
+	FParse::Value(*Params, TEXT("TickRate="), TickRate);
+	FParse::Value(*Params, TEXT("Radius="), SpawnRadius);
+	FParse::Value(*Params, TEXT("Altitude="), SpawnAltitude);
+	FParse::Value(*Params, TEXT("Csv="), CsvPath);
+
+	AircraftClass = AAircraftBotController::LoadBotAircraftClass(*Params);
+	if (AircraftClass == nullptr) return 1;
+
+	TArray<FString> BotCountStrings;
+	BotCountsParam.ParseIntoArray(BotCountStrings, TEXT(","));
+
+	UWorld* World = LoadServerWorld(MapName);
+	if (World == nullptr) return 1;
+
+	const float TickBudgetMs = 1000.0f / TickRate;
+	TArray<FSwarmStepResult> Results;
+	int32 FirstOverBudgetBots = INDEX_NONE;
+
+	for (const FString& BotCountString : BotCountStrings)
+	{
+		const int32 BotCount = FCString::Atoi(*BotCountString);
+		if (BotCount <= 0) continue;
+
+		SpawnBotsUpTo(World, BotCount);
+		const FSwarmStepResult& Result = Results.Add_GetRef(MeasureStep(World, BotCount));
+
+		UE_LOG(LogTemp, Display, TEXT("AircraftSwarm: %4d bots  tick p50 %6.2f ms  p95 %6.2f ms  p99 %6.2f ms  max %6.2f ms  projectiles %6d"),
+			Result.Bots, Result.TickP50Ms, Result.TickP95Ms, Result.TickP99Ms, Result.TickMaxMs, Result.ProjectilesSpawned);
+
+		if (Result.TickP95Ms > TickBudgetMs && FirstOverBudgetBots == INDEX_NONE)
+		{
+			FirstOverBudgetBots = BotCount;
+			break;
+		}
+	}
+
+	if (FirstOverBudgetBots != INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Display, TEXT("AircraftSwarm: server falls below %.0f Hz (p95 over %.2f ms) at %d bots"), TickRate, TickBudgetMs, FirstOverBudgetBots);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Display, TEXT("AircraftSwarm: server held %.0f Hz for every tested bot count"), TickRate);
+	}
+
+	if (CsvPath.IsEmpty() == false)
+	{
+		FString Csv = TEXT("bots,tick_p50_ms,tick_p95_ms,tick_p99_ms,tick_max_ms,projectiles\n");
+		for (const FSwarmStepResult& Result : Results)
+		{
+			Csv += FString::Printf(TEXT("%d,%.3f,%.3f,%.3f,%.3f,%d\n"),
+				Result.Bots, Result.TickP50Ms, Result.TickP95Ms, Result.TickP99Ms, Result.TickMaxMs, Result.ProjectilesSpawned);
+		}
+		FFileHelper::SaveStringToFile(Csv, *CsvPath);
+	}
+
+	SpawnedAircraft.Reset();
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return 0;
+}
+
+UWorld* UAircraftSwarmCommandlet::LoadServerWorld(const FString& MapName)
+{
+	FURL URL(nullptr, *MapName, TRAVEL_Absolute);
+	URL.AddOption(TEXT("listen"));
+
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	FString Error;
+	if (GEngine->LoadMap(WorldContext, URL, nullptr, Error) == false)
+	{
+		UE_LOG(LogTemp, Error, TEXT("AircraftSwarm: failed to load %s: %s"), *MapName, *Error);
+		return nullptr;
+	}
+	return WorldContext.World();
+}
+
+void UAircraftSwarmCommandlet::SpawnBotsUpTo(UWorld* World, int32 BotCount)
+{
+	const int32 NumToSpawn = BotCount - SpawnedAircraft.Num();
+	if (NumToSpawn <= 0) return;
+
+	if (AAircraftBotController::SpawnBotSwarm(World, AircraftClass, NumToSpawn, SpawnRadius, SpawnAltitude, SpawnedAircraft) < NumToSpawn)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("AircraftSwarm: could only spawn %d of %d bots"), SpawnedAircraft.Num(), BotCount);
+	}
+}
+
+void UAircraftSwarmCommandlet::StepWorld(UWorld* World, float DeltaSeconds, TArray<float>* OutTickTimesMs)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	World->Tick(LEVELTICK_All, DeltaSeconds);
+	FTSTicker::GetCoreTicker().Tick(DeltaSeconds);
+	FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+	++GFrameCounter;
+
+	if (OutTickTimesMs)
+	{
+		OutTickTimesMs->Add(static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0));
+	}
+}
+
+UAircraftSwarmCommandlet::FSwarmStepResult UAircraftSwarmCommandlet::MeasureStep(UWorld* World, int32 BotCount)
+{
+	const float DeltaSeconds = 1.0f / TickRate;
+
+	for (float Elapsed = 0.0f; Elapsed < WarmupDuration; Elapsed += DeltaSeconds)
+	{
+		StepWorld(World, DeltaSeconds, nullptr);
+	}
+
+	int32 ProjectilesSpawned = 0;
+	const FDelegateHandle SpawnHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateLambda([&ProjectilesSpawned](AActor* SpawnedActor)
+	{
+		if (SpawnedActor->IsA<AProjectile>())
+		{
+			++ProjectilesSpawned;
+		}
+	}));
+
+	TArray<float> TickTimesMs;
+	TickTimesMs.Reserve(FMath::CeilToInt(MeasureDuration * TickRate));
+	for (float Elapsed = 0.0f; Elapsed < MeasureDuration; Elapsed += DeltaSeconds)
+	{
+		StepWorld(World, DeltaSeconds, &TickTimesMs);
+	}
+
+	World->RemoveOnActorSpawnedHandler(SpawnHandle);
+
+	FSwarmStepResult Result;
+	Result.Bots = BotCount;
+	Result.ProjectilesSpawned = ProjectilesSpawned;
+
+	TickTimesMs.Sort();
+	Result.TickP50Ms = Percentile(TickTimesMs, 0.50f);
+	Result.TickP95Ms = Percentile(TickTimesMs, 0.95f);
+	Result.TickP99Ms = Percentile(TickTimesMs, 0.99f);
+	Result.TickMaxMs = TickTimesMs.Num() > 0 ? TickTimesMs.Last() : 0.0f;
+	return Result;
+}
+
+float UAircraftSwarmCommandlet::Percentile(const TArray<float>& SortedValues, float Fraction)
+{
+	if (SortedValues.Num() == 0) return 0.0f;
+	const int32 Index = FMath::Clamp(FMath::CeilToInt(Fraction * SortedValues.Num()) - 1, 0, SortedValues.Num() - 1);
+	return SortedValues[Index];
+}
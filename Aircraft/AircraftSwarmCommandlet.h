@@ -0,0 +1,61 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * UAircraftSwarmCommandlet load-tests the server side of the aircraft systems with bot pilots.
+ * It loads a map as a listen server, then steps the world at a fixed rate while ramping up the number of
+ * AAircraftBotController-driven aircraft. For every step it reports tick time percentiles and projectiles spawned,
+ * and it names the first bot count at which the server can no longer hold the target tick rate.
+ *
+ * UnrealEditor-Cmd <Project> -run=AircraftSwarm -nullrhi -Map=/Game/Maps/Arena -AircraftBotClass=/Game/...BP_Fighter.BP_Fighter_C
+ *     [-Bots=8,16,32,64] [-Duration=60] [-Warmup=5] [-TickRate=30]
+ *     [-Radius=50000] [-Altitude=20000] [-Csv=Saved/Profiling/AircraftSwarm.csv]
+ *
+ * No clients connect, so replication bandwidth is not measured here; Tools/aircraft_net_harness.py covers it.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AircraftSwarmCommandlet.generated.h"
+
+class AAircraft;
+
+UCLASS()
+class AIRCRAFT_API UAircraftSwarmCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAircraftSwarmCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	struct FSwarmStepResult
+	{
+		int32 Bots = 0;
+		float TickP50Ms = 0.0f;
+		float TickP95Ms = 0.0f;
+		float TickP99Ms = 0.0f;
+		float TickMaxMs = 0.0f;
+		int32 ProjectilesSpawned = 0;
+	};
+
+	UWorld* LoadServerWorld(const FString& MapName);
+	void SpawnBotsUpTo(UWorld* World, int32 BotCount);
+	void StepWorld(UWorld* World, float DeltaSeconds, TArray<float>* OutTickTimesMs);
+	FSwarmStepResult MeasureStep(UWorld* World, int32 BotCount);
+
+	static float Percentile(const TArray<float>& SortedValues, float Fraction);
+
+	UPROPERTY()
+	TArray<AAircraft*> SpawnedAircraft;
+
+	TSubclassOf<AAircraft> AircraftClass;
+	float TickRate = 30.0f;
+	float MeasureDuration = 60.0f;
+	float WarmupDuration = 5.0f;
+	float SpawnRadius = 50000.0f;
+	float SpawnAltitude = 20000.0f;
+};
@@ -0,0 +1,174 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+
+#include "AircraftTelemetry.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <windows.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#elif PLATFORM_UNIX || PLATFORM_MAC
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+FAircraftTelemetryWriter* FAircraftTelemetryWriter::ActiveWriter = nullptr;
+
+FAircraftTelemetryWriter::~FAircraftTelemetryWriter()
+{
+	Close();
+}
+
+bool FAircraftTelemetryWriter::Open(const FString& FilePath, uint32 RequestedCapacity)
+{
+	Close();
+	if (RequestedCapacity == 0) return false;
+
+	/*Clamped before rounding, which would wrap to 0 above 2^31*/
+	const uint32 Capacity = FMath::RoundUpToPowerOfTwo(FMath::Clamp(RequestedCapacity, MinCapacity, MaxCapacity));
+	MappedSize = sizeof(FAircraftTelemetryHeader) + SIZE_T(Capacity) * sizeof(FAircraftTelemetryRecord);
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+
+#if PLATFORM_WINDOWS
+	HANDLE File = CreateFileW(*FilePath, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (File == INVALID_HANDLE_VALUE) return false;
+
+	ULARGE_INTEGER Size;
+	Size.QuadPart = MappedSize;
+	HANDLE Mapping = CreateFileMappingW(File, nullptr, PAGE_READWRITE, Size.HighPart, Size.LowPart, nullptr);
+	if (Mapping == nullptr)
+	{
+		CloseHandle(File);
+		return false;
+	}
+
+	MappedMemory = MapViewOfFile(Mapping, FILE_MAP_ALL_ACCESS, 0, 0, MappedSize);
+	if (MappedMemory == nullptr)
+	{
+		CloseHandle(Mapping);
+		CloseHandle(File);
+		return false;
+	}
+	FileHandle = File;
+	MappingHandle = Mapping;
+#elif PLATFORM_UNIX || PLATFORM_MAC
+	const int32 Descriptor = open(TCHAR_TO_UTF8(*FilePath), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (Descriptor < 0) return false;
+
+	if (ftruncate(Descriptor, MappedSize) != 0)
+	{
+		close(Descriptor);
+		return false;
+	}
+
+	void* Mapped = mmap(nullptr, MappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, Descriptor, 0);
+	if (Mapped == MAP_FAILED)
+	{
+		close(Descriptor);
+		return false;
+	}
+	MappedMemory = Mapped;
+	FileDescriptor = Descriptor;
+#else
+	return false;
+#endif
+
+	/*Fresh mappings are zero filled, so every slot starts with an invalid sequence*/
+	Header = new (MappedMemory) FAircraftTelemetryHeader();
+	Header->Magic		= FAircraftTelemetryHeader::ExpectedMagic;
+	Header->Version		= FAircraftTelemetryHeader::ExpectedVersion;
+	Header->RecordSize	= sizeof(FAircraftTelemetryRecord);
+	Header->Capacity	= Capacity;
+	Header->WriteIndex.store(0, std::memory_order_release);
+
+	Records = reinterpret_cast<FAircraftTelemetryRecord*>(static_cast<uint8*>(MappedMemory) + sizeof(FAircraftTelemetryHeader));
+	CapacityMask = Capacity - 1;
+	return true;
+}
+
+void FAircraftTelemetryWriter::Close()
+{
+	if (MappedMemory == nullptr) return;
+
+#if PLATFORM_WINDOWS
+	FlushViewOfFile(MappedMemory, 0);
+	UnmapViewOfFile(MappedMemory);
+	CloseHandle(static_cast<HANDLE>(MappingHandle));
+	CloseHandle(static_cast<HANDLE>(FileHandle));
+	MappingHandle = nullptr;
+	FileHandle = nullptr;
+#elif PLATFORM_UNIX || PLATFORM_MAC
+	munmap(MappedMemory, MappedSize);
+	close(FileDescriptor);
+	FileDescriptor = -1;
+#endif
+
+	MappedMemory = nullptr;
+	MappedSize = 0;
+	Header = nullptr;
+	Records = nullptr;
+	CapacityMask = 0;
+}
+
+bool FAircraftTelemetryWriter::Start(const FString& FilePath, uint32 Capacity)
+{
+	Stop();
+
+	FAircraftTelemetryWriter* Writer = new FAircraftTelemetryWriter();
+	if (Writer->Open(FilePath, Capacity) == false)
+	{
+		delete Writer;
+		return false;
+	}
+
+	ActiveWriter = Writer;
+	return true;
+}
+
+void FAircraftTelemetryWriter::Stop()
+{
+	delete ActiveWriter;
+	ActiveWriter = nullptr;
+}
+
+#pragma region ConsoleCommands
+static FAutoConsoleCommand GAircraftTelemetryStartCommand
+(
+	TEXT("Aircraft.Telemetry.Start"),
+	TEXT("Records per-tick flight telemetry of every aircraft into a memory-mapped ring file. Usage: Aircraft.Telemetry.Start [Records=65536, 64 to 16777216] [Path]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int64 RequestedCapacity = Args.Num() > 0 ? FCString::Atoi64(*Args[0]) : 65536;
+		if (RequestedCapacity <= 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Aircraft telemetry needs a positive record count, got '%s'"), *Args[0]);
+			return;
+		}
+
+		const uint32 Capacity = (uint32)FMath::Min<int64>(RequestedCapacity, FAircraftTelemetryWriter::MaxCapacity);
+		const FString FilePath = Args.Num() > 1 ? Args[1] : FPaths::Combine(FPaths::ProfilingDir(), TEXT("AircraftTelemetry.bin"));
+
+		if (FAircraftTelemetryWriter::Start(FilePath, Capacity))
+		{
+			UE_LOG(LogTemp, Log, TEXT("Aircraft telemetry recording to %s"), *FPaths::ConvertRelativePathToFull(FilePath));
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Aircraft telemetry could not map %s"), *FilePath);
+		}
+	})
+);
+
+static FAutoConsoleCommand GAircraftTelemetryStopCommand
+(
+	TEXT("Aircraft.Telemetry.Stop"),
+	TEXT("Stops flight telemetry recording and closes the ring file."),
+	FConsoleCommandDelegate::CreateStatic(&FAircraftTelemetryWriter::Stop)
+);
+#pragma endregion
@@ -0,0 +1,110 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * FAircraftTelemetryWriter appends fixed 64-byte flight records into a memory-mapped ring file.
+ * The file starts with a 64-byte header holding the record size, the ring capacity and the running write index.
+ * Appending claims a slot with one atomic increment, fills it in place and publishes it by storing its sequence
+ * number last, so external readers (see Tools/aircraft_telemetry_tail.py) can tail the file while the game runs.
+ * There are no allocations and no locks once the writer is open.
+ *
+ * Console: Aircraft.Telemetry.Start [Records=65536] [Path], Aircraft.Telemetry.Stop
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+struct FAircraftTelemetryRecord
+{
+	/*Write index + 1, stored last; a reader treats a slot as valid once this matches the index it expects*/
+	uint64 Sequence;
+	float WorldTime;
+	uint32 AircraftId;
+
+	float CurrentSpeed;
+	float ThrustSpeed;
+	float BoostSpeed;
+	float AppliedGravity;
+
+	float CurrentPitch;
+	float CurrentYaw;
+	float CurrentRoll;
+	float InputThrottle;
+
+	float LocationX;
+	float LocationY;
+	float LocationZ;
+	uint32 Flags;
+};
+static_assert(sizeof(FAircraftTelemetryRecord) == 64, "Telemetry records are read by external tools and must stay 64 bytes");
+
+struct FAircraftTelemetryHeader
+{
+	static constexpr uint32 ExpectedMagic = 0x4C544341; /*'ACTL'*/
+	static constexpr uint32 ExpectedVersion = 1;
+
+	uint32 Magic;
+	uint32 Version;
+	uint32 RecordSize;
+	uint32 Capacity;
+	std::atomic<uint64> WriteIndex;
+	uint8 Padding[40];
+};
+static_assert(sizeof(FAircraftTelemetryHeader) == 64, "Telemetry header is read by external tools and must stay 64 bytes");
+
+/*Bits stored in FAircraftTelemetryRecord::Flags*/
+enum EAircraftTelemetryFlags : uint32
+{
+	EATF_EngineStarted	= 1 << 0,
+	EATF_TakenOff		= 1 << 1,
+	EATF_Boosting		= 1 << 2,
+	EATF_Destroyed		= 1 << 3,
+	EATF_Authority		= 1 << 4
+};
+
+class AIRCRAFT_API FAircraftTelemetryWriter
+{
+public:
+	~FAircraftTelemetryWriter();
+
+	static constexpr uint32 MinCapacity = 64;
+	static constexpr uint32 MaxCapacity = 1u << 24;
+
+	/*Capacity is clamped to [MinCapacity, MaxCapacity] and rounded up to a power of two so slot lookup is a mask; 0 fails*/
+	bool Open(const FString& FilePath, uint32 RequestedCapacity);
+	void Close();
+
+	FORCEINLINE FAircraftTelemetryRecord& BeginRecord(uint64& OutIndex)
+	{
+		OutIndex = Header->WriteIndex.fetch_add(1, std::memory_order_relaxed);
+		return Records[OutIndex & CapacityMask];
+	}
+
+	FORCEINLINE void CommitRecord(FAircraftTelemetryRecord& Record, uint64 Index)
+	{
+		reinterpret_cast<std::atomic<uint64>&>(Record.Sequence).store(Index + 1, std::memory_order_release);
+	}
+
+	/*Game-thread owned; null while telemetry is not recording*/
+	static FAircraftTelemetryWriter* GetActive() { return ActiveWriter; }
+	static bool Start(const FString& FilePath, uint32 Capacity);
+	static void Stop();
+
+private:
+	FAircraftTelemetryHeader* Header = nullptr;
+	FAircraftTelemetryRecord* Records = nullptr;
+	uint64 CapacityMask = 0;
+
+	void* MappedMemory = nullptr;
+	SIZE_T MappedSize = 0;
+
+#if PLATFORM_WINDOWS
+	void* FileHandle = nullptr;
+	void* MappingHandle = nullptr;
+#else
+	int32 FileDescriptor = -1;
+#endif
+
+	static FAircraftTelemetryWriter* ActiveWriter;
+};
@@ -0,0 +1,259 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+
+#include "AircraftTimerWheel.h"
+
+#include "AircraftStats.h"
+
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Advance Timer Wheel"),				STAT_AircraftAdvanceTimerWheel,		STATGROUP_Aircraft);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Timer Wheel Timers"),		STAT_AircraftTimerWheelTimers,		STATGROUP_Aircraft);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Timer Wheel Expired"),		STAT_AircraftTimerWheelExpired,		STATGROUP_Aircraft);
+
+#pragma region Wheel
+
+FAircraftTimerWheel::FAircraftTimerWheel(double InTickSeconds)
+	: TickSeconds(FMath::Max(InTickSeconds, UE_DOUBLE_KINDA_SMALL_NUMBER))
+{
+	for (int32 Level = 0; Level < NumLevels; ++Level)
+	{
+		for (int32 Slot = 0; Slot < SlotsPerLevel; ++Slot)
+		{
+			Heads[Level][Slot] = INDEX_NONE;
+		}
+	}
+}
+
+FAircraftTimerHandle FAircraftTimerWheel::SetTimer(double Delay, FSimpleDelegate Callback)
+{
+	int32 NodeIndex;
+	if (FreeNodes.Num() > 0)
+	{
+		NodeIndex = FreeNodes.Pop(false);
+	}
+	else
+	{
+		NodeIndex = Nodes.AddDefaulted();
+	}
+
+	/*First tick boundary at or after the requested time, never the current one*/
+	const double TicksAhead = FMath::CeilToDouble((Accumulated + FMath::Max(Delay, 0.0)) / TickSeconds);
+	const uint64 Ahead = (uint64)FMath::Clamp(TicksAhead, 1.0, (double)(MaxTicksAhead - 1));
+
+	FNode& Node = Nodes[NodeIndex];
+	Node.Callback = MoveTemp(Callback);
+	Node.ExpireTick = CurrentTick + Ahead;
+	Node.Serial = NextSerial;
+	NextSerial = NextSerial == MAX_uint32 ? 1 : NextSerial + 1;
+	Place(NodeIndex);
+
+	++NumActive;
+	INC_DWORD_STAT(STAT_AircraftTimerWheelTimers);
+
+	FAircraftTimerHandle Handle;
+	Handle.Index = NodeIndex;
+	Handle.Serial = Node.Serial;
+	return Handle;
+}
+
+bool FAircraftTimerWheel::ClearTimer(FAircraftTimerHandle& Handle)
+{
+	const bool bWasActive = IsTimerActive(Handle);
+	if (bWasActive)
+	{
+		/*Expired nodes waiting for dispatch are already out of the wheel*/
+		if (Nodes[Handle.Index].Level != INDEX_NONE)
+		{
+			Unlink(Handle.Index);
+		}
+		FreeNode(Handle.Index);
+	}
+	Handle.Invalidate();
+	return bWasActive;
+}
+
+bool FAircraftTimerWheel::IsTimerActive(const FAircraftTimerHandle& Handle) const
+{
+	return Handle.IsValid() && Nodes.IsValidIndex(Handle.Index) && Nodes[Handle.Index].Serial == Handle.Serial;
+}
+
+double FAircraftTimerWheel::GetTimeRemaining(const FAircraftTimerHandle& Handle) const
+{
+	if (IsTimerActive(Handle) == false) return -1.0;
+	if (Nodes[Handle.Index].Level == INDEX_NONE) return 0.0;
+
+	return FMath::Max((Nodes[Handle.Index].ExpireTick - CurrentTick) * TickSeconds - Accumulated, 0.0);
+}
+
+int32 FAircraftTimerWheel::Advance(double DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AircraftAdvanceTimerWheel);
+
+	Accumulated += FMath::Max(DeltaSeconds, 0.0);
+	while (Accumulated >= TickSeconds)
+	{
+		Accumulated -= TickSeconds;
+		Step();
+	}
+
+	/*The wheel is consistent again, so callbacks may set and clear timers, including ones from this batch*/
+	int32 NumRun = 0;
+	if (ExpiredNodes.Num() > 0)
+	{
+		TArray<FExpiredNode> Batch = MoveTemp(ExpiredNodes);
+		ExpiredNodes.Reset();
+		for (const FExpiredNode& Expired : Batch)
+		{
+			/*Cleared by an earlier callback of this batch, possibly reused since*/
+			if (Nodes[Expired.Index].Serial != Expired.Serial) continue;
+
+			/*Freed before running, so the callback sees its own timer as inactive and may set it again*/
+			const FSimpleDelegate Callback = MoveTemp(Nodes[Expired.Index].Callback);
+			FreeNode(Expired.Index);
+			Callback.ExecuteIfBound();
+			++NumRun;
+		}
+		INC_DWORD_STAT_BY(STAT_AircraftTimerWheelExpired, NumRun);
+
+		/*Keep the allocation for the next batch unless a callback already started one*/
+		if (ExpiredNodes.Num() == 0)
+		{
+			Batch.Reset();
+			ExpiredNodes = MoveTemp(Batch);
+		}
+	}
+	return NumRun;
+}
+
+void FAircraftTimerWheel::Place(int32 NodeIndex)
+{
+	FNode& Node = Nodes[NodeIndex];
+
+	/*Lowest level whose span still covers the delay; the slot comes from the absolute expiry tick, so a timer
+	 * reaches level 0 exactly when the wheel cascades the block it expires in*/
+	const uint64 Ahead = Node.ExpireTick - CurrentTick;
+	int32 Level = 0;
+	while (Level < NumLevels - 1 && Ahead >= ((uint64)1 << (SlotBits * (Level + 1))))
+	{
+		++Level;
+	}
+	const int32 Slot = (int32)((Node.ExpireTick >> (SlotBits * Level)) & SlotMask);
+
+	Node.Level = (int16)Level;
+	Node.Slot = (int16)Slot;
+	Node.Prev = INDEX_NONE;
+	Node.Next = Heads[Level][Slot];
+	if (Node.Next != INDEX_NONE)
+	{
+		Nodes[Node.Next].Prev = NodeIndex;
+	}
+	Heads[Level][Slot] = NodeIndex;
+}
+
+void FAircraftTimerWheel::Unlink(int32 NodeIndex)
+{
+	FNode& Node = Nodes[NodeIndex];
+	if (Node.Prev != INDEX_NONE)
+	{
+		Nodes[Node.Prev].Next = Node.Next;
+	}
+	else
+	{
+		Heads[Node.Level][Node.Slot] = Node.Next;
+	}
+	if (Node.Next != INDEX_NONE)
+	{
+		Nodes[Node.Next].Prev = Node.Prev;
+	}
+	Node.Prev = INDEX_NONE;
+	Node.Next = INDEX_NONE;
+}
+
+void FAircraftTimerWheel::FreeNode(int32 NodeIndex)
+{
+	FNode& Node = Nodes[NodeIndex];
+	Node.Callback.Unbind();
+	Node.Serial = 0;
+	Node.Level = INDEX_NONE;
+	Node.Slot = INDEX_NONE;
+	FreeNodes.Add(NodeIndex);
+
+	--NumActive;
+	DEC_DWORD_STAT(STAT_AircraftTimerWheelTimers);
+}
+
+void FAircraftTimerWheel::Cascade(int32 Level)
+{
+	const int32 Slot = (int32)((CurrentTick >> (SlotBits * Level)) & SlotMask);
+
+	/*When this level wraps too, the next one has to come down first so its timers land in this pass*/
+	if (Slot == 0 && Level + 1 < NumLevels)
+	{
+		Cascade(Level + 1);
+	}
+
+	int32 NodeIndex = Heads[Level][Slot];
+	Heads[Level][Slot] = INDEX_NONE;
+	while (NodeIndex != INDEX_NONE)
+	{
+		const int32 NextIndex = Nodes[NodeIndex].Next;
+		Place(NodeIndex);
+		NodeIndex = NextIndex;
+	}
+}
+
+void FAircraftTimerWheel::Step()
+{
+	++CurrentTick;
+
+	const int32 Slot = (int32)(CurrentTick & SlotMask);
+	if (Slot == 0)
+	{
+		Cascade(1);
+	}
+
+	int32 NodeIndex = Heads[0][Slot];
+	Heads[0][Slot] = INDEX_NONE;
+	while (NodeIndex != INDEX_NONE)
+	{
+		FNode& Node = Nodes[NodeIndex];
+		const int32 NextIndex = Node.Next;
+		Node.Prev = INDEX_NONE;
+		Node.Next = INDEX_NONE;
+		Node.Level = INDEX_NONE;
+		Node.Slot = INDEX_NONE;
+		ExpiredNodes.Add({ NodeIndex, Node.Serial });
+		NodeIndex = NextIndex;
+	}
+}
+
+#pragma endregion
+
+#pragma region Subsystem
+
+bool UAircraftTimerWheelSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+TStatId UAircraftTimerWheelSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAircraftTimerWheelSubsystem, STATGROUP_Aircraft);
+}
+
+void UAircraftTimerWheelSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	Wheel.Advance(DeltaTime);
+}
+
+UAircraftTimerWheelSubsystem* UAircraftTimerWheelSubsystem::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UAircraftTimerWheelSubsystem>() : nullptr;
+}
+
+#pragma endregion
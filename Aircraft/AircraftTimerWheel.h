@@ -0,0 +1,113 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * FAircraftTimerWheel is a hierarchical timing wheel for the many short, one-shot timers aircraft gameplay creates:
+ * projectile lifetimes, wreck and destroy delays, take-off delays. Time advances in fixed ticks of TickSeconds.
+ * Four levels of 64 slots cover up to 64^4 ticks (about 72 hours at 1/64 s). Timers sit in intrusive lists inside
+ * a node pool, so setting and clearing a timer is O(1) with no allocation once the pool has grown. Expired timers
+ * are collected while the wheel advances and their callbacks run afterwards as one batch, in expiry order, so a
+ * callback may set or clear timers freely; clearing a timer that expired in the same batch still cancels it.
+ * A timer never fires early and at most one tick late.
+ *
+ * UAircraftTimerWheelSubsystem owns one wheel per game world and advances it with the world's (dilated, pausable) time.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AircraftTimerWheel.generated.h"
+
+struct FAircraftTimerHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+
+	bool IsValid() const { return Serial != 0; }
+	void Invalidate() { Index = INDEX_NONE; Serial = 0; }
+};
+
+class AIRCRAFT_API FAircraftTimerWheel
+{
+public:
+	explicit FAircraftTimerWheel(double InTickSeconds = 1.0 / 64.0);
+
+	FAircraftTimerHandle SetTimer(double Delay, FSimpleDelegate Callback);
+
+	/*Cancels the timer if its callback has not run yet, even when it expired earlier in the current batch, and
+	  invalidates the handle either way*/
+	bool ClearTimer(FAircraftTimerHandle& Handle);
+
+	bool IsTimerActive(const FAircraftTimerHandle& Handle) const;
+	double GetTimeRemaining(const FAircraftTimerHandle& Handle) const;
+
+	/*Advances the wheel and runs every callback that expired, returns how many ran*/
+	int32 Advance(double DeltaSeconds);
+
+	int32 Num() const { return NumActive; }
+	double GetTickSeconds() const { return TickSeconds; }
+
+private:
+	static constexpr int32 NumLevels = 4;
+	static constexpr int32 SlotBits = 6;
+	static constexpr int32 SlotsPerLevel = 1 << SlotBits;
+	static constexpr uint64 SlotMask = SlotsPerLevel - 1;
+	static constexpr uint64 MaxTicksAhead = (uint64)1 << (SlotBits * NumLevels);
+
+	struct FNode
+	{
+		FSimpleDelegate Callback;
+		uint64 ExpireTick = 0;
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+		uint32 Serial = 0;
+		int16 Level = INDEX_NONE;
+		int16 Slot = INDEX_NONE;
+	};
+
+	void Place(int32 NodeIndex);
+	void Unlink(int32 NodeIndex);
+	void FreeNode(int32 NodeIndex);
+	void Cascade(int32 Level);
+	void Step();
+
+	const double TickSeconds;
+	double Accumulated = 0.0;
+	uint64 CurrentTick = 0;
+	uint32 NextSerial = 1;
+	int32 NumActive = 0;
+
+	TArray<FNode> Nodes;
+	TArray<int32> FreeNodes;
+	int32 Heads[NumLevels][SlotsPerLevel];
+
+	/*Nodes expired by the current Advance, run after the wheel has settled; they stay allocated until then so
+	  ClearTimer can still cancel them, and the serial tells a cleared and reused node apart*/
+	struct FExpiredNode
+	{
+		int32 Index;
+		uint32 Serial;
+	};
+	TArray<FExpiredNode> ExpiredNodes;
+};
+
+UCLASS()
+class AIRCRAFT_API UAircraftTimerWheelSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	FAircraftTimerHandle SetTimer(float Delay, FSimpleDelegate Callback) { return Wheel.SetTimer(Delay, MoveTemp(Callback)); }
+	void ClearTimer(FAircraftTimerHandle& Handle) { Wheel.ClearTimer(Handle); }
+	bool IsTimerActive(const FAircraftTimerHandle& Handle) const { return Wheel.IsTimerActive(Handle); }
+	float GetTimeRemaining(const FAircraftTimerHandle& Handle) const { return (float)Wheel.GetTimeRemaining(Handle); }
+
+	static UAircraftTimerWheelSubsystem* Get(const UObject* WorldContextObject);
+
+private:
+	FAircraftTimerWheel Wheel;
+};
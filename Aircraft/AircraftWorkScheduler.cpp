@@ -0,0 +1,227 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+
+#include "AircraftWorkScheduler.h"
+
+#include "AircraftStats.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Run Scheduled Work"),				STAT_AircraftRunScheduledWork,		STATGROUP_Aircraft);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scheduled Work Runs"),		STAT_AircraftScheduledWorkRuns,		STATGROUP_Aircraft);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scheduled Work Forced"),	STAT_AircraftScheduledWorkForced,	STATGROUP_Aircraft);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scheduled Work Deferred"),	STAT_AircraftScheduledWorkDeferred,	STATGROUP_Aircraft);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scheduled Work Skipped"),	STAT_AircraftScheduledWorkSkipped,	STATGROUP_Aircraft);
+
+static TAutoConsoleVariable<float> CVarAircraftWorkBudgetMs
+(
+	TEXT("Aircraft.WorkScheduler.BudgetMs"),
+	1.0f,
+	TEXT("Milliseconds per frame the aircraft work scheduler may spend on work that is due but not yet overdue.")
+);
+
+bool UAircraftWorkScheduler::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+TStatId UAircraftWorkScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAircraftWorkScheduler, STATGROUP_Aircraft);
+}
+
+UAircraftWorkScheduler* UAircraftWorkScheduler::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UAircraftWorkScheduler>() : nullptr;
+}
+
+FAircraftWorkHandle UAircraftWorkScheduler::RegisterWork(EAircraftWorkPriority Priority, float MinInterval, float MaxStaleness, FAircraftWorkDelegate Work)
+{
+	FWorkItem Item;
+	Item.Id = NextId++;
+	Item.Work = MoveTemp(Work);
+	Item.MinInterval = FMath::Max(MinInterval, 0.0f);
+	Item.MaxStaleness = FMath::Max(MaxStaleness, Item.MinInterval);
+
+	/*Random phase, so aircraft spawned together do not all come due on the same frame*/
+	Item.LastRunTime = GetWorld()->GetTimeSeconds() - FMath::FRand() * Item.MinInterval;
+
+	const int32 PriorityIndex = FMath::Clamp((int32)Priority, 0, (int32)EAircraftWorkPriority::EAWP_MAX - 1);
+	Items[PriorityIndex].Add(MoveTemp(Item));
+	++Report.RegisteredItems;
+
+	FAircraftWorkHandle Handle;
+	Handle.Id = NextId - 1;
+	return Handle;
+}
+
+void UAircraftWorkScheduler::UnregisterWork(FAircraftWorkHandle& Handle)
+{
+	/*Only marked here; the item is removed after the current pass, so work may unregister itself*/
+	if (FWorkItem* Item = FindItem(Handle.Id))
+	{
+		Item->Id = 0;
+		Item->Work.Unbind();
+	}
+	Handle.Invalidate();
+}
+
+void UAircraftWorkScheduler::SetWorkEnabled(const FAircraftWorkHandle& Handle, bool bEnabled)
+{
+	if (FWorkItem* Item = FindItem(Handle.Id))
+	{
+		if (bEnabled && Item->bEnabled == false)
+		{
+			/*Coming back from a pause is not staleness; the item waits its normal interval*/
+			Item->LastRunTime = GetWorld()->GetTimeSeconds() - Item->MinInterval;
+		}
+		Item->bEnabled = bEnabled;
+	}
+}
+
+UAircraftWorkScheduler::FWorkItem* UAircraftWorkScheduler::FindItem(uint32 Id)
+{
+	if (Id == 0) return nullptr;
+
+	for (TArray<FWorkItem>& PriorityItems : Items)
+	{
+		if (FWorkItem* Item = PriorityItems.FindByPredicate([Id](const FWorkItem& Entry) { return Entry.Id == Id; }))
+		{
+			return Item;
+		}
+	}
+	return nullptr;
+}
+
+bool UAircraftWorkScheduler::RunItem(FWorkItem& Item, double Now)
+{
+	if (Item.Work.IsBound() == false) return false;
+
+	const float SinceLastRun = (float)(Now - Item.LastRunTime);
+	Item.LastRunTime = Now;
+	Item.LastRunFrame = FrameNumber;
+
+	/*Registering from inside work may grow the array, so nothing of Item is touched after this*/
+	const FAircraftWorkDelegate Work = Item.Work;
+	Work.Execute(SinceLastRun);
+
+	++Report.Runs;
+	Report.MaxStalenessSeconds = FMath::Max(Report.MaxStalenessSeconds, SinceLastRun);
+	INC_DWORD_STAT(STAT_AircraftScheduledWorkRuns);
+	return true;
+}
+
+void UAircraftWorkScheduler::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AircraftRunScheduledWork);
+	Super::Tick(DeltaTime);
+
+	++FrameNumber;
+	++Report.Frames;
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const double BudgetSeconds = FMath::Max(CVarAircraftWorkBudgetMs.GetValueOnGameThread(), 0.0f) / 1000.0;
+	const double FrameStart = FPlatformTime::Seconds();
+
+	/*Overdue items run first and regardless of budget; that is the staleness guarantee*/
+	for (TArray<FWorkItem>& PriorityItems : Items)
+	{
+		for (int32 Index = 0; Index < PriorityItems.Num(); ++Index)
+		{
+			if (PriorityItems[Index].Id == 0) continue;
+			if (PriorityItems[Index].bEnabled == false)
+			{
+				++Report.Skipped;
+				INC_DWORD_STAT(STAT_AircraftScheduledWorkSkipped);
+				continue;
+			}
+			if (Now - PriorityItems[Index].LastRunTime < PriorityItems[Index].MaxStaleness) continue;
+
+			if (RunItem(PriorityItems[Index], Now))
+			{
+				++Report.ForcedRuns;
+				INC_DWORD_STAT(STAT_AircraftScheduledWorkForced);
+			}
+		}
+	}
+
+	/*Then due items round-robin from where each priority stopped last frame, until the budget is spent*/
+	for (int32 PriorityIndex = 0; PriorityIndex < (int32)EAircraftWorkPriority::EAWP_MAX; ++PriorityIndex)
+	{
+		TArray<FWorkItem>& PriorityItems = Items[PriorityIndex];
+		const int32 NumItems = PriorityItems.Num();
+		if (NumItems == 0) continue;
+
+		const int32 StartIndex = Cursors[PriorityIndex] % NumItems;
+		for (int32 Offset = 0; Offset < NumItems; ++Offset)
+		{
+			const int32 Index = (StartIndex + Offset) % NumItems;
+			const FWorkItem& Item = PriorityItems[Index];
+			if (Item.Id == 0 || Item.bEnabled == false || Item.LastRunFrame == FrameNumber || Now - Item.LastRunTime < Item.MinInterval) continue;
+
+			if (FPlatformTime::Seconds() - FrameStart >= BudgetSeconds)
+			{
+				++Report.Deferred;
+				INC_DWORD_STAT(STAT_AircraftScheduledWorkDeferred);
+				continue;
+			}
+
+			RunItem(PriorityItems[Index], Now);
+			Cursors[PriorityIndex] = Index + 1;
+		}
+	}
+
+	const double FrameWorkSeconds = FPlatformTime::Seconds() - FrameStart;
+	Report.TotalWorkSeconds += FrameWorkSeconds;
+	Report.MaxFrameWorkSeconds = FMath::Max(Report.MaxFrameWorkSeconds, FrameWorkSeconds);
+
+	/*Items whose owner died without unregistering are unbound; disabled ones never reach RunItem, so sweep them here*/
+	for (TArray<FWorkItem>& PriorityItems : Items)
+	{
+		const int32 Removed = PriorityItems.RemoveAll([](const FWorkItem& Item)
+		{
+			return Item.Id == 0 || Item.Work.IsBound() == false;
+		});
+		Report.RegisteredItems -= Removed;
+	}
+}
+
+void UAircraftWorkScheduler::ResetReport()
+{
+	const int32 RegisteredItems = Report.RegisteredItems;
+	Report = FReport();
+	Report.RegisteredItems = RegisteredItems;
+}
+
+#pragma region ConsoleCommands
+static FAutoConsoleCommandWithWorldAndArgs GAircraftWorkSchedulerReportCommand
+(
+	TEXT("Aircraft.WorkScheduler.Report"),
+	TEXT("Logs how much deferred aircraft work ran, was forced by its staleness bound, deferred by the budget or skipped while disabled. Usage: Aircraft.WorkScheduler.Report [reset]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UAircraftWorkScheduler* Scheduler = World ? World->GetSubsystem<UAircraftWorkScheduler>() : nullptr;
+		if (Scheduler == nullptr)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Aircraft.WorkScheduler.Report: no game world"));
+			return;
+		}
+
+		const UAircraftWorkScheduler::FReport& Report = Scheduler->GetReport();
+		const double Frames = FMath::Max<double>(Report.Frames, 1.0);
+		UE_LOG(LogTemp, Log, TEXT("Aircraft.WorkScheduler: %d items, %llu frames, budget %.2f ms"), Report.RegisteredItems, Report.Frames, CVarAircraftWorkBudgetMs.GetValueOnGameThread());
+		UE_LOG(LogTemp, Log, TEXT("Aircraft.WorkScheduler: %.1f runs/frame (%.1f forced by staleness), %.1f deferred/frame, %.1f skipped/frame"),
+			Report.Runs / Frames, Report.ForcedRuns / Frames, Report.Deferred / Frames, Report.Skipped / Frames);
+		UE_LOG(LogTemp, Log, TEXT("Aircraft.WorkScheduler: work avg %.3f ms/frame, max %.3f ms, longest gap between runs %.3f s"),
+			Report.TotalWorkSeconds * 1000.0 / Frames, Report.MaxFrameWorkSeconds * 1000.0, Report.MaxStalenessSeconds);
+
+		if (Args.Num() > 0 && Args[0].Equals(TEXT("reset"), ESearchCase::IgnoreCase))
+		{
+			Scheduler->ResetReport();
+		}
+	})
+);
+#pragma endregion
@@ -0,0 +1,104 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * UAircraftWorkScheduler runs the per-aircraft work that does not need every frame: engine sound parameters,
+ * thruster FX parameters, movement validation sampling. Work items are registered with a priority, the shortest
+ * interval worth running them at, and the longest they may go without running. Each frame every item past its
+ * staleness bound runs first, whatever it costs; then the remaining items that are due run round-robin, highest
+ * priority first, until the frame budget (Aircraft.WorkScheduler.BudgetMs) is spent. Whatever is due but did not
+ * fit is deferred to the next frame, with its staleness bound still guaranteeing it a turn.
+ * Disabled items (for example an aircraft that is not flying) are skipped and counted as such.
+ * Aircraft.WorkScheduler.Report logs the totals.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AircraftWorkScheduler.generated.h"
+
+UENUM()
+enum class EAircraftWorkPriority : uint8
+{
+	EAWP_High		UMETA(DisplayName = "High"),
+	EAWP_Normal		UMETA(DisplayName = "Normal"),
+	EAWP_Low		UMETA(DisplayName = "Low"),
+
+	EAWP_MAX		UMETA(Hidden)
+};
+
+/*Receives the seconds since the item last ran*/
+DECLARE_DELEGATE_OneParam(FAircraftWorkDelegate, float);
+
+struct FAircraftWorkHandle
+{
+	uint32 Id = 0;
+
+	bool IsValid() const { return Id != 0; }
+	void Invalidate() { Id = 0; }
+};
+
+UCLASS()
+class AIRCRAFT_API UAircraftWorkScheduler : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/*Bind Work with CreateUObject or CreateWeakLambda; items whose object is gone are dropped on their next turn*/
+	FAircraftWorkHandle RegisterWork(EAircraftWorkPriority Priority, float MinInterval, float MaxStaleness, FAircraftWorkDelegate Work);
+	void UnregisterWork(FAircraftWorkHandle& Handle);
+	void SetWorkEnabled(const FAircraftWorkHandle& Handle, bool bEnabled);
+
+	static UAircraftWorkScheduler* Get(const UObject* WorldContextObject);
+
+	struct FReport
+	{
+		int32 RegisteredItems = 0;
+		uint64 Frames = 0;
+		uint64 Runs = 0;
+
+		/*Ran over budget because they reached their staleness bound*/
+		uint64 ForcedRuns = 0;
+
+		/*Due, but pushed to a later frame by the budget*/
+		uint64 Deferred = 0;
+
+		/*Passed over because they were disabled*/
+		uint64 Skipped = 0;
+
+		double TotalWorkSeconds = 0.0;
+		double MaxFrameWorkSeconds = 0.0;
+		float MaxStalenessSeconds = 0.0f;
+	};
+
+	const FReport& GetReport() const { return Report; }
+	void ResetReport();
+
+private:
+	struct FWorkItem
+	{
+		uint32 Id = 0;
+		FAircraftWorkDelegate Work;
+		float MinInterval = 0.0f;
+		float MaxStaleness = 0.0f;
+		double LastRunTime = 0.0;
+		uint64 LastRunFrame = 0;
+		bool bEnabled = true;
+	};
+
+	FWorkItem* FindItem(uint32 Id);
+	bool RunItem(FWorkItem& Item, double Now);
+
+	TArray<FWorkItem> Items[(int32)EAircraftWorkPriority::EAWP_MAX];
+
+	/*Where the budgeted pass resumes in each priority, so items share the budget round-robin*/
+	int32 Cursors[(int32)EAircraftWorkPriority::EAWP_MAX] = {};
+
+	uint32 NextId = 1;
+	uint64 FrameNumber = 0;
+	FReport Report;
+};
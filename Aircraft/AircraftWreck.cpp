@@ -0,0 +1,96 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+
+#include "AircraftWreck.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+
+AAircraftWreck::AAircraftWreck()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	WreckMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("WreckMesh"));
+	SetRootComponent(WreckMesh);
+
+	WreckMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	WreckMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Block);
+	WreckMesh->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
+	WreckMesh->SetHiddenInGame(true);
+
+	/*NetWorking*/
+	bReplicates = true;
+	SetReplicateMovement(true);
+	NetDormancy = DORM_DormantAll;
+	NetUpdateFrequency = 10.0f;
+	NetCullDistanceSquared = 1400000000.0f;
+}
+
+void AAircraftWreck::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams PushModelParams;
+	PushModelParams.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(AAircraftWreck, ReplicatedMesh, PushModelParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AAircraftWreck, bWreckActive, PushModelParams);
+}
+
+void AAircraftWreck::ActivateWreck(UStaticMesh* Mesh, const FTransform& Transform, const FVector& Velocity)
+{
+	SetNetDormancy(DORM_Awake);
+	SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+
+	ReplicatedMesh = Mesh;
+	bWreckActive = true;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAircraftWreck, ReplicatedMesh, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAircraftWreck, bWreckActive, this);
+
+	ApplyWreckState();
+
+	/*Only the server simulates; clients follow the replicated movement*/
+	if (WreckMesh && WreckMesh->IsSimulatingPhysics())
+	{
+		WreckMesh->SetPhysicsLinearVelocity(Velocity);
+	}
+}
+
+void AAircraftWreck::DeactivateWreck()
+{
+	bWreckActive = false;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAircraftWreck, bWreckActive, this);
+
+	ApplyWreckState();
+
+	FlushNetDormancy();
+	SetNetDormancy(DORM_DormantAll);
+}
+
+void AAircraftWreck::OnRep_WreckState()
+{
+	ApplyWreckState();
+}
+
+void AAircraftWreck::ApplyWreckState()
+{
+	if (WreckMesh == nullptr) return;
+
+	if (bWreckActive)
+	{
+		WreckMesh->SetStaticMesh(ReplicatedMesh);
+		WreckMesh->SetHiddenInGame(false);
+		WreckMesh->SetCollisionEnabled(HasAuthority() ? ECollisionEnabled::QueryAndPhysics : ECollisionEnabled::QueryOnly);
+		WreckMesh->SetSimulatePhysics(HasAuthority());
+		WreckMesh->SetEnableGravity(true);
+	}
+	else
+	{
+		WreckMesh->SetSimulatePhysics(false);
+		WreckMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		WreckMesh->SetHiddenInGame(true);
+	}
+}
@@ -0,0 +1,50 @@
+// @2023 All rights reversed by Reverse-Alpha Studios
+
+/**
+ * AAircraftWreck is the lightweight stand-in left behind when an aircraft is destroyed.
+ * It carries a single physics-simulated static mesh instead of the full aircraft component set,
+ * and it is recycled by UAircraftPoolSubsystem rather than spawned and destroyed for every kill.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "AircraftTimerWheel.h"
+#include "AircraftWreck.generated.h"
+
+class UStaticMesh;
+class UStaticMeshComponent;
+
+UCLASS()
+class AIRCRAFT_API AAircraftWreck : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AAircraftWreck();
+
+	virtual void GetLifetimeReplicatedProps(TArray< FLifetimeProperty >& OutLifetimeProps) const override;
+
+	void ActivateWreck(UStaticMesh* Mesh, const FTransform& Transform, const FVector& Velocity);
+	void DeactivateWreck();
+
+	bool IsWreckActive() const { return bWreckActive; }
+
+	/*Owned by UAircraftPoolSubsystem; cleared on release so an old lifetime cannot end the wreck's next use early*/
+	FAircraftTimerHandle LifetimeTimer;
+
+private:
+	UPROPERTY(VisibleAnywhere)
+	UStaticMeshComponent* WreckMesh;
+
+	UPROPERTY(ReplicatedUsing = OnRep_WreckState)
+	UStaticMesh* ReplicatedMesh = nullptr;
+
+	UPROPERTY(ReplicatedUsing = OnRep_WreckState)
+	bool bWreckActive = false;
+
+	UFUNCTION()
+	void OnRep_WreckState();
+	void ApplyWreckState();
+};
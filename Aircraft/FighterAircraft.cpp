@@ -7,69 +7,66 @@
 #include "Components/BoxComponent.h"
 #include "Components/RocketMovementComponent.h"
 #include "Engine/StaticMeshSocket.h"
+#include "GameFramework/GameStateBase.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Sound/SoundCue.h"
 
+#include "AircraftCasingSubsystem.h"
+#include "AircraftHealthMonitor.h"
+#include "AircraftRocketImpactSubsystem.h"
+#include "AircraftStats.h"
 #include "Projectile.h"
 #include "ProjectileRocket.h"
-#include "TimerManager.h"
 
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Salvo Events Sent"),		STAT_AircraftSalvoEventsSent,		STATGROUP_Aircraft);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Salvo Rounds Spawned"),	STAT_AircraftSalvoRoundsSpawned,	STATGROUP_Aircraft);
+
 AFighterAircraft::AFighterAircraft()
 {
 	FVector FighterAircraftBoxExtent(600.0f, 425.0f, 100.0f);
 	AreaCollision->SetBoxExtent(FighterAircraftBoxExtent);
-
-	TargettingAerialStrikeCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("TargettingCamera"));
-	TargettingAerialStrikeCamera->SetupAttachment(AircraftsMesh);
-	TargettingAerialStrikeCamera->SetRelativeRotation(FRotator(-90.0f, 0.0f, 0.0f));
 }
 
 void AFighterAircraft::BeginPlay()
 {
 	Super::BeginPlay();
-	TargettingAerialStrikeCamera->SetActive(false);
 }
 
-void AFighterAircraft::Tick(float DeltaTime)
+void AFighterAircraft::CreateLocalViewRig()
 {
-	Super::Tick(DeltaTime);
+	Super::CreateLocalViewRig();
 
-	const UStaticMeshSocket* RocketRightSocket = AircraftsMesh->GetSocketByName(FName("RocketRight"));
+	TargetingAerialStrikeCamera = CreateViewCamera(TEXT("TargettingCamera"), AircraftMesh, false);
+	TargetingAerialStrikeCamera->SetRelativeRotation(FRotator(-90.0f, 0.0f, 0.0f));
 
-	UWorld* World = GetWorld();
-	if (RocketRightSocket && World)
+	/*Re-entering an aircraft that was left in targeting mode restores the targeting view*/
+	if (bRocketMode == false)
 	{
-		FTransform RightSocketTransform;
-		bool bRightSuccess = RocketRightSocket->GetSocketTransform(RightSocketTransform, AircraftsMesh);
-		if (bRightSuccess)
-		{
-			FVector SocketLocation  = RightSocketTransform.GetLocation();
-			FVector ForwardVector	= RightSocketTransform.GetRotation().GetForwardVector(); // Get the forward vector of the socket
-			FVector EndPoint		= SocketLocation + ForwardVector * 100.0f; // Extend the line by 100 units in the forward direction
-		}
+		BehindCamera->SetActive(false);
+		TargetingAerialStrikeCamera->SetActive(true);
 	}
+}
 
-	ResetDataTimer += GetWorld()->GetDeltaSeconds();
-	float ResetDataDelay = 1.5f;
-
-
-	/*monitoring values*/
-	//if (ResetDataTimer >= ResetDataDelay)
-	//{
-	//	UE_LOG(LogTemp, Warning, TEXT("CurrentSpeed: %f"), CurrentSpeed);
-	//	UE_LOG(LogTemp, Warning, TEXT("CurrentPitch: %f"), CurrentPitch);
-	//	UE_LOG(LogTemp, Warning, TEXT("CurrentYaw: %f"),   CurrentYaw);
-	//	UE_LOG(LogTemp, Warning, TEXT("CurrentRoll: %f"),  CurrentRoll);
-	//	UE_LOG(LogTemp, Warning, TEXT("BoosterSpeed: %f"), BoostSpeed);
+bool AFighterAircraft::IsAerialStrikeViewActive() const
+{
+	/*Without a local view rig (server, remote copies) the replicated weapon mode stands in for the targeting camera*/
+	return TargetingAerialStrikeCamera ? TargetingAerialStrikeCamera->IsActive() : bRocketMode == false;
+}
 
-	//	ResetDataTimer = 0.0f;
-	//}
+void AFighterAircraft::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
 
-	CheckAndFixTargettingCameraModeIfSwitched();
+	/*Flight values are monitored through Aircraft.Telemetry.Start, recorded by AAircraft::Tick*/
+	CheckAndFixTargetingCameraModeIfSwitched();
+	UpdateWeapons(DeltaTime);
 }
 
 void AFighterAircraft::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -77,23 +74,77 @@ void AFighterAircraft::SetupPlayerInputComponent(UInputComponent* PlayerInputCom
 	AAircraft::SetupPlayerInputComponent(PlayerInputComponent);
 	if (UEnhancedInputComponent* EnhancedInputComponent = CastChecked<UEnhancedInputComponent>(PlayerInputComponent))
 	{
-		EnhancedInputComponent->BindAction(FireRocketInputAction,			ETriggerEvent::Triggered,	this, &AFighterAircraft::LaunchRocket);
-		EnhancedInputComponent->BindAction(FireProjectileInputAction,		ETriggerEvent::Triggered,	this, &AFighterAircraft::FireTurret);
+		EnhancedInputComponent->BindAction(FireRocketInputAction,			ETriggerEvent::Started,		this, &AFighterAircraft::InputAction_FireRocketStarted);
+		EnhancedInputComponent->BindAction(FireRocketInputAction,			ETriggerEvent::Completed,	this, &AFighterAircraft::InputAction_FireRocketCompleted);
+		EnhancedInputComponent->BindAction(FireProjectileInputAction,		ETriggerEvent::Started,		this, &AFighterAircraft::InputAction_FireTurretStarted);
+		EnhancedInputComponent->BindAction(FireProjectileInputAction,		ETriggerEvent::Completed,	this, &AFighterAircraft::InputAction_FireTurretCompleted);
 		EnhancedInputComponent->BindAction(SwitchTurretModeInputAction,		ETriggerEvent::Started,		this, &AFighterAircraft::InputAction_SwitchTurretMode);
 		EnhancedInputComponent->BindAction(SwitchExplosiveModeInputAction,	ETriggerEvent::Started,		this, &AFighterAircraft::InputAction_SwitchExplosiveMode);
-		EnhancedInputComponent->BindAction(FireProjectileInputAction,		ETriggerEvent::Completed,	this, &AFighterAircraft::SingleFireTurretEnd);
+	}
+}
+
+void AFighterAircraft::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	/*The owner drives its own weapon mode through input, so it is only pushed to the other connections*/
+	FDoRepLifetimeParams WeaponModeParams;
+	WeaponModeParams.bIsPushBased = true;
+	WeaponModeParams.Condition = COND_SkipOwner;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(AFighterAircraft, bMultiTurret, WeaponModeParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AFighterAircraft, bRocketMode, WeaponModeParams);
+}
+
+void AFighterAircraft::GatherPreloadAssets(TArray<FSoftObjectPath>& OutAssets, bool bIncludeCosmetics) const
+{
+	Super::GatherPreloadAssets(OutAssets, bIncludeCosmetics);
+
+	/*Projectiles are gameplay-relevant and always preloaded; casings are cosmetic*/
+	if (ProjectileClass.IsNull() == false)			OutAssets.AddUnique(ProjectileClass.ToSoftObjectPath());
+	if (ProjectileRocketClass.IsNull() == false)	OutAssets.AddUnique(ProjectileRocketClass.ToSoftObjectPath());
+
+	if (bIncludeCosmetics && RocketCasingMesh.IsNull() == false)
+	{
+		OutAssets.AddUnique(RocketCasingMesh.ToSoftObjectPath());
 	}
 }
 
 #pragma region Inputs
+void AFighterAircraft::SetWeaponMode(bool bNewMultiTurret, bool bNewRocketMode)
+{
+	if (bMultiTurret != bNewMultiTurret)
+	{
+		bMultiTurret = bNewMultiTurret;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AFighterAircraft, bMultiTurret, this);
+	}
+	if (bRocketMode != bNewRocketMode)
+	{
+		bRocketMode = bNewRocketMode;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AFighterAircraft, bRocketMode, this);
+	}
+
+	if (HasAuthority() == false)
+	{
+		Server_SetWeaponMode(bMultiTurret, bRocketMode);
+	}
+}
+
+void AFighterAircraft::Server_SetWeaponMode_Implementation(bool bNewMultiTurret, bool bNewRocketMode)
+{
+	SetWeaponMode(bNewMultiTurret, bNewRocketMode);
+}
+
 void AFighterAircraft::InputAction_SwitchTurretMode()
 {
-	bMultiTurret = !bMultiTurret;
+	SetWeaponMode(!bMultiTurret, bRocketMode);
 }
 
 void AFighterAircraft::InputAction_SwitchExplosiveMode()
 {
-	bRocketMode = !bRocketMode;
+	SetWeaponMode(bMultiTurret, !bRocketMode);
+
+	if (HasLocalViewRig() == false) return;
 
 	if (bRocketMode)
 	{
@@ -107,8 +158,8 @@ void AFighterAircraft::InputAction_SwitchExplosiveMode()
 			if (BehindCamera->IsActive() == false)
 				BehindCamera->SetActive(true);
 		}
-		if (TargettingAerialStrikeCamera->IsActive())
-			TargettingAerialStrikeCamera->SetActive(false);
+		if (TargetingAerialStrikeCamera->IsActive())
+			TargetingAerialStrikeCamera->SetActive(false);
 	}
 	else
 	{
@@ -121,312 +172,316 @@ void AFighterAircraft::InputAction_SwitchExplosiveMode()
 		if (FrontCamera->IsActive())
 			FrontCamera->SetActive(false);
 
-		if(TargettingAerialStrikeCamera->IsActive() == false) 
-			TargettingAerialStrikeCamera->SetActive(true);
+		if(TargetingAerialStrikeCamera->IsActive() == false) 
+			TargetingAerialStrikeCamera->SetActive(true);
 	}
 }
 
 /*Camera Functions*/
-void AFighterAircraft::CheckAndFixTargettingCameraModeIfSwitched()
+void AFighterAircraft::CheckAndFixTargetingCameraModeIfSwitched()
 {
-	if (bCameraSwitchedWhileTargettingCameraOn)
+	if (bCameraSwitchedWhileTargetingCameraOn)
 	{
-		bRocketMode = !bRocketMode;
-		bCameraSwitchedWhileTargettingCameraOn = false;
+		SetWeaponMode(bMultiTurret, !bRocketMode);
+		bCameraSwitchedWhileTargetingCameraOn = false;
 	}
 }
 #pragma endregion
 
 #pragma region Fire-Systems
+void AFighterAircraft::SetTriggerHeld(EAircraftWeapon Weapon, bool bHeld)
+{
+	FAircraftFireScheduler& Scheduler = Weapon == EAircraftWeapon::EAW_Turret ? TurretScheduler : RocketScheduler;
+	if (Scheduler.IsTriggerHeld() == bHeld) return;
+
+	Scheduler.SetTriggerHeld(bHeld);
 
+	/*Only the server advances the schedulers; a client forwards its trigger and sees the result as salvo events*/
+	if (HasAuthority() == false)
+	{
+		Server_SetTriggerHeld(Weapon, bHeld);
+	}
+
+	if (Weapon == EAircraftWeapon::EAW_Turret)
+	{
+		if (bHeld)
+		{
+			bTurretFiredSinceTriggerPulled = false;
+		}
+		else
+		{
+			SingleFireTurretEnd();
+		}
+	}
+}
+
+void AFighterAircraft::Server_SetTriggerHeld_Implementation(EAircraftWeapon Weapon, bool bHeld)
+{
+	SetTriggerHeld(Weapon, bHeld);
+}
+
+void AFighterAircraft::OnActivityStateChanged(EAircraftActivityState PreviousState)
+{
+	Super::OnActivityStateChanged(PreviousState);
+
+	/*A pilot leaving with the trigger down, or the aircraft returning to the pool, must not resume firing later*/
+	const EAircraftActivityState State = GetActivityState();
+	if (State == EAircraftActivityState::EAAS_Parked || State == EAircraftActivityState::EAAS_Destroyed)
+	{
+		TurretScheduler.Reset();
+		RocketScheduler.Reset();
+	}
+}
+
+void AFighterAircraft::SerializeHandoffState(FArchive& Ar)
+{
+	Super::SerializeHandoffState(Ar);
 
+	uint8 WeaponFlags = (bMultiTurret ? 1 : 0) | (bRocketMode ? 2 : 0) | (TurretScheduler.IsTriggerHeld() ? 4 : 0) | (RocketScheduler.IsTriggerHeld() ? 8 : 0);
+	float TurretCooldown = TurretScheduler.GetTimeUntilNextRound();
+	float RocketCooldown = RocketScheduler.GetTimeUntilNextRound();
+	Ar << WeaponFlags << TurretCooldown << RocketCooldown;
 
-void AFighterAircraft::FireTurret()
+	if (Ar.IsLoading() == false || Ar.IsError()) return;
+
+	SetWeaponMode((WeaponFlags & 1) != 0, (WeaponFlags & 2) != 0);
+	SetTriggerHeld(EAircraftWeapon::EAW_Turret, (WeaponFlags & 4) != 0);
+	SetTriggerHeld(EAircraftWeapon::EAW_Rocket, (WeaponFlags & 8) != 0);
+	TurretScheduler.SetTimeUntilNextRound(TurretCooldown);
+	RocketScheduler.SetTimeUntilNextRound(RocketCooldown);
+}
+
+void AFighterAircraft::UpdateWeapons(float DeltaTime)
+{
+	if (HasAuthority() == false) return;
+	FAircraftHealthScope HealthScope(EAircraftHealthPhase::EAHP_Weapons);
+
+	/*One update per weapon per frame replaces the per-shot timers; the intervals follow the current weapon mode*/
+	TurretScheduler.SetFireInterval(bMultiTurret ? TurretFireDelay : SingleTurretFireDelay);
+	RocketScheduler.SetFireInterval(RocketFireDelay);
+
+	FAircraftFireScheduler::FRoundAges TurretRoundAges;
+	TurretScheduler.Advance(DeltaTime, TurretRoundAges, IsAerialStrikeViewActive() == false);
+
+	FAircraftFireScheduler::FRoundAges RocketRoundAges;
+	RocketScheduler.Advance(DeltaTime, RocketRoundAges, bRocketMode);
+
+	TArray<FAircraftSalvoEvent> Salvos;
+	FAircraftSalvoEvent Salvo;
+	if (BuildSalvo(EAircraftWeapon::EAW_Turret, TurretRoundAges, Salvo)) Salvos.Add(Salvo);
+	if (BuildSalvo(EAircraftWeapon::EAW_Rocket, RocketRoundAges, Salvo)) Salvos.Add(Salvo);
+	if (Salvos.Num() == 0) return;
+
+	for (const FAircraftSalvoEvent& FiredSalvo : Salvos)
+	{
+		SpawnSalvoRounds(FiredSalvo, 0.0f, false);
+		PlaySalvoEffects(FiredSalvo);
+		if (FiredSalvo.Weapon == EAircraftWeapon::EAW_Turret) bTurretFiredSinceTriggerPulled = true;
+	}
+
+	Multicast_FireSalvos(Salvos);
+	INC_DWORD_STAT_BY(STAT_AircraftSalvoEventsSent, Salvos.Num());
+}
+
+bool AFighterAircraft::BuildSalvo(EAircraftWeapon Weapon, const FAircraftFireScheduler::FRoundAges& RoundAges, FAircraftSalvoEvent& OutSalvo) const
+{
+	if (RoundAges.Num() == 0) return false;
+
+	const bool bSideHardpoints = Weapon == EAircraftWeapon::EAW_Rocket || bMultiTurret;
+	OutSalvo.Weapon = Weapon;
+	OutSalvo.HardpointMask = bSideHardpoints ? (AircraftHardpoint::Right | AircraftHardpoint::Left) : AircraftHardpoint::Middle;
+	OutSalvo.RoundCount = (uint8)RoundAges.Num();
+	OutSalvo.SetFirstRoundAge(RoundAges[0]);
+	OutSalvo.ServerTime = GetWorld()->GetTimeSeconds();
+	OutSalvo.MeshLocation = AircraftMesh->GetComponentLocation();
+	OutSalvo.MeshRotation = AircraftMesh->GetComponentRotation();
+	OutSalvo.RandomSeed = (uint16)FMath::Rand();
+	/*Only rockets report an impact, so only rocket salvos take a number*/
+	UAircraftRocketImpactSubsystem* ImpactSubsystem = Weapon == EAircraftWeapon::EAW_Rocket ? UAircraftRocketImpactSubsystem::Get(this) : nullptr;
+	OutSalvo.Sequence = ImpactSubsystem ? ImpactSubsystem->AllocateSalvoSequence() : 0;
+	OutSalvo.QuantizeTransform();
+	return true;
+}
+
+float AFighterAircraft::GetSalvoFireInterval(const FAircraftSalvoEvent& Salvo) const
 {
-	/*This function, FireTurret(), is responsible for firing turrets on a fighter Aircraft object. It first checks if the turret can fire and if an aerial strike camera is not active. Depending on whether the Aircraft has multiple turrets or not, it calculates the firing direction and spawns projectiles accordingly, accompanied by appropriate sound effects. After firing, it sets a delay before the turret can fire again and logs various checkpoints for debugging purposes. */
-	if (bCanFireTurret == false || TargettingAerialStrikeCamera->IsActive()) return;
+	if (Salvo.Weapon == EAircraftWeapon::EAW_Rocket) return RocketFireDelay;
+	return (Salvo.HardpointMask & AircraftHardpoint::Middle) ? SingleTurretFireDelay : TurretFireDelay;
+}
+
+FName AFighterAircraft::GetHardpointSocketName(EAircraftWeapon Weapon, int32 HardpointIndex)
+{
+	/*Indexed by hardpoint bit: Right, Left, Middle*/
+	static const FName TurretSockets[AircraftHardpoint::Count] = { FName("TurretRight"), FName("TurretLeft"), FName("TurretMiddle") };
+	static const FName RocketSockets[AircraftHardpoint::Count] = { FName("RocketRight"), FName("RocketLeft"), NAME_None };
+
+	return Weapon == EAircraftWeapon::EAW_Turret ? TurretSockets[HardpointIndex] : RocketSockets[HardpointIndex];
+}
 
-	APawn* InstigatorPawn = Cast<APawn>(GetOwner());
+void AFighterAircraft::SpawnSalvoRounds(const FAircraftSalvoEvent& Salvo, float ExtraAge, bool bCosmetic)
+{
 	UWorld* World = GetWorld();
+	if (World == nullptr) return;
 
-	if (bMultiTurret)
+	/*Projectiles are in the class's preload bundle, which every aircraft requests when it begins play. Until it has
+	  streamed in the server loads them synchronously rather than drop gameplay rounds; a client skips its cosmetic copy*/
+	const bool bTurret = Salvo.Weapon == EAircraftWeapon::EAW_Turret;
+	UClass* RoundClass = bTurret ? ProjectileClass.Get() : ProjectileRocketClass.Get();
+	if (RoundClass == nullptr && bCosmetic == false)
 	{
-		if (TurretFireDelay != 0.10f)
-		{
-			TurretFireDelay = 0.10f;
-		}
+		RoundClass = bTurret ? ProjectileClass.LoadSynchronous() : ProjectileRocketClass.LoadSynchronous();
+	}
+	if (RoundClass == nullptr)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: salvo skipped, projectile class '%s' is not loaded"), *GetName(), bTurret ? *ProjectileClass.ToString() : *ProjectileRocketClass.ToString());
+		return;
+	}
+
+	const FTransform MeshTransform(Salvo.MeshRotation, Salvo.MeshLocation, AircraftMesh->GetComponentScale());
+	const float FireInterval = GetSalvoFireInterval(Salvo);
+	const float SpreadRadians = Salvo.Weapon == EAircraftWeapon::EAW_Turret ? FMath::DegreesToRadians(TurretSpreadDegrees) : 0.0f;
+	const FVector AircraftVelocity = GetVelocity();
+	FRandomStream SpreadStream(Salvo.RandomSeed);
+
+	for (int32 HardpointIndex = 0; HardpointIndex < AircraftHardpoint::Count; ++HardpointIndex)
+	{
+		if ((Salvo.HardpointMask & (1 << HardpointIndex)) == 0) continue;
+
+		const UStaticMeshSocket* Socket = AircraftMesh->GetSocketByName(GetHardpointSocketName(Salvo.Weapon, HardpointIndex));
+		if (Socket == nullptr) continue;
+
+		/*Resolved against the transmitted mesh transform rather than the local one, so every machine starts from the same muzzle*/
+		const FTransform SocketTransform = FTransform(Socket->RelativeRotation, Socket->RelativeLocation, Socket->RelativeScale) * MeshTransform;
+		const FVector MuzzleForward = SocketTransform.GetRotation().GetForwardVector();
+		const FVector MuzzleLocation = SocketTransform.GetLocation() + MuzzleForward * 100.0f;
 
-		const UStaticMeshSocket* TurretRightSocket = AircraftsMesh->GetSocketByName(FName("TurretRight"));
-		if (World && TurretRightSocket)
+		for (int32 RoundIndex = 0; RoundIndex < Salvo.RoundCount; ++RoundIndex)
 		{
-			FTransform RightTurretTransform;
-			bool bRightSuccess = TurretRightSocket->GetSocketTransform(RightTurretTransform, AircraftsMesh);
-			if (bRightSuccess)
+			const FVector Direction = SpreadRadians > 0.0f ? SpreadStream.VRandCone(MuzzleForward, SpreadRadians) : MuzzleForward;
+			const FTransform SpawnTransform(FRotationMatrix::MakeFromXZ(Direction, SocketTransform.GetRotation().GetUpVector()).Rotator(), MuzzleLocation);
+
+			/*Salvo rounds never get an actor channel of their own; the salvo event is their replication*/
+			AProjectile* Round = World->SpawnActorDeferred<AProjectile>(RoundClass, SpawnTransform, GetOwner(), Cast<APawn>(GetOwner()));
+			if (Round == nullptr) continue;
+
+			Round->SetCosmeticOnly(bCosmetic);
+			Round->SetReplicates(false);
+			Round->FinishSpawning(SpawnTransform);
+			INC_DWORD_STAT(STAT_AircraftSalvoRoundsSpawned);
+
+			/*
+			* The round left the muzzle RoundAge seconds before the end of the server frame, when the muzzle was
+			* AircraftVelocity * RoundAge further back, and has flown at its launch velocity since, plus ExtraAge on a
+			* client for the time the event took to arrive. The sweep starts at the muzzle so it cannot clip the aircraft
+			* itself and still registers anything the round would have hit on the way.
+			*/
+			const float RoundAge = FMath::Max(Salvo.GetFirstRoundAge() - RoundIndex * FireInterval, 0.0f);
+			FVector LaunchVelocity = Round->GetVelocity();
+			if (LaunchVelocity.IsNearlyZero())
 			{
-				FVector SocketLocation = RightTurretTransform.GetLocation();
-				FVector ForwardVector = RightTurretTransform.GetRotation().GetForwardVector();
-				FVector EndPoint = SocketLocation + ForwardVector * 100.0f;
-
-				FActorSpawnParameters	SpawnParameters;
-				SpawnParameters.Owner = GetOwner();
-				SpawnParameters.Instigator = InstigatorPawn;
-
-				AProjectile* RightProjectile = nullptr;
-				RightProjectile = World->SpawnActor<AProjectile>
-					(
-						ProjectileClass,
-						EndPoint,
-						RightTurretTransform.Rotator(),
-						SpawnParameters
-					);
+				LaunchVelocity = Direction * Round->GetProjectileSpeed();
 			}
 
-			if (TurretFireSound != nullptr)
+			const FVector AgeOffset = (LaunchVelocity - AircraftVelocity) * RoundAge + LaunchVelocity * ExtraAge;
+			if (AgeOffset.IsNearlyZero() == false)
 			{
-				UAudioComponent* SoundComponent = UGameplayStatics::SpawnSoundAttached(TurretFireSound, AircraftsMesh, FName("TurretRight"));
-				if (SoundComponent)
-				{
-					SoundComponent->SetWorldLocationAndRotation(RightTurretTransform.GetLocation(), RightTurretTransform.GetRotation());
-				}
-				//UGameplayStatics::PlaySoundAtLocation(World, TurretFireSound, RightTurretTransform.GetLocation());
+				Round->SetActorLocation(MuzzleLocation + AgeOffset, true);
 			}
-		}
 
-		const UStaticMeshSocket* TurretLeftSocket = AircraftsMesh->GetSocketByName(FName("TurretLeft"));
-		if (World && TurretLeftSocket)
-		{
-			FTransform LeftTurretTransform;
-			bool bRightSuccess = TurretLeftSocket->GetSocketTransform(LeftTurretTransform, AircraftsMesh);
-			if (bRightSuccess)
+			if (AProjectileRocket* Rocket = Cast<AProjectileRocket>(Round))
 			{
-				FVector SocketLocation = LeftTurretTransform.GetLocation();
-				FVector ForwardVector = LeftTurretTransform.GetRotation().GetForwardVector();
-				FVector EndPoint = SocketLocation + ForwardVector * 100.0f;
-
-				FActorSpawnParameters	SpawnParameters;
-				SpawnParameters.Owner = GetOwner();
-				SpawnParameters.Instigator = InstigatorPawn;
-
-				AProjectile* LeftProjectile = nullptr;
-				LeftProjectile = World->SpawnActor<AProjectile>
-					(
-						ProjectileClass,
-						EndPoint,
-						LeftTurretTransform.Rotator(),
-						SpawnParameters
-					);
-			}
-			if (TurretFireSound != nullptr)
-			{
-				UAudioComponent* SoundComponent = UGameplayStatics::SpawnSoundAttached(TurretFireSound, AircraftsMesh, FName("TurretLeft"));
-				if (SoundComponent)
+				/*Every machine integrates the rocket from the same launch state; only the impact is sent later*/
+				const uint32 RocketId = UAircraftRocketImpactSubsystem::MakeRocketId(Salvo.Sequence, HardpointIndex, RoundIndex);
+				Rocket->SetRocketId(RocketId);
+				Rocket->GetRocketMovementComponent()->SetLaunchState(MuzzleLocation - AircraftVelocity * RoundAge, LaunchVelocity, Salvo.ServerTime - RoundAge);
+
+				if (bCosmetic)
 				{
-					SoundComponent->SetWorldLocationAndRotation(LeftTurretTransform.GetLocation(), LeftTurretTransform.GetRotation());
+					if (UAircraftRocketImpactSubsystem* ImpactSubsystem = UAircraftRocketImpactSubsystem::Get(this))
+					{
+						ImpactSubsystem->RegisterCosmeticRocket(RocketId, Rocket);
+					}
 				}
-				//UGameplayStatics::PlaySoundAtLocation(World, TurretFireSound, LeftTurretTransform.GetLocation());
 			}
 		}
 	}
-	else
+}
+
+void AFighterAircraft::PlaySalvoEffects(const FAircraftSalvoEvent& Salvo)
+{
+	if (GetNetMode() == NM_DedicatedServer) return;
+
+	/*Sounds and casings are played once per hardpoint per salvo, however many rounds the frame owed*/
+	if (Salvo.Weapon == EAircraftWeapon::EAW_Rocket)
 	{
-		if (TurretFireDelay != 0.05f)
-		{
-			TurretFireDelay = 0.05f;
-		}
-		const UStaticMeshSocket* TurretMiddleSocket = AircraftsMesh->GetSocketByName(FName("TurretMiddle"));
-		if (World && TurretMiddleSocket)
+		EjectRocketCasings();
+		return;
+	}
+
+	USoundCue* FireSound = (Salvo.HardpointMask & AircraftHardpoint::Middle) ? SingleTurretFireSoundStart : TurretFireSound;
+	if (FireSound == nullptr) return;
+
+	for (int32 HardpointIndex = 0; HardpointIndex < AircraftHardpoint::Count; ++HardpointIndex)
+	{
+		if (Salvo.HardpointMask & (1 << HardpointIndex))
 		{
-			FTransform MiddleTurretTransform;
-			bool bMiddleSuccess = TurretMiddleSocket->GetSocketTransform(MiddleTurretTransform, AircraftsMesh);
-			if (bMiddleSuccess)
-			{
-				FVector SocketLocation = MiddleTurretTransform.GetLocation();
-				FVector ForwardVector = MiddleTurretTransform.GetRotation().GetForwardVector();
-				FVector EndPoint = SocketLocation + ForwardVector * 100.0f;
-
-				FActorSpawnParameters	SpawnParameters;
-				SpawnParameters.Owner = GetOwner();
-				SpawnParameters.Instigator = InstigatorPawn;
-
-				AProjectile* LeftProjectile = nullptr;
-				LeftProjectile = World->SpawnActor<AProjectile>
-					(
-						ProjectileClass,
-						EndPoint,
-						MiddleTurretTransform.Rotator(),
-						SpawnParameters
-					);
-			}
-			if (SingleTurretFireSoundStart != nullptr)
-			{
-				UAudioComponent* SoundComponent = UGameplayStatics::SpawnSoundAttached(SingleTurretFireSoundStart, AircraftsMesh, FName("TurretMiddle"));
-				if (SoundComponent)
-				{
-					SoundComponent->SetWorldLocationAndRotation(MiddleTurretTransform.GetLocation(), MiddleTurretTransform.GetRotation());
-				}
-				//UGameplayStatics::PlaySoundAtLocation(World, TurretFireSound, LeftTurretTransform.GetLocation());
-			}
+			UGameplayStatics::SpawnSoundAttached(FireSound, AircraftMesh, GetHardpointSocketName(Salvo.Weapon, HardpointIndex));
 		}
 	}
-	bCanFireTurret = false;
-
-	GetWorldTimerManager().SetTimer
-	(
-		TurretTimer,
-		this,
-		&AFighterAircraft::TurretTimerFinished,
-		TurretFireDelay
-	);
+}
+
+void AFighterAircraft::Multicast_FireSalvos_Implementation(const TArray<FAircraftSalvoEvent>& Salvos)
+{
+	/*The server spawned the gameplay rounds itself*/
+	if (HasAuthority()) return;
+
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	for (const FAircraftSalvoEvent& Salvo : Salvos)
+	{
+		const float TimeSinceFired = GameState ? FMath::Clamp((float)GameState->GetServerWorldTimeSeconds() - Salvo.ServerTime, 0.0f, MaxSalvoCatchUpTime) : 0.0f;
+
+		SpawnSalvoRounds(Salvo, TimeSinceFired, true);
+		PlaySalvoEffects(Salvo);
+		if (Salvo.Weapon == EAircraftWeapon::EAW_Turret) bTurretFiredSinceTriggerPulled = true;
+	}
 }
 
 void AFighterAircraft::SingleFireTurretEnd()
 {
-	if (bMultiTurret == true || TargettingAerialStrikeCamera->IsActive()) return;
+	if (bMultiTurret == true || bTurretFiredSinceTriggerPulled == false || IsAerialStrikeViewActive()) return;
 	if (SingleTurretFireSoundEnd != nullptr)
 	{
-		const UStaticMeshSocket* TurretMiddleSocket = AircraftsMesh->GetSocketByName(FName("TurretMiddle"));
+		const UStaticMeshSocket* TurretMiddleSocket = AircraftMesh->GetSocketByName(FName("TurretMiddle"));
 		if (TurretMiddleSocket)
 		{
 			FTransform MiddleTurretTransform;
-			bool bMiddleSuccess = TurretMiddleSocket->GetSocketTransform(MiddleTurretTransform, AircraftsMesh);
+			bool bMiddleSuccess = TurretMiddleSocket->GetSocketTransform(MiddleTurretTransform, AircraftMesh);
 			if (bMiddleSuccess)
 			{
-				UAudioComponent* SoundComponent = UGameplayStatics::SpawnSoundAttached(SingleTurretFireSoundEnd, AircraftsMesh, FName("TurretMiddle"));
+				UAudioComponent* SoundComponent = UGameplayStatics::SpawnSoundAttached(SingleTurretFireSoundEnd, AircraftMesh, FName("TurretMiddle"));
 				if (SoundComponent)
 				{
 					SoundComponent->SetWorldLocationAndRotation(MiddleTurretTransform.GetLocation(), MiddleTurretTransform.GetRotation());
 				}
-				//UGameplayStatics::PlaySoundAtLocation(World, TurretFireSound, LeftTurretTransform.GetLocation());
 			}
 		}
 	}
 }
 
-void AFighterAircraft::TurretTimerFinished()
+void AFighterAircraft::EjectRocketCasings()
 {
-	bCanFireTurret = true;
-}
+	UStaticMesh* LoadedRocketCasingMesh = RocketCasingMesh.Get();
+	if (LoadedRocketCasingMesh == nullptr) return;
 
-void AFighterAircraft::LaunchRocket()
-{
-	if (bRocketMode)
-	{
-		if (bCanFireRocket == false) return;
-
-		APawn* InstigatorPawn = Cast<APawn>(GetOwner());
-		UWorld* World = GetWorld();
-		const UStaticMeshSocket* RocketRightSocket = AircraftsMesh->GetSocketByName(FName("RocketRight"));
-		if (World && RocketRightSocket)
-		{
-			FTransform RightSocketTransform;
-			bool bRightSuccess = RocketRightSocket->GetSocketTransform(RightSocketTransform, AircraftsMesh);
-			if (bRightSuccess)
-			{
-				FVector SocketLocation = RightSocketTransform.GetLocation();
-				FVector ForwardVector = RightSocketTransform.GetRotation().GetForwardVector();
-				FVector EndPoint = SocketLocation + ForwardVector * 100.0f;
-
-				FActorSpawnParameters	SpawnParameters;
-				SpawnParameters.Owner = GetOwner();
-				SpawnParameters.Instigator = InstigatorPawn;
-
-				AProjectileRocket* RightProjectileRocket = nullptr;
-				RightProjectileRocket = World->SpawnActor<AProjectileRocket>
-					(
-						ProjectileRocketClass,
-						EndPoint,
-						RightSocketTransform.Rotator(),
-						SpawnParameters
-					);
-			}
-		}
-
-		const UStaticMeshSocket* RocketLeftSocket = AircraftsMesh->GetSocketByName(FName("RocketLeft"));
-		if (World && RocketLeftSocket)
-		{
-			FTransform LeftSocketTransform;
-			bool bLeftSuccess = RocketLeftSocket->GetSocketTransform(LeftSocketTransform, AircraftsMesh);
-			if (bLeftSuccess)
-			{
-				FVector SocketLocation = LeftSocketTransform.GetLocation();
-				FVector ForwardVector = LeftSocketTransform.GetRotation().GetForwardVector();
-				FVector EndPoint = SocketLocation + ForwardVector * 100.0f;
-
-				FActorSpawnParameters	SpawnParameters;
-				SpawnParameters.Owner = GetOwner();
-				SpawnParameters.Instigator = InstigatorPawn;
-
-				AProjectileRocket* LeftProjectileRocket = nullptr;
-				LeftProjectileRocket = World->SpawnActor<AProjectileRocket>
-					(
-						ProjectileRocketClass,
-						EndPoint,
-						LeftSocketTransform.Rotator(),
-						SpawnParameters
-					);
-			}
-		}
-
-		if (RocketAmmoEjectClass)
-		{
-			const UStaticMeshSocket* RightRocketAmmoEjectSocket = AircraftsMesh->GetSocketByName(FName("RocketAmmoEjectRight"));
-			if (RightRocketAmmoEjectSocket != nullptr)
-			{
-				FTransform RightRocketEjectSocketTransform;
-				bool bRightSuccess = RightRocketAmmoEjectSocket->GetSocketTransform(RightRocketEjectSocketTransform, AircraftsMesh);
-				if (bRightSuccess)
-				{
-					if (World)
-					{
-						World->SpawnActor<AAmmoEject>
-							(
-								RocketAmmoEjectClass,
-								RightRocketEjectSocketTransform.GetLocation(),
-								RightRocketEjectSocketTransform.GetRotation().Rotator()
-							);
-					}
-				}
-			}
-
-			const UStaticMeshSocket* LeftRocketAmmoEjectSocket = AircraftsMesh->GetSocketByName(FName("RocketAmmoEjectLeft"));
-			if (LeftRocketAmmoEjectSocket != nullptr)
-			{
-				FTransform LeftRocketEjectSocketTransform;
-				bool bLeftSuccess = LeftRocketAmmoEjectSocket->GetSocketTransform(LeftRocketEjectSocketTransform, AircraftsMesh);
-				if (bLeftSuccess)
-				{
-					if (World)
-					{
-						World->SpawnActor<AAmmoEject>
-							(
-								RocketAmmoEjectClass,
-								LeftRocketEjectSocketTransform.GetLocation(),
-								LeftRocketEjectSocketTransform.GetRotation().Rotator()
-							);
-					}
-				}
-			}
-		}
-		bCanFireRocket = false;
-
-		GetWorldTimerManager().SetTimer
-		(
-			RocketTimer,
-			this,
-			&AFighterAircraft::RocketFireTimerFinished,
-			RocketFireDelay
-		);
-	}
-	else
+	static const FName EjectSockets[] = { FName("RocketAmmoEjectRight"), FName("RocketAmmoEjectLeft") };
+	for (const FName& EjectSocket : EjectSockets)
 	{
+		const UStaticMeshSocket* AmmoEjectSocket = AircraftMesh->GetSocketByName(EjectSocket);
+		FTransform EjectTransform;
+		if (AmmoEjectSocket == nullptr || AmmoEjectSocket->GetSocketTransform(EjectTransform, AircraftMesh) == false) continue;
 
+		const FVector EjectVelocity = GetVelocity() + EjectTransform.GetRotation().GetForwardVector() * RocketCasingEjectSpeed + FMath::VRand() * (RocketCasingEjectSpeed * 0.1f);
+		UAircraftCasingSubsystem::SpawnCasing(this, GetClass(), LoadedRocketCasingMesh, EjectTransform, EjectVelocity);
 	}
-
-
-}
-
-void AFighterAircraft::RocketFireTimerFinished()
-{
-	bCanFireRocket = true;
 }
 #pragma endregion
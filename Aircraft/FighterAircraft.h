@@ -9,13 +9,15 @@
 
 #include "CoreMinimal.h"
 #include "Aeronautical/Aircraft.h"
+#include "AircraftFireScheduler.h"
+#include "AircraftSalvo.h"
 #include "FighterAircraft.generated.h"
 
 class UAnimationAsset;
-class AAmmoEject;
 class AProjectile;
 class AProjectileRocket;
 class USoundCue;
+class UStaticMesh;
 
 UCLASS()
 class AIRCRAFT_API AFighterAircraft : public AAircraft
@@ -29,8 +31,14 @@ protected:
 	virtual void BeginPlay() override;
 	virtual void Tick(float DeltaTime) override;
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
-	
-	float ResetDataTimer;
+
+	virtual void GetLifetimeReplicatedProps(TArray< FLifetimeProperty >& OutLifetimeProps) const override;
+
+public:
+	virtual void GatherPreloadAssets(TArray<FSoftObjectPath>& OutAssets, bool bIncludeCosmetics) const override;
+
+	/*Adds weapon mode, triggers and both weapons' cooldowns to the base flight and health state*/
+	virtual void SerializeHandoffState(FArchive& Ar) override;
 
 #pragma region Inputs
 private:
@@ -50,42 +58,88 @@ private:
 	void InputAction_SwitchTurretMode();
 	void InputAction_SwitchExplosiveMode();
 
+	void SetWeaponMode(bool bNewMultiTurret, bool bNewRocketMode);
+
+	UFUNCTION(Server, Reliable)
+	void Server_SetWeaponMode(bool bNewMultiTurret, bool bNewRocketMode);
+
 public:
 	/*Variables*/
+	UPROPERTY(Replicated)
 	bool bMultiTurret = true;
+
+	UPROPERTY(Replicated)
 	bool bRocketMode = true;
 
 	/*Camera*/
-	void CheckAndFixTargettingCameraModeIfSwitched();
+	void CheckAndFixTargetingCameraModeIfSwitched();
+	bool IsAerialStrikeViewActive() const;
+
+protected:
+	virtual void CreateLocalViewRig() override;
 #pragma endregion
 
 #pragma region Fire-Systems
 private:
-	bool bCanFireRocket = true;
-	bool bCanFireTurret = true;
+	/*Server only: advances the fire schedulers and turns the rounds they owe into this frame's salvo events*/
+	void UpdateWeapons(float DeltaTime);
+
+	bool BuildSalvo(EAircraftWeapon Weapon, const FAircraftFireScheduler::FRoundAges& RoundAges, FAircraftSalvoEvent& OutSalvo) const;
+
+	/*Spawns the rounds of a salvo, each aged to where it would be now; the server's are gameplay rounds, clients' are cosmetic*/
+	void SpawnSalvoRounds(const FAircraftSalvoEvent& Salvo, float ExtraAge, bool bCosmetic);
+	void PlaySalvoEffects(const FAircraftSalvoEvent& Salvo);
+	float GetSalvoFireInterval(const FAircraftSalvoEvent& Salvo) const;
+	static FName GetHardpointSocketName(EAircraftWeapon Weapon, int32 HardpointIndex);
+
+	/*Everything one aircraft fired in one server frame, in a single unreliable call*/
+	UFUNCTION(NetMulticast, Unreliable)
+	void Multicast_FireSalvos(const TArray<FAircraftSalvoEvent>& Salvos);
+
+	void SetTriggerHeld(EAircraftWeapon Weapon, bool bHeld);
 
-	void FireTurret();
-	void LaunchRocket();
+	UFUNCTION(Server, Reliable)
+	void Server_SetTriggerHeld(EAircraftWeapon Weapon, bool bHeld);
 
+	void EjectRocketCasings();
 	void SingleFireTurretEnd();
 
-	void TurretTimerFinished();
-	void RocketFireTimerFinished();
+	void InputAction_FireTurretStarted()	{ SetTurretTriggerHeld(true); }
+	void InputAction_FireTurretCompleted()	{ SetTurretTriggerHeld(false); }
+	void InputAction_FireRocketStarted()	{ SetRocketTriggerHeld(true); }
+	void InputAction_FireRocketCompleted()	{ SetRocketTriggerHeld(false); }
 
-	FTimerHandle TurretTimer;
-	FTimerHandle RocketTimer;
+public:
+	/*Trigger entry points shared by player input and non-input pilots such as AAircraftBotController*/
+	void SetTurretTriggerHeld(bool bHeld) { SetTriggerHeld(EAircraftWeapon::EAW_Turret, bHeld); }
+	void SetRocketTriggerHeld(bool bHeld) { SetTriggerHeld(EAircraftWeapon::EAW_Rocket, bHeld); }
+
+protected:
+	virtual void OnActivityStateChanged(EAircraftActivityState PreviousState) override;
+
+private:
+	FAircraftFireScheduler TurretScheduler;
+	FAircraftFireScheduler RocketScheduler;
+
+	/*Whether any turret round left the gun since the trigger was pulled, so the single-turret end sound only follows actual fire*/
+	bool bTurretFiredSinceTriggerPulled = false;
 
 	UPROPERTY(EditAnywhere, Category = "WeaponSettings")
-	TSubclassOf<AProjectileRocket> ProjectileRocketClass;
+	TSoftClassPtr<AProjectileRocket> ProjectileRocketClass;
 
 	UPROPERTY(EditAnywhere, Category = "WeaponSettings")
-	TSubclassOf<AProjectile> ProjectileClass;
+	TSoftClassPtr<AProjectile> ProjectileClass;
 
 	UPROPERTY(EditAnywhere, Category = "WeaponSettings")
 	TSubclassOf<AProjectile> ServerSideRewindProjectileClass;
 
+	/*Drawn as instances by UAircraftCasingSubsystem, one per rocket ammo-eject socket and launch*/
+	UPROPERTY(EditAnywhere, Category = "Developer Properties")
+	TSoftObjectPtr<UStaticMesh> RocketCasingMesh;
+
+	/*Speed along the ammo-eject socket's forward axis, on top of the aircraft's own velocity*/
 	UPROPERTY(EditAnywhere, Category = "Developer Properties")
-	TSubclassOf<AAmmoEject> RocketAmmoEjectClass;
+	float RocketCasingEjectSpeed = 800.0f;
 
 	/*TODO : optional weapon animation play*/
 	UPROPERTY(EditAnywhere, Category = "Developer Properties")
@@ -99,6 +153,17 @@ protected:
 	UPROPERTY(EditAnywhere)
 	float TurretFireDelay = 0.10f;
 
+	UPROPERTY(EditAnywhere)
+	float SingleTurretFireDelay = 0.05f;
+
+	/*Half angle of the turret spread cone, drawn from the salvo's random seed so clients reproduce it*/
+	UPROPERTY(EditAnywhere)
+	float TurretSpreadDegrees = 0.0f;
+
+	/*Salvos arriving later than this are only aged this far, so a lag spike does not place rounds far down range*/
+	UPROPERTY(EditAnywhere)
+	float MaxSalvoCatchUpTime = 0.25f;
+
 	UPROPERTY(EditAnywhere)
 	float RocketFireDelay = 7.5f;
 #pragma endregion
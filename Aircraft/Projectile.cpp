@@ -3,6 +3,8 @@
 
 #include "Weapon/Projectile.h"
 
+#include "Aeronautical/AircraftExplosionSubsystem.h"
+#include "Aeronautical/AircraftImpactEffectSubsystem.h"
 #include "Components/BoxComponent.h"
 #include "Components/CombatComponent.h"
 #include "Kismet/GameplayStatics.h"
@@ -40,7 +42,7 @@ void AProjectile::BeginPlay()
 {
 	Super::BeginPlay();
 
-	if (ProjectileTracer)
+	if (ProjectileTracer && GetNetMode() != NM_DedicatedServer)
 	{
 		TracerComponent = UGameplayStatics::SpawnEmitterAttached
 		(
@@ -49,7 +51,9 @@ void AProjectile::BeginPlay()
 			FName(),
 			GetActorLocation(),
 			GetActorRotation(),
-			EAttachLocation::KeepWorldPosition
+			EAttachLocation::KeepWorldPosition,
+			false,
+			EPSCPoolMethod::ManualRelease
 		);
 	}
 	if (HasAuthority())
@@ -73,38 +77,34 @@ void AProjectile::Tick(float DeltaTime)
 void AProjectile::ExplodeDamage()
 {
 	APawn* FiringPawn = GetInstigator();
-	if (FiringPawn && HasAuthority())
+	if (FiringPawn && HasAuthority() && bCosmeticOnly == false)
 	{
 		AController* FiringController = FiringPawn->GetController();
 		if (FiringController)
 		{
-			UGameplayStatics::ApplyRadialDamageWithFalloff(
-				this,						// World context object
-				Damage,						// BaseDamage
-				MinimumDamage,				// MinimumDamage
-				GetActorLocation(),			// Origin
-				DamageInnerRadius,			// DamageInnerRadius
-				DamageOuterRadius,			// DamageOuterRadius
-				DamageFalloff,				// DamageFalloff
-				UDamageType::StaticClass(), // DamageTypeClass
-				TArray<AActor*>(),			// IgnoreActors
-				this,						// DamageCauser
-				FiringController			// InstigatorController
-			);
-
+			FAircraftRadialDamageRequest Request;
+			Request.BaseDamage				= Damage;
+			Request.MinimumDamage			= MinimumDamage;
+			Request.Origin					= GetActorLocation();
+			Request.InnerRadius				= DamageInnerRadius;
+			Request.OuterRadius				= DamageOuterRadius;
+			Request.Falloff					= DamageFalloff;
+			Request.DamageTypeClass			= UDamageType::StaticClass();
+			Request.DamageCauser			= this;
+			Request.InstigatorController	= FiringController;
+
+			UAircraftExplosionSubsystem::ApplyRadialDamage(this, Request);
 		}
 	}
 }
 
 void AProjectile::StartDestroyTimer()
 {
-	GetWorldTimerManager().SetTimer
-	(
-		DestroyTimer,
-		this,
-		&AProjectile::DestroyTimerFinished,
-		DestroyTime
-	);
+	if (UAircraftTimerWheelSubsystem* TimerWheel = UAircraftTimerWheelSubsystem::Get(this))
+	{
+		TimerWheel->ClearTimer(DestroyTimer);
+		DestroyTimer = TimerWheel->SetTimer(DestroyTime, FSimpleDelegate::CreateUObject(this, &AProjectile::DestroyTimerFinished));
+	}
 }
 
 void AProjectile::DestroyTimerFinished()
@@ -112,26 +112,47 @@ void AProjectile::DestroyTimerFinished()
 	Destroy();
 }
 
-void AProjectile::Destroyed()
+void AProjectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Destroyed();
-
-	if (ImpactParticles)
+	if (UAircraftTimerWheelSubsystem* TimerWheel = UAircraftTimerWheelSubsystem::Get(this))
 	{
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ImpactParticles, GetActorTransform());
+		TimerWheel->ClearTimer(DestroyTimer);
 	}
 
-	if (ImpactSound)
+	/*Tracers come from the world's particle component pool and go back to it with the projectile*/
+	if (TracerComponent)
 	{
-		UGameplayStatics::SpawnSoundAtLocation(this, ImpactSound, GetActorLocation());
+		TracerComponent->ReleaseToPool();
+		TracerComponent = nullptr;
 	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AProjectile::Destroyed()
+{
+	Super::Destroyed();
+
+	SpawnImpactEffects(GetWorld(), GetActorTransform());
 }
 
 
+void AProjectile::SpawnImpactEffects(UWorld* World, const FTransform& ImpactTransform) const
+{
+	/*Sustained fire produces hundreds of impacts a second; the subsystem merges and budgets them*/
+	FAircraftImpactEffectRequest Request;
+	Request.System			= ImpactSystem;
+	Request.LegacyParticles	= ImpactParticles;
+	Request.Sound			= ImpactSound;
+	Request.Location		= ImpactTransform.GetLocation();
+	Request.Rotation		= ImpactTransform.Rotator();
+
+	UAircraftImpactEffectSubsystem::SpawnImpactEffect(World, Request);
+}
 
 void AProjectile::SpawnTrailSystem()
 {
-	if (TrailSystem)
+	if (TrailSystem && GetNetMode() != NM_DedicatedServer)
 	{
 		TrailSystemComponent = UNiagaraFunctionLibrary::SpawnSystemAttached
 		(
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Aeronautical/AircraftTimerWheel.h"
 #include "Projectile.generated.h"
 
 UCLASS()
@@ -16,6 +17,7 @@ protected:
 	virtual void BeginPlay()			override;
 	virtual void Tick(float DeltaTime)	override;
 	virtual void Destroyed()			override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	void ExplodeDamage();
 
@@ -45,6 +47,10 @@ protected:
 	class UBoxComponent* CollisionBox;
 
 
+	/*Pooled and merged by UAircraftImpactEffectSubsystem; ImpactParticles is only used when this is not set*/
+	UPROPERTY(EditAnywhere, Category = "WeaponSettings")
+	class UNiagaraSystem* ImpactSystem;
+
 	UPROPERTY(EditAnywhere, Category = "WeaponSettings")
 	class UParticleSystem* ImpactParticles;
 
@@ -77,11 +83,24 @@ public:
 	float HeadShotDamage = 40.0f;
 
 protected:
-	FTimerHandle DestroyTimer;
+	FAircraftTimerHandle DestroyTimer;
 
 	UPROPERTY(EditAnywhere, Category = "WeaponSettings")
 	float DestroyTime = 3.0f;
 
+#pragma region Salvo
+protected:
+	/*Rebuilt on a client from a salvo event: flies, hits and plays impact effects, but never applies damage*/
+	bool bCosmeticOnly = false;
+
+public:
+	/*Requests this class's impact effect and sound at a transform; usable on the class default object*/
+	void SpawnImpactEffects(UWorld* World, const FTransform& ImpactTransform) const;
+
+	FORCEINLINE bool IsCosmeticOnly() const { return bCosmeticOnly; }
+	FORCEINLINE void SetCosmeticOnly(bool SetValue) { bCosmeticOnly = SetValue; }
+#pragma endregion
+
 #pragma region ServerSide-Rewind
 protected:
 	bool bUseServerSideRewind = false;
@@ -9,8 +9,14 @@
 #include "Kismet/GameplayStatics.h"
 #include "NiagaraComponent.h"
 #include "NiagaraSystemInstance.h"
+#include "GameFramework/GameStateBase.h"
 #include "Sound/SoundCue.h"
-#include "Aeronautical/Aerodyne.h"
+#include "Aeronautical/Aircraft.h"
+#include "Aeronautical/AircraftStats.h"
+#include "Aeronautical/AircraftRocketImpactSubsystem.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Rocket Path Corrections"),		STAT_AircraftRocketPathCorrections,		STATGROUP_Aircraft);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Rocket Impact Corrections"),	STAT_AircraftRocketImpactCorrections,	STATGROUP_Aircraft);
 
 AProjectileRocket::AProjectileRocket()
 {
@@ -20,7 +26,6 @@ AProjectileRocket::AProjectileRocket()
 
 	RocketMovementComponent = CreateDefaultSubobject<URocketMovementComponent>(TEXT("RocketMovementComponent"));
 	RocketMovementComponent->bRotationFollowsVelocity = true;
-	RocketMovementComponent->SetIsReplicated(true);
 	RocketMovementComponent->InitialSpeed	= 5000.f;
 	RocketMovementComponent->MaxSpeed		= 7000.0f;
 	RocketMovementComponent->ProjectileGravityScale = 0.05f;
@@ -30,11 +35,6 @@ void AProjectileRocket::BeginPlay()
 {
 	Super::BeginPlay();
 
-	if (!HasAuthority())
-	{
-		CollisionBox->OnComponentHit.AddDynamic(this, &AProjectileRocket::OnHit);
-	}
-	
 	SpawnTrailSystem();
 	if (RocketProjectileLoop && RocketProjectileLoopingSoundAttenuation)
 	{
@@ -56,42 +56,96 @@ void AProjectileRocket::BeginPlay()
 	}
 }
 
-void AProjectileRocket::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
+void AProjectileRocket::Tick(float DeltaTime)
 {
-	if (OtherActor == GetOwner())
+	Super::Tick(DeltaTime);
+
+	if (bCosmeticOnly && bImpacted == false && RocketMovementComponent->HasLaunchState())
 	{
-		return;
+		CorrectDivergence();
 	}
+}
+
+void AProjectileRocket::CorrectDivergence()
+{
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	if (GameState == nullptr) return;
+
+	FVector ExpectedLocation;
+	FVector ExpectedVelocity;
+	RocketMovementComponent->PredictState(GameState->GetServerWorldTimeSeconds() - RocketMovementComponent->GetLaunchServerTime(), ExpectedLocation, ExpectedVelocity);
 
-	if (OtherActor->IsA(AAerodyne::StaticClass()))
+	if (FVector::DistSquared(ExpectedLocation, GetActorLocation()) > FMath::Square(DivergenceTolerance))
 	{
+		SetActorLocation(ExpectedLocation, false, nullptr, ETeleportType::TeleportPhysics);
+		RocketMovementComponent->Velocity = ExpectedVelocity;
+		INC_DWORD_STAT(STAT_AircraftRocketPathCorrections);
+	}
+}
 
-		float MinRocketDamage = 150.0f;
-		float MaxRocketDamage = 450.0f;
-		float RandomDamageRate = FMath::FRandRange(MinRocketDamage, MaxRocketDamage);
+void AProjectileRocket::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
+{
+	if (OtherActor == GetOwner() || bImpacted)
+	{
+		return;
+	}
 
-		UGameplayStatics::ApplyDamage
-		(
-			OtherActor,
-			RandomDamageRate,
-			GetOwner()->GetInstigatorController(),
-			this,
-			UDamageType::StaticClass()
-		);
+	if (bCosmeticOnly == false)
+	{
+		if (OtherActor && OtherActor->IsA(AAircraft::StaticClass()))
+		{
+			float MinRocketDamage = 150.0f;
+			float MaxRocketDamage = 450.0f;
+			float RandomDamageRate = FMath::FRandRange(MinRocketDamage, MaxRocketDamage);
+
+			UGameplayStatics::ApplyDamage
+			(
+				OtherActor,
+				RandomDamageRate,
+				GetOwner()->GetInstigatorController(),
+				this,
+				UDamageType::StaticClass()
+			);
+		}
+
+		ExplodeDamage();
+
+		/*The second and last network event of the rocket's life, after the salvo that launched it*/
+		if (UAircraftRocketImpactSubsystem* ImpactSubsystem = UAircraftRocketImpactSubsystem::Get(this))
+		{
+			ImpactSubsystem->SendRocketImpact(RocketId, GetClass(), GetActorLocation());
+		}
 	}
 
-	ExplodeDamage();
-	StartDestroyTimer();
+	PlayImpact();
+}
 
-	if (ImpactParticles)
+void AProjectileRocket::ApplyServerImpact(const FVector& ServerImpactLocation)
+{
+	if (bImpacted && FVector::DistSquared(ImpactLocation, ServerImpactLocation) <= FMath::Square(ImpactCorrectionTolerance))
 	{
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ImpactParticles, GetActorTransform());
+		return;
 	}
 
-	if (ImpactSound)
+	SetActorLocation(ServerImpactLocation, false, nullptr, ETeleportType::TeleportPhysics);
+	INC_DWORD_STAT(STAT_AircraftRocketImpactCorrections);
+
+	if (bImpacted)
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, ImpactSound, GetActorLocation());
+		/*The local rocket exploded somewhere else; the explosion that counted is shown where it happened*/
+		SpawnImpactEffects(GetWorld(), GetActorTransform());
+		return;
 	}
+	PlayImpact();
+}
+
+void AProjectileRocket::PlayImpact()
+{
+	bImpacted = true;
+	ImpactLocation = GetActorLocation();
+
+	StartDestroyTimer();
+	SpawnImpactEffects(GetWorld(), GetActorTransform());
 
 	if (ProjectileMesh)
 	{
@@ -7,7 +7,6 @@
 #include "Projectile.h"
 #include "ProjectileRocket.generated.h"
 
-
 UCLASS()
 class AIRCRAFT_API AProjectileRocket : public AProjectile
 {
@@ -20,6 +19,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void Tick(float DeltaTime) override;
 
 	virtual void OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit) override;
 
@@ -37,6 +37,33 @@ private:
 	UPROPERTY(EditAnywhere, Category = "WeaponSettings")
 	USoundAttenuation* RocketProjectileLoopingSoundAttenuation;
 
+#pragma region Launch-And-Impact
+public:
+	/*Rockets are not replicated: the launch comes from a salvo event and the impact through UAircraftRocketImpactSubsystem*/
+	void SetRocketId(uint32 InRocketId) { RocketId = InRocketId; }
+
+	/*Client side: the server's rocket hit at ServerImpactLocation; corrects the local one only if it diverged*/
+	void ApplyServerImpact(const FVector& ServerImpactLocation);
+
+private:
+	void PlayImpact();
+
+	/*Snaps a cosmetic rocket back onto the launch path when it drifted further than DivergenceTolerance*/
+	void CorrectDivergence();
+
+	uint32 RocketId = 0;
+
+	bool bImpacted = false;
+	FVector ImpactLocation = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, Category = "WeaponSettings")
+	float DivergenceTolerance = 500.0f;
+
+	/*A predicted impact this close to the server's needs no correction*/
+	UPROPERTY(EditAnywhere, Category = "WeaponSettings")
+	float ImpactCorrectionTolerance = 300.0f;
+#pragma endregion
+
 public:
 	FORCEINLINE URocketMovementComponent* GetRocketMovementComponent() const { return RocketMovementComponent; }
 };
@@ -1,5 +1,48 @@
 #include "Components/RocketMovementComponent.h"
 
+URocketMovementComponent::URocketMovementComponent()
+{
+	/*Fixed-size substeps keep the integrated path the same whatever the frame rate of the machine simulating it*/
+	bForceSubStepping = true;
+	MaxSimulationTimeStep = 1.0f / 60.0f;
+	MaxSimulationIterations = 8;
+}
+
+void URocketMovementComponent::SetLaunchState(const FVector& InLaunchLocation, const FVector& InLaunchVelocity, double InLaunchServerTime)
+{
+	LaunchLocation = InLaunchLocation;
+	LaunchVelocity = InLaunchVelocity;
+	LaunchServerTime = InLaunchServerTime;
+	bHasLaunchState = true;
+}
+
+void URocketMovementComponent::PredictState(float TimeSinceLaunch, FVector& OutLocation, FVector& OutVelocity) const
+{
+	const FVector Gravity(0.0f, 0.0f, GetGravityZ());
+	const float Time = FMath::Max(TimeSinceLaunch, 0.0f);
+	const float RocketMaxSpeed = GetMaxSpeed();
+
+	/*Under constant gravity the path is exact in closed form while the speed stays below MaxSpeed at both ends*/
+	const FVector UnclampedVelocity = LaunchVelocity + Gravity * Time;
+	if (RocketMaxSpeed <= 0.0f || UnclampedVelocity.SizeSquared() <= FMath::Square(RocketMaxSpeed))
+	{
+		OutLocation = LaunchLocation + LaunchVelocity * Time + Gravity * (0.5f * Time * Time);
+		OutVelocity = UnclampedVelocity;
+		return;
+	}
+
+	/*Past MaxSpeed the velocity is rescaled every substep, so step through it like ComputeMoveDelta does*/
+	OutLocation = LaunchLocation;
+	OutVelocity = LaunchVelocity;
+	for (float Remaining = Time; Remaining > 0.0f; Remaining -= MaxSimulationTimeStep)
+	{
+		const float Step = FMath::Min(Remaining, MaxSimulationTimeStep);
+		const FVector NewVelocity = (OutVelocity + Gravity * Step).GetClampedToMaxSize(RocketMaxSpeed);
+		OutLocation += OutVelocity * Step + (NewVelocity - OutVelocity) * (0.5f * Step);
+		OutVelocity = NewVelocity;
+	}
+}
+
 URocketMovementComponent::EHandleBlockingHitResult URocketMovementComponent::HandleBlockingHit(const FHitResult& Hit, float TimeTick, const FVector& MoveDelta, float& SubTickTimeRemaining)
 {
 	Super::HandleBlockingHit(Hit, TimeTick, MoveDelta, SubTickTimeRemaining);
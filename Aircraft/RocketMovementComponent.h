@@ -5,12 +5,31 @@
 #include "RocketMovementComponent.generated.h"
 
 /**
- * 
+ * Rocket flight with a launch state every machine integrates from.
+ * The server and the clients spawn rockets from the same salvo event, so PredictState reproduces the server's flight
+ * path from the launch location, velocity and server time alone; clients use it to correct their local rocket only
+ * when it has drifted from that path, instead of having the movement replicated.
  */
 UCLASS()
 class AIRCRAFT_API URocketMovementComponent : public UProjectileMovementComponent
 {
 	GENERATED_BODY()
+
+public:
+	URocketMovementComponent();
+
+	void SetLaunchState(const FVector& InLaunchLocation, const FVector& InLaunchVelocity, double InLaunchServerTime);
+	bool HasLaunchState() const { return bHasLaunchState; }
+	double GetLaunchServerTime() const { return LaunchServerTime; }
+
+	/*Location and velocity TimeSinceLaunch seconds into the flight, integrated the way UProjectileMovementComponent does*/
+	void PredictState(float TimeSinceLaunch, FVector& OutLocation, FVector& OutVelocity) const;
+
+private:
+	FVector LaunchLocation = FVector::ZeroVector;
+	FVector LaunchVelocity = FVector::ZeroVector;
+	double LaunchServerTime = 0.0;
+	bool bHasLaunchState = false;
 	
 protected:
 	virtual EHandleBlockingHitResult HandleBlockingHit(const FHitResult& Hit, float TimeTick, const FVector& MoveDelta, float& SubTickTimeRemaining) override;
@@ -0,0 +1,252 @@
+#!/usr/bin/env python3
+# @2023 All rights reversed by Reverse-Alpha Studios
+"""Local multi-client network harness for aircraft replication.
+
+Launches one headless dedicated server with bot pilots and several headless clients on localhost, each
+client behind the engine's packet emulation (-PktLag, -PktLoss, -PktLagVariance). Every process is
+started with -AircraftNetStats=<prefix> so UAircraftNetStatsSubsystem writes positions, corrections
+and per-connection bandwidth. When the run ends the CSVs are reduced to a JSON report:
+
+  per client      bandwidth in/out (mean, p95), corrections per second, snap distance p50/p95,
+                  position error against the server view (p50/p95/p99/max), jitter of simulated aircraft
+  server          out bandwidth and open actor channels per connection, keyed client0..N-1 in join order
+
+Pass --baseline <report.json> to compare against an earlier run; metrics that got worse by more than
+--tolerance (default 10%) are listed and the exit code is 2.
+
+Example:
+  aircraft_net_harness.py --engine UnrealEditor --project Game.uproject --map /Game/Maps/Arena \\
+      --clients 4 --bots 16 --bot-class /Game/Aircraft/BP_Fighter.BP_Fighter_C --duration 120 --lag 80 --loss 2 --jitter 20 --out Saved/NetHarness/run1
+"""
+
+import argparse
+import bisect
+import csv
+import json
+import math
+import os
+import statistics
+import subprocess
+import sys
+import time
+from collections import defaultdict
+
+
+def launch(args, role, index=None):
+    prefix = os.path.join(args.out, role if index is None else "%s_%d" % (role, index))
+    common = ["-nullrhi", "-nosound", "-unattended", "-log", "-AircraftNetStats=%s" % os.path.abspath(prefix)]
+
+    if role == "server":
+        command = [args.engine, args.project, "%s?Port=%d" % (args.map, args.port), "-server",
+                   "-AircraftNetBots=%d" % args.bots, "-AircraftBotClass=%s" % args.bot_class] + common
+    else:
+        command = [args.engine, args.project, "127.0.0.1:%d" % args.port, "-game",
+                   "-PktLag=%d" % args.lag, "-PktLoss=%d" % args.loss, "-PktLagVariance=%d" % args.jitter] + common
+
+    log = open(prefix + ".log", "w")
+    return subprocess.Popen(command, stdout=log, stderr=subprocess.STDOUT), prefix
+
+
+def read_csv(path):
+    if not os.path.exists(path):
+        return []
+    with open(path, newline="") as handle:
+        return list(csv.DictReader(handle))
+
+
+def percentile(values, fraction):
+    if not values:
+        return 0.0
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, max(0, math.ceil(fraction * len(ordered)) - 1))]
+
+
+def summarize(values):
+    return {
+        "p50": percentile(values, 0.50),
+        "p95": percentile(values, 0.95),
+        "p99": percentile(values, 0.99),
+        "max": max(values) if values else 0.0,
+    }
+
+
+def load_tracks(prefix, role_filter=None):
+    tracks = defaultdict(list)
+    for row in read_csv(prefix + "_positions.csv"):
+        if role_filter and row["role"] != role_filter:
+            continue
+        tracks[row["aircraft"]].append((float(row["time"]), float(row["x"]), float(row["y"]), float(row["z"])))
+    for samples in tracks.values():
+        samples.sort()
+    return tracks
+
+
+def sample_track(samples, times, when):
+    """Linearly interpolates a server track at a client timestamp."""
+    index = bisect.bisect_left(times, when)
+    if index <= 0 or index >= len(samples):
+        return None
+    t0, *p0 = samples[index - 1]
+    t1, *p1 = samples[index]
+    alpha = (when - t0) / (t1 - t0) if t1 > t0 else 0.0
+    return [a + (b - a) * alpha for a, b in zip(p0, p1)]
+
+
+def position_errors(server_tracks, client_tracks):
+    errors = []
+    for aircraft, client_samples in client_tracks.items():
+        server_samples = server_tracks.get(aircraft)
+        if not server_samples:
+            continue
+        server_times = [sample[0] for sample in server_samples]
+        for when, *position in client_samples:
+            expected = sample_track(server_samples, server_times, when)
+            if expected is not None:
+                errors.append(math.dist(position, expected))
+    return errors
+
+
+def jitter(client_tracks):
+    """Deviation of each step from the average of its neighbours; zero for perfectly smooth motion."""
+    deviations = []
+    for samples in client_tracks.values():
+        for previous, current, following in zip(samples, samples[1:], samples[2:]):
+            midpoint = [(a + b) / 2 for a, b in zip(previous[1:], following[1:])]
+            deviations.append(math.dist(current[1:], midpoint))
+    return deviations
+
+
+def build_report(args, server_prefix, client_prefixes):
+    server_tracks = load_tracks(server_prefix, "authority")
+    report = {
+        "settings": {key: getattr(args, key) for key in ("clients", "bots", "duration", "lag", "loss", "jitter")},
+        "server": {},
+        "clients": {},
+    }
+
+    server_out = defaultdict(list)
+    server_channels = defaultdict(list)
+    for row in read_csv(server_prefix + "_connections.csv"):
+        server_out[row["connection"]].append(float(row["out_bytes_per_second"]))
+        server_channels[row["connection"]].append(float(row.get("open_channels") or 0))
+    report["server"]["out_bytes_per_second"] = {connection: statistics.fmean(values) for connection, values in server_out.items()}
+    report["server"]["open_channels"] = {connection: statistics.fmean(values) for connection, values in server_channels.items()}
+
+    for prefix in client_prefixes:
+        name = os.path.basename(prefix)
+        connections = read_csv(prefix + "_connections.csv")
+        corrections = read_csv(prefix + "_corrections.csv")
+        client_tracks = load_tracks(prefix, "simulated")
+
+        in_rates = [float(row["in_bytes_per_second"]) for row in connections]
+        out_rates = [float(row["out_bytes_per_second"]) for row in connections]
+        snaps = [float(row["snap_distance"]) for row in corrections]
+        times = [float(row["time"]) for row in corrections]
+        span = (max(times) - min(times)) if len(times) > 1 else args.duration
+
+        report["clients"][name] = {
+            "in_bytes_per_second_mean": statistics.fmean(in_rates) if in_rates else 0.0,
+            "in_bytes_per_second_p95": percentile(in_rates, 0.95),
+            "out_bytes_per_second_mean": statistics.fmean(out_rates) if out_rates else 0.0,
+            "corrections_per_second": len(corrections) / span if span > 0 else 0.0,
+            "snap_distance": summarize(snaps),
+            "position_error": summarize(position_errors(server_tracks, client_tracks)),
+            "jitter": summarize(jitter(client_tracks)),
+        }
+    return report
+
+
+def flatten(node, path=""):
+    if isinstance(node, dict):
+        for key, value in node.items():
+            yield from flatten(value, "%s.%s" % (path, key) if path else key)
+    elif isinstance(node, (int, float)):
+        yield path, float(node)
+
+
+def compare(report, baseline, tolerance):
+    """Every tracked metric is a cost, so an increase beyond the tolerance is a regression."""
+    current = dict(flatten({"server": report["server"], "clients": report["clients"]}))
+    previous = dict(flatten({"server": baseline.get("server", {}), "clients": baseline.get("clients", {})}))
+    regressions = []
+    for key, value in sorted(current.items()):
+        old = previous.get(key)
+        if old is None or old == 0.0:
+            continue
+        change = (value - old) / abs(old)
+        if change > tolerance:
+            regressions.append((key, old, value, change))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--engine", required=True, help="path to UnrealEditor / game executable")
+    parser.add_argument("--project", default="", help=".uproject path when running through the editor executable")
+    parser.add_argument("--map", required=True)
+    parser.add_argument("--port", type=int, default=7777)
+    parser.add_argument("--clients", type=int, default=4)
+    parser.add_argument("--bots", type=int, default=16)
+    parser.add_argument("--bot-class", help="Blueprint aircraft class the bots fly, e.g. /Game/Aircraft/BP_Fighter.BP_Fighter_C")
+    parser.add_argument("--duration", type=float, default=120.0, help="seconds to record once all clients are up")
+    parser.add_argument("--startup", type=float, default=20.0, help="seconds to wait for the server to load the map")
+    parser.add_argument("--client-spacing", type=float, default=2.0, help="seconds between client launches")
+    parser.add_argument("--lag", type=int, default=0, help="emulated one-way packet lag in ms (-PktLag)")
+    parser.add_argument("--loss", type=int, default=0, help="emulated packet loss percentage (-PktLoss)")
+    parser.add_argument("--jitter", type=int, default=0, help="emulated lag variance in ms (-PktLagVariance)")
+    parser.add_argument("--out", required=True, help="output directory")
+    parser.add_argument("--report-only", action="store_true", help="rebuild the report from an existing output directory")
+    parser.add_argument("--baseline", help="earlier report.json to compare against")
+    parser.add_argument("--tolerance", type=float, default=0.10)
+    args = parser.parse_args()
+    if not args.report_only and args.bots > 0 and not args.bot_class:
+        parser.error("--bot-class is required to launch bots")
+
+    os.makedirs(args.out, exist_ok=True)
+    server_prefix = os.path.join(args.out, "server")
+    client_prefixes = [os.path.join(args.out, "client_%d" % index) for index in range(args.clients)]
+
+    if not args.report_only:
+        processes = []
+        try:
+            server, _ = launch(args, "server")
+            processes.append(server)
+            time.sleep(args.startup)
+            for index in range(args.clients):
+                client, _ = launch(args, "client", index)
+                processes.append(client)
+                # Spaced out so the server's join order, which keys its connection metrics, follows client_N.
+                time.sleep(args.client_spacing)
+            time.sleep(args.duration)
+        finally:
+            for process in processes:
+                process.terminate()
+            for process in processes:
+                try:
+                    process.wait(timeout=30)
+                except subprocess.TimeoutExpired:
+                    process.kill()
+
+    report = build_report(args, server_prefix, client_prefixes)
+    report_path = os.path.join(args.out, "report.json")
+    with open(report_path, "w") as handle:
+        json.dump(report, handle, indent=2, sort_keys=True)
+    print("report written to %s" % report_path)
+
+    for name, client in sorted(report["clients"].items()):
+        print("%-10s in %8.0f B/s  corrections %6.2f/s  error p95 %8.1f  jitter p95 %8.1f"
+              % (name, client["in_bytes_per_second_mean"], client["corrections_per_second"],
+                 client["position_error"]["p95"], client["jitter"]["p95"]))
+
+    if args.baseline:
+        with open(args.baseline) as handle:
+            regressions = compare(report, json.load(handle), args.tolerance)
+        for key, old, new, change in regressions:
+            print("REGRESSION %-60s %12.2f -> %12.2f (%+.0f%%)" % (key, old, new, change * 100.0))
+        if regressions:
+            return 2
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
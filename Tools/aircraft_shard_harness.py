@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+# @2023 All rights reversed by Reverse-Alpha Studios
+"""Local harness for the experimental sharded airspace.
+
+Launches one headless dedicated server per shard on localhost. Each is started with
+-AircraftShard=<i> -AircraftShardCount=<N>, so UAircraftShardSubsystem splits the map into N slabs along X
+and the shards hand aircraft over and exchange border ghosts over UDP loopback. Every shard spawns
+--bots bot-piloted aircraft of --bot-class inside its own slab and writes -AircraftShardStats=<prefix> CSVs. When the run
+ends they are reduced to a JSON report:
+
+  per shard       handoffs out / in / returned, resend attempts, one-way handoff latency (p50/p95/p99/max),
+                  acknowledgement round trip p95, actor tick time (mean/p50/p95/p99/max), aircraft and ghosts
+  overall         handoff latency over all shards and the slowest shard's p99 tick
+
+Example:
+  aircraft_shard_harness.py --engine UnrealEditor --project Game.uproject --map /Game/Maps/Arena \\
+      --shards 4 --bots 24 --bot-class /Game/Aircraft/BP_Fighter.BP_Fighter_C --width 200000 --duration 120 --out Saved/ShardHarness/run1
+"""
+
+import argparse
+import json
+import os
+import statistics
+import subprocess
+import sys
+import time
+
+from aircraft_net_harness import percentile, read_csv, summarize
+
+
+def launch(args, index):
+    prefix = os.path.join(args.out, "shard_%d" % index)
+    command = [args.engine, args.project, "%s?Port=%d" % (args.map, args.game_port + index), "-server", "-game",
+               "-nullrhi", "-nosound", "-unattended", "-log",
+               "-AircraftShard=%d" % index,
+               "-AircraftShardCount=%d" % args.shards,
+               "-AircraftShardWidth=%d" % args.width,
+               "-AircraftShardPort=%d" % args.shard_port,
+               "-AircraftShardBots=%d" % args.bots,
+               "-AircraftShardStats=%s" % os.path.abspath(prefix)]
+    if args.bot_class:
+        command.append("-AircraftBotClass=%s" % args.bot_class)
+
+    log = open(prefix + ".log", "w")
+    return subprocess.Popen(command, stdout=log, stderr=subprocess.STDOUT), prefix
+
+
+def shard_report(prefix, warmup):
+    handoffs = read_csv(prefix + "_handoffs.csv")
+    ticks = read_csv(prefix + "_ticks.csv")
+
+    start = min((float(row["time"]) for row in ticks), default=0.0) + warmup
+    ticks = [row for row in ticks if float(row["time"]) >= start]
+
+    incoming = [float(row["latency_ms"]) for row in handoffs if row["direction"] == "in"]
+    acked = [row for row in handoffs if row["direction"] == "acked"]
+    returned = [row for row in handoffs if row["direction"] == "returned"]
+    tick_ms = [float(row["actor_tick_ms"]) for row in ticks]
+
+    return {
+        "handoffs_out": len(acked) + len(returned),
+        "handoffs_in": len(incoming),
+        "handoffs_returned": len(returned),
+        "attempts_mean": statistics.fmean(int(row["attempts"]) for row in acked) if acked else 0.0,
+        "handoff_bytes_mean": statistics.fmean(int(row["bytes"]) for row in acked) if acked else 0.0,
+        "handoff_latency_ms": summarize(incoming),
+        "ack_round_trip_ms_p95": percentile([float(row["latency_ms"]) for row in acked], 0.95),
+        "tick_ms": dict(summarize(tick_ms), mean=statistics.fmean(tick_ms) if tick_ms else 0.0),
+        "aircraft_mean": statistics.fmean(int(row["aircraft"]) for row in ticks) if ticks else 0.0,
+        "ghosts_mean": statistics.fmean(int(row["ghosts"]) for row in ticks) if ticks else 0.0,
+    }, incoming
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--engine", required=True, help="path to UnrealEditor / server executable")
+    parser.add_argument("--project", default="", help=".uproject path when running through the editor executable")
+    parser.add_argument("--map", required=True)
+    parser.add_argument("--shards", type=int, default=3)
+    parser.add_argument("--bots", type=int, default=16, help="bot aircraft spawned per shard")
+    parser.add_argument("--bot-class", help="Blueprint aircraft class the bots fly, e.g. /Game/Aircraft/BP_Fighter.BP_Fighter_C")
+    parser.add_argument("--width", type=int, default=200000, help="slab width per shard in cm")
+    parser.add_argument("--game-port", type=int, default=7777, help="first game port; shard i listens on +i")
+    parser.add_argument("--shard-port", type=int, default=7900, help="first loopback port for shard traffic")
+    parser.add_argument("--duration", type=float, default=120.0, help="seconds to run once all shards are started")
+    parser.add_argument("--warmup", type=float, default=20.0, help="seconds of tick samples to drop while maps load")
+    parser.add_argument("--out", required=True, help="output directory")
+    parser.add_argument("--report-only", action="store_true", help="rebuild the report from an existing output directory")
+    args = parser.parse_args()
+    if not args.report_only and args.bots > 0 and not args.bot_class:
+        parser.error("--bot-class is required to launch bots")
+
+    os.makedirs(args.out, exist_ok=True)
+    prefixes = [os.path.join(args.out, "shard_%d" % index) for index in range(args.shards)]
+
+    if not args.report_only:
+        processes = []
+        try:
+            for index in range(args.shards):
+                process, _ = launch(args, index)
+                processes.append(process)
+            time.sleep(args.duration)
+        finally:
+            for process in processes:
+                process.terminate()
+            for process in processes:
+                try:
+                    process.wait(timeout=30)
+                except subprocess.TimeoutExpired:
+                    process.kill()
+
+    report = {
+        "settings": {key: getattr(args, key) for key in ("shards", "bots", "width", "duration")},
+        "shards": {},
+    }
+    all_latencies = []
+    for prefix in prefixes:
+        shard, latencies = shard_report(prefix, args.warmup)
+        report["shards"][os.path.basename(prefix)] = shard
+        all_latencies.extend(latencies)
+
+    report["overall"] = {
+        "handoff_latency_ms": summarize(all_latencies),
+        "worst_shard_tick_ms_p99": max((shard["tick_ms"]["p99"] for shard in report["shards"].values()), default=0.0),
+    }
+
+    report_path = os.path.join(args.out, "report.json")
+    with open(report_path, "w") as handle:
+        json.dump(report, handle, indent=2, sort_keys=True)
+    print("report written to %s" % report_path)
+
+    for name, shard in sorted(report["shards"].items()):
+        print("%-8s out %5d  in %5d  returned %3d  latency p95 %7.2f ms  tick mean %6.2f p99 %6.2f ms  aircraft %5.1f  ghosts %5.1f"
+              % (name, shard["handoffs_out"], shard["handoffs_in"], shard["handoffs_returned"],
+                 shard["handoff_latency_ms"]["p95"], shard["tick_ms"]["mean"], shard["tick_ms"]["p99"],
+                 shard["aircraft_mean"], shard["ghosts_mean"]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+# @2023 All rights reversed by Reverse-Alpha Studios
+"""Tails the memory-mapped ring written by Aircraft.Telemetry.Start.
+
+Layout (little endian), mirrored from Aircraft/AircraftTelemetry.h:
+  header  64 bytes: magic u32, version u32, record_size u32, capacity u32, write_index u64, padding
+  records 64 bytes: sequence u64, world_time f32, aircraft_id u32,
+                    current_speed, thrust_speed, boost_speed, applied_gravity,
+                    pitch, yaw, roll, input_throttle, x, y, z (f32), flags u32
+
+A slot is valid when its sequence equals its write index + 1. The writer does not invalidate a slot
+before overwriting it, so after copying a record the reader checks again that the sequence is unchanged
+and that no write a full ring later has been claimed; otherwise the copy may be torn and is dropped.
+The reader never writes to the file, so it cannot stall the game; if it falls more than one ring behind
+it skips ahead and reports the gap.
+
+Usage:
+  aircraft_telemetry_tail.py Saved/Profiling/AircraftTelemetry.bin [--csv out.csv] [--aircraft ID]
+"""
+
+import argparse
+import mmap
+import struct
+import sys
+import time
+
+HEADER = struct.Struct("<IIIIQ40x")
+RECORD = struct.Struct("<QfI11fI")
+MAGIC = 0x4C544341
+VERSION = 1
+
+FIELDS = (
+    "world_time", "aircraft_id",
+    "current_speed", "thrust_speed", "boost_speed", "applied_gravity",
+    "pitch", "yaw", "roll", "input_throttle",
+    "x", "y", "z", "flags",
+)
+
+FLAG_NAMES = ("engine", "takenoff", "boost", "destroyed", "authority")
+
+
+def read_header(view):
+    magic, version, record_size, capacity, write_index = HEADER.unpack_from(view, 0)
+    if magic != MAGIC or version != VERSION or record_size != RECORD.size:
+        raise SystemExit("not an aircraft telemetry file (magic %08x version %d record %d)" % (magic, version, record_size))
+    return capacity, write_index
+
+
+def format_flags(flags):
+    return "|".join(name for bit, name in enumerate(FLAG_NAMES) if flags & (1 << bit)) or "-"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("path")
+    parser.add_argument("--csv", help="append records to this CSV file instead of printing them")
+    parser.add_argument("--aircraft", type=int, help="only show records of this aircraft id")
+    parser.add_argument("--from-start", action="store_true", help="replay what is still in the ring before tailing")
+    parser.add_argument("--interval", type=float, default=0.05, help="poll interval in seconds")
+    args = parser.parse_args()
+
+    with open(args.path, "rb") as handle:
+        view = mmap.mmap(handle.fileno(), 0, access=mmap.ACCESS_READ)
+        capacity, write_index = read_header(view)
+        next_index = max(0, write_index - capacity) if args.from_start else write_index
+
+        out = open(args.csv, "a", newline="") if args.csv else None
+        if out and out.tell() == 0:
+            out.write(",".join(FIELDS) + "\n")
+
+        try:
+            while True:
+                _, _, _, _, write_index = HEADER.unpack_from(view, 0)
+                if write_index - next_index > capacity:
+                    print("# dropped %d records, reader fell behind" % (write_index - capacity - next_index), file=sys.stderr)
+                    next_index = write_index - capacity
+
+                while next_index < write_index:
+                    offset = HEADER.size + (next_index % capacity) * RECORD.size
+                    values = RECORD.unpack_from(view, offset)
+                    if values[0] != next_index + 1:
+                        # Claimed but not yet published by the writer; pick it up on the next poll.
+                        break
+
+                    # Index next_index + capacity reuses this slot; once it is claimed the copy may be torn.
+                    # Leave next_index where it is so the fell-behind check above skips past it.
+                    (sequence,) = struct.unpack_from("<Q", view, offset)
+                    _, _, _, _, write_index = HEADER.unpack_from(view, 0)
+                    if sequence != values[0] or write_index - next_index > capacity:
+                        break
+
+                    record = values[1:]
+                    next_index += 1
+                    if args.aircraft is not None and record[1] != args.aircraft:
+                        continue
+
+                    if out:
+                        out.write(",".join(str(value) for value in record) + "\n")
+                    else:
+                        print("%9.3f id=%-8d speed=%7.1f thrust=%7.1f boost=%6.1f grav=%7.1f "
+                              "pyr=(%5.2f %5.2f %5.2f) thr=%5.2f pos=(%.0f %.0f %.0f) %s"
+                              % (record[:13] + (format_flags(record[13]),)))
+
+                if out:
+                    out.flush()
+                time.sleep(args.interval)
+        except KeyboardInterrupt:
+            pass
+        finally:
+            if out:
+                out.close()
+            view.close()
+
+
+if __name__ == "__main__":
+    main()